@@ -9,9 +9,13 @@
 #include "catch2/benchmark/catch_benchmark.hpp"
 #include "catch2/benchmark/catch_chronometer.hpp"
 #include "catch2/catch_test_macros.hpp"
+#include "ds/string.hpp"
 #include "ds/types.hpp"
+#include <algorithm>
 #include <array>
 #include <map>
+#include <string>
+#include <vector>
 
 template <typename T, ds::usize N> void benchmark() {
   std::array<ds::i32, N> random{};
@@ -147,3 +151,319 @@ TEST_CASE("bptree_map benchmarks", "[!benchmark][bptree_map]") {
     benchmark<ds::i64, 10'000>();
   }
 }
+
+// === Node Search === //
+
+const ds::usize SEARCH_KEYS = 200'000U;
+
+template <typename T> void benchmark_search(const char* name) {
+  std::vector<T> keys{};
+  for (ds::usize i = 0U; i < SEARCH_KEYS; ++i) {
+    keys.push_back((T)std::rand()); // NOLINT
+  }
+
+  BENCHMARK(std::string{"insert "} + name) {
+    ds::bptree_map<T, T> map{};
+    ds::error_code error_code{};
+    for (auto key : keys) {
+      error_code = map.insert(key, key);
+    }
+    return map.get_size();
+  };
+
+  ds::bptree_map<T, T> map{};
+  ds::error_code error_code{};
+  for (auto key : keys) {
+    error_code = map.insert(key, key);
+  }
+
+  BENCHMARK(std::string{"point lookup "} + name) {
+    ds::usize found = 0U;
+    for (auto key : keys) {
+      found += map[key] != nullptr;
+    }
+    return found;
+  };
+
+  BENCHMARK(std::string{"missing lookup "} + name) {
+    ds::usize found = 0U;
+    for (auto key : keys) {
+      found += map.contains(key + 1);
+    }
+    return found;
+  };
+}
+
+TEST_CASE("bptree_map node search benchmarks", "[!benchmark][bptree_map]") {
+  benchmark_search<ds::i32>("i32");
+  benchmark_search<ds::i64>("i64");
+  benchmark_search<ds::u64>("u64");
+}
+
+// === Node Size === //
+
+template <typename T, ds::usize NodeSize>
+void benchmark_node_size(const std::vector<T>& keys) {
+  using map_type = ds::bptree_map<T, T, ds::compare<T>, NodeSize>;
+  std::string name = std::to_string(NodeSize) + "B nodes ; " +
+                     std::to_string(keys.size()) + " keys";
+
+  BENCHMARK("insert " + name) {
+    map_type map{};
+    ds::error_code error_code{};
+    for (auto key : keys) {
+      error_code = map.insert(key, key);
+    }
+    return map.get_size();
+  };
+
+  map_type map{};
+  ds::error_code error_code{};
+  for (auto key : keys) {
+    error_code = map.insert(key, key);
+  }
+
+  BENCHMARK("lookup " + name) {
+    ds::usize found = 0U;
+    for (auto key : keys) {
+      found += map[key] != nullptr;
+    }
+    return found;
+  };
+
+  BENCHMARK("iterate " + name) {
+    T sum = 0;
+    for (auto it = map.cbegin(); it != map.cend(); ++it) {
+      sum += it.value();
+    }
+    return sum;
+  };
+}
+
+template <typename T> void benchmark_node_sizes(ds::usize size) {
+  std::vector<T> keys{};
+  for (ds::usize i = 0U; i < size; ++i) {
+    keys.push_back((T)std::rand()); // NOLINT
+  }
+
+  benchmark_node_size<T, ds::BPTREE_NODE_SIZE>(keys);
+  benchmark_node_size<T, 256U>(keys);
+  benchmark_node_size<T, 1'024U>(keys);
+  benchmark_node_size<T, 4'096U>(keys);
+}
+
+TEST_CASE("bptree_map node size benchmarks", "[!benchmark][bptree_map]") {
+  SECTION("i32 ; 10,000") {
+    benchmark_node_sizes<ds::i32>(10'000U);
+  }
+
+  SECTION("i32 ; 100,000") {
+    benchmark_node_sizes<ds::i32>(100'000U);
+  }
+
+  SECTION("i32 ; 1,000,000") {
+    benchmark_node_sizes<ds::i32>(1'000'000U);
+  }
+
+  SECTION("i64 ; 1,000,000") {
+    benchmark_node_sizes<ds::i64>(1'000'000U);
+  }
+}
+
+// === Bulk Load === //
+
+template <typename T> void benchmark_bulk_load(ds::usize size) {
+  std::vector<T> keys{};
+  keys.reserve(size);
+  for (ds::usize i = 0U; i < size; ++i) {
+    keys.push_back((T)(i * 2U));
+  }
+
+  BENCHMARK("repeated insert") {
+    ds::bptree_map<T, T> map{};
+    ds::error_code error_code{};
+    for (auto key : keys) {
+      error_code = map.insert(key, key);
+    }
+    return map.get_size();
+  };
+
+  BENCHMARK("build_from_sorted") {
+    ds::bptree_map<T, T> map{};
+    ds::error_code error_code =
+        map.build_from_sorted(keys.data(), keys.data(), size);
+    return map.get_size();
+  };
+
+  BENCHMARK("build_from_sorted ; full nodes") {
+    ds::bptree_map<T, T> map{};
+    ds::error_code error_code =
+        map.build_from_sorted(keys.data(), keys.data(), size, 1.0F);
+    return map.get_size();
+  };
+}
+
+TEST_CASE("bptree_map bulk load benchmarks", "[!benchmark][bptree_map]") {
+  SECTION("i32 ; 1,000,000") {
+    benchmark_bulk_load<ds::i32>(1'000'000U);
+  }
+
+  SECTION("i32 ; 10,000,000") {
+    benchmark_bulk_load<ds::i32>(10'000'000U);
+  }
+
+  SECTION("i32 ; 100,000,000") {
+    benchmark_bulk_load<ds::i32>(100'000'000U);
+  }
+}
+
+// === String Keys === //
+
+void benchmark_string_keys(ds::usize size) {
+  // Paths that share long prefixes, like the keys of a file index
+  std::vector<std::string> paths{};
+  paths.reserve(size);
+  for (ds::usize i = 0U; i < size; ++i) {
+    paths.push_back(
+        "/srv/storage/volumes/primary/users/" + std::to_string(i % 97U) +
+        "/documents/" + std::to_string(std::rand()) // NOLINT
+    );
+  }
+
+  std::vector<std::string> sorted{paths};
+  std::sort(sorted.begin(), sorted.end());
+  sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+  std::vector<const ds::c8*> keys{};
+  std::vector<ds::i32> values{};
+  for (const auto& path : sorted) {
+    keys.push_back(path.c_str());
+    values.push_back((ds::i32)values.size());
+  }
+
+  BENCHMARK("insert ds::bptree_map") {
+    ds::bptree_map<ds::string, ds::i32> map{};
+    ds::error_code error_code{};
+    for (ds::usize i = 0U; i < size; ++i) {
+      error_code = map.insert(paths[i].c_str(), (ds::i32)i);
+    }
+    return map.get_size();
+  };
+
+  BENCHMARK("insert std::map") {
+    std::map<std::string, ds::i32> map{};
+    for (ds::usize i = 0U; i < size; ++i) {
+      map[paths[i]] = (ds::i32)i;
+    }
+    return map.size();
+  };
+
+  BENCHMARK("build_from_sorted ds::bptree_map") {
+    ds::bptree_map<ds::string, ds::i32> map{};
+    ds::error_code error_code =
+        map.build_from_sorted(keys.data(), values.data(), keys.size());
+    return map.get_size();
+  };
+
+  ds::bptree_map<ds::string, ds::i32> bptree{};
+  ds::error_code error_code =
+      bptree.build_from_sorted(keys.data(), values.data(), keys.size());
+  std::map<std::string, ds::i32> map{};
+  for (ds::usize i = 0U; i < sorted.size(); ++i) {
+    map[sorted[i]] = (ds::i32)i;
+  }
+
+  BENCHMARK("lookup ds::bptree_map") {
+    ds::i32 sum = 0;
+    for (const auto& path : paths) {
+      sum += *bptree[path.c_str()];
+    }
+    return sum;
+  };
+
+  BENCHMARK("lookup std::map") {
+    ds::i32 sum = 0;
+    for (const auto& path : paths) {
+      sum += map.find(path)->second;
+    }
+    return sum;
+  };
+}
+
+TEST_CASE("bptree_map string key benchmarks", "[!benchmark][bptree_map]") {
+  SECTION("100,000") {
+    benchmark_string_keys(100'000U);
+  }
+
+  SECTION("1,000,000") {
+    benchmark_string_keys(1'000'000U);
+  }
+}
+
+// === Node Pool === //
+
+template <typename T> void benchmark_node_churn(ds::usize size) {
+  std::vector<T> keys{};
+  keys.reserve(size);
+  for (ds::usize i = 0U; i < size; ++i) {
+    keys.push_back((T)std::rand()); // NOLINT
+  }
+
+  BENCHMARK("insert/remove churn ds::bptree_map") {
+    ds::bptree_map<T, T> map{};
+    ds::error_code error_code{};
+    for (ds::usize round = 0U; round < 4U; ++round) {
+      for (auto key : keys) {
+        error_code = map.insert(key, key);
+      }
+      for (auto key : keys) {
+        map.remove(key);
+      }
+    }
+    return map.get_size();
+  };
+
+  BENCHMARK("insert/remove churn std::map") {
+    std::map<T, T> map{};
+    for (ds::usize round = 0U; round < 4U; ++round) {
+      for (auto key : keys) {
+        map[key] = key;
+      }
+      for (auto key : keys) {
+        map.erase(key);
+      }
+    }
+    return map.size();
+  };
+
+  BENCHMARK_ADVANCED("destroy ds::bptree_map")
+  (Catch::Benchmark::Chronometer meter) {
+    std::vector<ds::bptree_map<T, T>> maps(meter.runs());
+    for (auto& map : maps) {
+      for (auto key : keys) {
+        static_cast<void>(map.insert(key, key));
+      }
+    }
+    meter.measure([&](ds::i32 i) { maps[i].destroy(); });
+  };
+
+  BENCHMARK_ADVANCED("destroy std::map")
+  (Catch::Benchmark::Chronometer meter) {
+    std::vector<std::map<T, T>> maps(meter.runs());
+    for (auto& map : maps) {
+      for (auto key : keys) {
+        map[key] = key;
+      }
+    }
+    meter.measure([&](ds::i32 i) { maps[i].clear(); });
+  };
+}
+
+TEST_CASE("bptree_map node pool benchmarks", "[!benchmark][bptree_map]") {
+  SECTION("i32 ; 100,000") {
+    benchmark_node_churn<ds::i32>(100'000U);
+  }
+
+  SECTION("i32 ; 1,000,000") {
+    benchmark_node_churn<ds::i32>(1'000'000U);
+  }
+}
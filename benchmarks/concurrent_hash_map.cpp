@@ -0,0 +1,100 @@
+/*===============================*
+ * Author/s:
+ *  - silentrald
+ * Version: 1.0
+ * Created: 2024-10-17
+ *===============================*/
+
+#include "ds-thread/concurrent_hash_map.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/benchmark/catch_chronometer.hpp"
+#include "catch2/catch_test_macros.hpp"
+#include "ds/types.hpp"
+#include <string>
+#include <thread>
+#include <vector>
+
+const ds::usize CONCURRENT_KEYS = 100'000U;
+const ds::usize CONCURRENT_OPERATIONS = 400'000U;
+const ds::usize CONCURRENT_THREADS[] = {1U, 2U, 4U, 8U, 16U, 32U}; // NOLINT
+
+// NOTE: A single shard behaves like a hash_map behind one external lock
+using sharded_map = ds::concurrent_hash_map<ds::u64, ds::u64>;
+using locked_map = ds::concurrent_hash_map<
+    ds::u64, ds::u64, ds::hash<ds::u64>, ds::equal<ds::u64>,
+    ds::prime_hash_policy, 1U>;
+
+/**
+ * Runs `operations` spread over `threads` threads, every 10th operation (or
+ *   every 2nd when write heavy) is a write and the rest are finds
+ **/
+template <typename Map>
+ds::usize run_operations(Map& map, ds::usize threads, bool write_heavy) {
+  std::vector<std::thread> workers{};
+  std::vector<ds::usize> found(threads, 0U);
+  ds::usize per_thread = CONCURRENT_OPERATIONS / threads;
+  ds::usize write_every = write_heavy ? 2U : 10U;
+
+  for (ds::usize t = 0U; t < threads; ++t) {
+    workers.emplace_back([&map, &found, t, per_thread, write_every]() {
+      // Cheap xorshift so every thread walks different keys
+      ds::u64 state = (t + 1U) * 0x9E3779B97F4A7C15ULL;
+      ds::error_code error_code{};
+      ds::usize hits = 0U;
+      for (ds::usize i = 0U; i < per_thread; ++i) {
+        state ^= state << 13U;
+        state ^= state >> 7U;
+        state ^= state << 17U;
+        ds::u64 key = state % (CONCURRENT_KEYS * 2U);
+
+        if (i % write_every != 0U) {
+          error_code = map.find(key, [&hits](const ds::u64&) { ++hits; });
+        } else if ((i / write_every) % 2U == 0U) {
+          error_code = map.insert(key, key);
+        } else {
+          error_code = map.remove(key);
+        }
+      }
+      found[t] = hits;
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  ds::usize total = 0U;
+  for (auto count : found) {
+    total += count;
+  }
+  return total;
+}
+
+template <typename Map>
+void benchmark_concurrent_map(const std::string& name, bool write_heavy) {
+  Map map{};
+  ds::error_code error_code{};
+  for (ds::u64 key = 0U; key < CONCURRENT_KEYS * 2U; key += 2U) {
+    error_code = map.insert(key, key);
+  }
+
+  for (auto threads : CONCURRENT_THREADS) {
+    BENCHMARK_ADVANCED(
+        name + (write_heavy ? " write heavy " : " read heavy ") +
+        std::to_string(threads) + " threads"
+    )
+    (Catch::Benchmark::Chronometer meter) {
+      meter.measure([&map, threads, write_heavy]() {
+        return run_operations(map, threads, write_heavy);
+      });
+    };
+  }
+}
+
+TEST_CASE(
+    "concurrent_hash_map benchmarks", "[!benchmark][concurrent_hash_map]"
+) {
+  benchmark_concurrent_map<sharded_map>("16 shards", false);
+  benchmark_concurrent_map<locked_map>("1 shard", false);
+  benchmark_concurrent_map<sharded_map>("16 shards", true);
+  benchmark_concurrent_map<locked_map>("1 shard", true);
+}
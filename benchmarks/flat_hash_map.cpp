@@ -0,0 +1,242 @@
+/*===============================*
+ * Author/s:
+ *  - silentrald
+ * Version: 1.0
+ * Created: 2024-10-16
+ *===============================*/
+
+#include "ds/flat_hash_map.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/benchmark/catch_chronometer.hpp"
+#include "catch2/catch_test_macros.hpp"
+#include "ds/hash_map.hpp"
+#include "ds/string.hpp"
+#include "ds/types.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+const ds::usize FLAT_KEYS = 200'000U;
+
+// === Integer Keys === //
+
+template <typename Map>
+void benchmark_u64_map(
+    const std::vector<ds::u64>& keys, const std::string& name
+) {
+  BENCHMARK_ADVANCED("insert " + name)
+  (Catch::Benchmark::Chronometer meter) {
+    meter.measure([&keys]() {
+      Map map{};
+      ds::error_code error_code{};
+      for (auto key : keys) {
+        error_code = map.insert(key, key);
+      }
+      return map.get_size();
+    });
+  };
+
+  Map map{};
+  ds::error_code error_code{};
+  for (auto key : keys) {
+    error_code = map.insert(key, key);
+  }
+
+  BENCHMARK_ADVANCED("contains " + name)
+  (Catch::Benchmark::Chronometer meter) {
+    meter.measure([&map, &keys]() {
+      ds::usize found = 0U;
+      for (auto key : keys) {
+        found += map.contains(key);
+      }
+      return found;
+    });
+  };
+
+  BENCHMARK_ADVANCED("contains missing " + name)
+  (Catch::Benchmark::Chronometer meter) {
+    meter.measure([&map, &keys]() {
+      ds::usize found = 0U;
+      for (auto key : keys) {
+        found += map.contains(key + 1U);
+      }
+      return found;
+    });
+  };
+}
+
+void benchmark_std_u64_map(const std::vector<ds::u64>& keys) {
+  BENCHMARK_ADVANCED("insert std::unordered_map")
+  (Catch::Benchmark::Chronometer meter) {
+    meter.measure([&keys]() {
+      std::unordered_map<ds::u64, ds::u64> map{};
+      for (auto key : keys) {
+        map[key] = key;
+      }
+      return map.size();
+    });
+  };
+
+  std::unordered_map<ds::u64, ds::u64> map{};
+  for (auto key : keys) {
+    map[key] = key;
+  }
+
+  BENCHMARK_ADVANCED("contains std::unordered_map")
+  (Catch::Benchmark::Chronometer meter) {
+    meter.measure([&map, &keys]() {
+      ds::usize found = 0U;
+      for (auto key : keys) {
+        found += map.contains(key);
+      }
+      return found;
+    });
+  };
+
+  BENCHMARK_ADVANCED("contains missing std::unordered_map")
+  (Catch::Benchmark::Chronometer meter) {
+    meter.measure([&map, &keys]() {
+      ds::usize found = 0U;
+      for (auto key : keys) {
+        found += map.contains(key + 1U);
+      }
+      return found;
+    });
+  };
+}
+
+TEST_CASE("flat_hash_map<u64, u64> benchmarks", "[!benchmark][flat_hash_map]") {
+  std::vector<ds::u64> keys{};
+  keys.reserve(FLAT_KEYS);
+  for (ds::usize i = 0U; i < FLAT_KEYS; ++i) {
+    keys.push_back((ds::u64)std::rand() * 2U); // NOLINT
+  }
+
+  benchmark_u64_map<ds::flat_hash_map<ds::u64, ds::u64>>(
+      keys, "ds::flat_hash_map"
+  );
+  benchmark_u64_map<ds::hash_map<ds::u64, ds::u64>>(keys, "ds::hash_map");
+  benchmark_std_u64_map(keys);
+}
+
+// === String Keys === //
+
+// NOTE: Fixed width keys, every key has the same length
+const ds::c8* const KEY_FORMAT = "key_%012llu";
+
+template <typename Map>
+void benchmark_string_map(
+    const std::vector<std::string>& keys,
+    const std::vector<std::string>& missing, const std::string& name
+) {
+  BENCHMARK_ADVANCED("insert " + name)
+  (Catch::Benchmark::Chronometer meter) {
+    meter.measure([&keys]() {
+      Map map{};
+      ds::error_code error_code{};
+      for (ds::usize i = 0U; i < keys.size(); ++i) {
+        error_code = map.insert(keys[i].c_str(), i);
+      }
+      return map.get_size();
+    });
+  };
+
+  Map map{};
+  ds::error_code error_code{};
+  for (ds::usize i = 0U; i < keys.size(); ++i) {
+    error_code = map.insert(keys[i].c_str(), i);
+  }
+
+  BENCHMARK_ADVANCED("contains " + name)
+  (Catch::Benchmark::Chronometer meter) {
+    meter.measure([&map, &keys]() {
+      ds::usize found = 0U;
+      for (const auto& key : keys) {
+        found += map.contains(key.c_str());
+      }
+      return found;
+    });
+  };
+
+  BENCHMARK_ADVANCED("contains missing " + name)
+  (Catch::Benchmark::Chronometer meter) {
+    meter.measure([&map, &missing]() {
+      ds::usize found = 0U;
+      for (const auto& key : missing) {
+        found += map.contains(key.c_str());
+      }
+      return found;
+    });
+  };
+}
+
+void benchmark_std_string_map(
+    const std::vector<std::string>& keys,
+    const std::vector<std::string>& missing
+) {
+  BENCHMARK_ADVANCED("insert std::unordered_map")
+  (Catch::Benchmark::Chronometer meter) {
+    meter.measure([&keys]() {
+      std::unordered_map<std::string, ds::usize> map{};
+      for (ds::usize i = 0U; i < keys.size(); ++i) {
+        map[keys[i]] = i;
+      }
+      return map.size();
+    });
+  };
+
+  std::unordered_map<std::string, ds::usize> map{};
+  for (ds::usize i = 0U; i < keys.size(); ++i) {
+    map[keys[i]] = i;
+  }
+
+  BENCHMARK_ADVANCED("contains std::unordered_map")
+  (Catch::Benchmark::Chronometer meter) {
+    meter.measure([&map, &keys]() {
+      ds::usize found = 0U;
+      for (const auto& key : keys) {
+        found += map.contains(key);
+      }
+      return found;
+    });
+  };
+
+  BENCHMARK_ADVANCED("contains missing std::unordered_map")
+  (Catch::Benchmark::Chronometer meter) {
+    meter.measure([&map, &missing]() {
+      ds::usize found = 0U;
+      for (const auto& key : missing) {
+        found += map.contains(key);
+      }
+      return found;
+    });
+  };
+}
+
+TEST_CASE(
+    "flat_hash_map<string, usize> benchmarks", "[!benchmark][flat_hash_map]"
+) {
+  std::vector<std::string> keys{};
+  std::vector<std::string> missing{};
+  keys.reserve(FLAT_KEYS);
+  missing.reserve(FLAT_KEYS);
+
+  ds::c8 characters[32]; // NOLINT
+  for (ds::usize i = 0U; i < FLAT_KEYS; ++i) {
+    auto key = (ds::u64)std::rand() * 2U; // NOLINT
+    std::snprintf(characters, sizeof(characters), KEY_FORMAT, key);
+    keys.emplace_back(characters);
+    std::snprintf(characters, sizeof(characters), KEY_FORMAT, key + 1U);
+    missing.emplace_back(characters);
+  }
+
+  benchmark_string_map<ds::flat_hash_map<ds::string, ds::usize>>(
+      keys, missing, "ds::flat_hash_map"
+  );
+  benchmark_string_map<ds::hash_map<ds::string, ds::usize>>(
+      keys, missing, "ds::hash_map"
+  );
+  benchmark_std_string_map(keys, missing);
+}
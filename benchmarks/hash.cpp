@@ -0,0 +1,144 @@
+/*===============================*
+ * Author/s:
+ *  - silentrald
+ * Version: 1.0
+ * Created: 2024-10-17
+ *===============================*/
+
+#include "ds/hash.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+#include "ds/string.hpp"
+#include "ds/types.hpp"
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Bytes hashed by every benchmark run, split into keys of the same length
+const ds::usize HASHED_BYTES = 1U << 20U;
+// NOLINTNEXTLINE
+const ds::usize KEY_LENGTHS[] = {4U, 8U, 16U, 32U, 64U, 256U, 1024U, 4096U};
+
+TEST_CASE("hash throughput benchmarks", "[!benchmark][hash]") {
+  std::vector<ds::u8> buffer(HASHED_BYTES);
+  for (auto& byte : buffer) {
+    byte = (ds::u8)std::rand(); // NOLINT
+  }
+
+  for (auto length : KEY_LENGTHS) {
+    std::string suffix = " " + std::to_string(length) + " byte keys";
+
+    BENCHMARK("murmur3 x86_32" + suffix) {
+      ds::u64 sum = 0U;
+      for (ds::usize i = 0U; i + length <= HASHED_BYTES; i += length) {
+        sum += ds::murmur3_bytes(buffer.data() + i, length);
+      }
+      return sum;
+    };
+
+    BENCHMARK("wyhash" + suffix) {
+      ds::u64 sum = 0U;
+      for (ds::usize i = 0U; i + length <= HASHED_BYTES; i += length) {
+        sum += ds::wyhash_bytes(buffer.data() + i, length);
+      }
+      return sum;
+    };
+  }
+}
+
+// === Multi-Part Keys === //
+
+const ds::usize PART_KEYS = 100'000U;
+
+TEST_CASE("multi-part key hash benchmarks", "[!benchmark][hash]") {
+  // A key made of 3 scattered fields, like a tenant, a path and an object id
+  std::vector<std::string> tenants{};
+  std::vector<std::string> paths{};
+  std::vector<std::string> objects{};
+  for (ds::usize i = 0U; i < PART_KEYS; ++i) {
+    tenants.push_back("tenant-" + std::to_string(i % 97U));
+    paths.push_back("/var/data/objects/" + std::to_string(i * 7U));
+    objects.push_back(std::to_string(i * 1'000'003ULL));
+  }
+
+  BENCHMARK("concatenate into a string then murmur3") {
+    ds::u64 sum = 0U;
+    ds::error_code error_code{};
+    for (ds::usize i = 0U; i < PART_KEYS; ++i) {
+      ds::string key{};
+      error_code = key.copy(tenants[i].c_str());
+      error_code = key.append(paths[i].c_str());
+      error_code = key.append(objects[i].c_str());
+      sum += ds::murmur3_bytes(key.c_str(), key.get_size());
+    }
+    return sum + error_code;
+  };
+
+  BENCHMARK("streaming murmur3") {
+    ds::u64 sum = 0U;
+    for (ds::usize i = 0U; i < PART_KEYS; ++i) {
+      sum += ds::murmur3_hasher{}
+                 .update(tenants[i].data(), tenants[i].size())
+                 .update(paths[i].data(), paths[i].size())
+                 .update(objects[i].data(), objects[i].size())
+                 .finish();
+    }
+    return sum;
+  };
+}
+
+// === Batched Hashing === //
+
+const ds::usize BATCH_KEYS = 1U << 16U;
+const ds::usize BATCH_KEY_LENGTHS[] = {8U, 16U, 32U, 64U}; // NOLINT
+
+TEST_CASE("batched hash benchmarks", "[!benchmark][hash]") {
+  std::vector<ds::u8> buffer(BATCH_KEYS + 64U);
+  for (auto& byte : buffer) {
+    byte = (ds::u8)std::rand(); // NOLINT
+  }
+
+  for (auto length : BATCH_KEY_LENGTHS) {
+    // Keys of `length` bytes give or take 3, starting at scattered offsets
+    std::vector<const void*> keys(BATCH_KEYS);
+    std::vector<ds::i32> lens(BATCH_KEYS);
+    for (ds::usize i = 0U; i < BATCH_KEYS; ++i) {
+      keys[i] = buffer.data() + std::rand() % BATCH_KEYS; // NOLINT
+      lens[i] = (ds::i32)(length - std::rand() % 4U);     // NOLINT
+    }
+    std::vector<ds::u32> out(BATCH_KEYS);
+    std::string suffix = " ~" + std::to_string(length) + " byte keys";
+
+    BENCHMARK("murmur3 one at a time" + suffix) {
+      for (ds::usize i = 0U; i < BATCH_KEYS; ++i) {
+        MurmurHash3_x86_32(keys[i], lens[i], ds::SEED, &out[i]);
+      }
+      return out[0];
+    };
+
+    BENCHMARK("murmur3 batched" + suffix) {
+      MurmurHash3_x86_32_batch(
+          keys.data(), lens.data(), (ds::i32)BATCH_KEYS, ds::SEED, out.data()
+      );
+      return out[0];
+    };
+
+    // NOTE: SIMD lanes with DS_HASH_MURMUR3, a wyhash loop by default
+    std::vector<ds::usize> sizes(lens.begin(), lens.end());
+    std::vector<ds::usize> hashes(BATCH_KEYS);
+    BENCHMARK("hash_bytes_batch" + suffix) {
+      ds::hash_bytes_batch(
+          keys.data(), sizes.data(), BATCH_KEYS, hashes.data()
+      );
+      return hashes[0];
+    };
+
+    BENCHMARK("wyhash one at a time" + suffix) {
+      ds::u64 sum = 0U;
+      for (ds::usize i = 0U; i < BATCH_KEYS; ++i) {
+        sum += ds::wyhash_bytes(keys[i], lens[i]);
+      }
+      return sum;
+    };
+  }
+}
@@ -0,0 +1,719 @@
+/*===============================*
+ * Author/s:
+ *  - silentrald
+ * Version: 1.0
+ * Created: 2024-10-14
+ *===============================*/
+
+#include "ds/hash_map.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/benchmark/catch_chronometer.hpp"
+#include "catch2/catch_test_macros.hpp"
+#include "ds/hash_policy.hpp"
+#include "ds/hash_set.hpp"
+#include "ds/string.hpp"
+#include "ds/types.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Minimum bucket size before filling up to the target load factor
+const ds::usize MIN_CAPACITY = 100'000U;
+const ds::usize LOOKUPS = 100'000U;
+
+/**
+ * Fills the map with even keys until `LoadFactor`% of the bucket is used
+ **/
+template <ds::usize LoadFactor>
+void fill_to_load_factor(ds::hash_map<ds::u64, ds::u64>& map) {
+  ds::error_code error_code{};
+
+  // Grow the bucket first then fill up to the wanted load factor
+  while (map.get_capacity() < MIN_CAPACITY) {
+    error_code = map.insert((ds::u64)std::rand() * 2U, 0U); // NOLINT
+  }
+
+  // NOTE: Stop 1 element short so the last insert does not grow the bucket
+  while (map.get_size() + 1U < map.get_capacity() * LoadFactor / 100U) {
+    error_code = map.insert((ds::u64)std::rand() * 2U, 0U); // NOLINT
+  }
+}
+
+/**
+ * Creates `LOOKUPS` keys where `HitRatio`% of them exists in the map.
+ * Missing keys are odd since only even keys are inserted.
+ **/
+template <ds::usize HitRatio>
+std::vector<ds::u64> create_lookups(ds::hash_map<ds::u64, ds::u64>& map) {
+  std::vector<ds::u64> hits{};
+  for (auto it = map.begin(); it != map.end(); ++it) {
+    hits.push_back(it.key());
+  }
+
+  std::vector<ds::u64> lookups{};
+  lookups.reserve(LOOKUPS);
+  for (ds::usize i = 0U; i < LOOKUPS; ++i) {
+    if ((ds::usize)std::rand() % 100U < HitRatio) { // NOLINT
+      lookups.push_back(hits[(ds::usize)std::rand() % hits.size()]); // NOLINT
+    } else {
+      lookups.push_back((ds::u64)std::rand() * 2U + 1U); // NOLINT
+    }
+  }
+
+  return lookups;
+}
+
+template <ds::usize LoadFactor, ds::usize HitRatio> void benchmark_lookup() {
+  ds::hash_map<ds::u64, ds::u64> map{};
+  fill_to_load_factor<LoadFactor>(map);
+  auto lookups = create_lookups<HitRatio>(map);
+
+  BENCHMARK_ADVANCED("contains ds::hash_map")
+  (Catch::Benchmark::Chronometer meter) {
+    meter.measure([&map, &lookups]() {
+      ds::usize found = 0U;
+      for (auto key : lookups) {
+        found += map.contains(key);
+      }
+      return found;
+    });
+  };
+
+  BENCHMARK_ADVANCED("remove missing ds::hash_map")
+  (Catch::Benchmark::Chronometer meter) {
+    meter.measure([&map, &lookups]() {
+      for (auto key : lookups) {
+        if ((key & 1U) == 1U) {
+          map.remove(key);
+        }
+      }
+    });
+  };
+}
+
+template <ds::usize LoadFactor> void benchmark_hit_ratios() {
+  SECTION("hit 0%") {
+    benchmark_lookup<LoadFactor, 0U>();
+  }
+
+  SECTION("hit 25%") {
+    benchmark_lookup<LoadFactor, 25U>();
+  }
+
+  SECTION("hit 50%") {
+    benchmark_lookup<LoadFactor, 50U>();
+  }
+
+  SECTION("hit 75%") {
+    benchmark_lookup<LoadFactor, 75U>();
+  }
+
+  SECTION("hit 100%") {
+    benchmark_lookup<LoadFactor, 100U>();
+  }
+}
+
+TEST_CASE("hash_map lookup benchmarks", "[!benchmark][hash_map]") {
+  SECTION("load factor 0.5") {
+    benchmark_hit_ratios<50U>();
+  }
+
+  SECTION("load factor 0.7") {
+    benchmark_hit_ratios<70U>();
+  }
+
+  SECTION("load factor 0.8") {
+    benchmark_hit_ratios<80U>();
+  }
+
+  SECTION("load factor 0.9") {
+    benchmark_hit_ratios<90U>();
+  }
+}
+
+// === Hash Policies === //
+
+// NOTE: Ends at ~0.86 load for the prime policy and ~0.65 for power of two
+const ds::u64 POLICY_KEYS = 85'000U;
+const ds::u64 POLICY_STRIDE = 4096U;
+
+template <typename Policy, typename Hash = ds::hash<ds::u64>>
+using policy_hash_map =
+    ds::hash_map<ds::u64, ds::u64, Hash, ds::equal<ds::u64>, Policy>;
+
+template <typename Policy, typename Hash = ds::hash<ds::u64>>
+void benchmark_policy(const std::vector<ds::u64>& keys, const char* name) {
+  BENCHMARK_ADVANCED(std::string{"insert "} + name)
+  (Catch::Benchmark::Chronometer meter) {
+    meter.measure([&keys]() {
+      policy_hash_map<Policy, Hash> map{};
+      ds::error_code error_code{};
+      for (auto key : keys) {
+        error_code = map.insert(key, key);
+      }
+      return map.get_size();
+    });
+  };
+
+  policy_hash_map<Policy, Hash> map{};
+  ds::error_code error_code{};
+  for (auto key : keys) {
+    error_code = map.insert(key, key);
+  }
+
+  BENCHMARK_ADVANCED(std::string{"contains "} + name)
+  (Catch::Benchmark::Chronometer meter) {
+    meter.measure([&map, &keys]() {
+      ds::usize found = 0U;
+      for (auto key : keys) {
+        found += map.contains(key);
+      }
+      return found;
+    });
+  };
+
+  BENCHMARK_ADVANCED(std::string{"contains missing "} + name)
+  (Catch::Benchmark::Chronometer meter) {
+    meter.measure([&map, &keys]() {
+      ds::usize found = 0U;
+      for (auto key : keys) {
+        found += map.contains(key + 1U);
+      }
+      return found;
+    });
+  };
+}
+
+void benchmark_policies(const std::vector<ds::u64>& keys) {
+  benchmark_policy<ds::prime_hash_policy>(keys, "prime");
+  benchmark_policy<ds::power_of_two_hash_policy>(keys, "power of two");
+  benchmark_policy<ds::power_of_two_hash_policy, ds::fmix_hash<ds::u64>>(
+      keys, "power of two fmix64"
+  );
+  benchmark_policy<ds::power_of_two_hash_policy, ds::splitmix_hash<ds::u64>>(
+      keys, "power of two splitmix64"
+  );
+  benchmark_policy<ds::seeded_hash_policy<ds::power_of_two_hash_policy>>(
+      keys, "seeded power of two"
+  );
+}
+
+TEST_CASE("hash_map policy benchmarks", "[!benchmark][hash_map]") {
+  std::vector<ds::u64> keys{};
+  keys.reserve(POLICY_KEYS);
+
+  SECTION("sequential keys") {
+    for (ds::u64 i = 0U; i < POLICY_KEYS; ++i) {
+      keys.push_back(i * 2U);
+    }
+    benchmark_policies(keys);
+  }
+
+  SECTION("strided keys") {
+    for (ds::u64 i = 0U; i < POLICY_KEYS; ++i) {
+      keys.push_back(i * POLICY_STRIDE);
+    }
+    benchmark_policies(keys);
+  }
+
+  SECTION("random keys") {
+    for (ds::u64 i = 0U; i < POLICY_KEYS; ++i) {
+      keys.push_back((ds::u64)std::rand() * 2U); // NOLINT
+    }
+    benchmark_policies(keys);
+  }
+}
+
+// === Insert Latency === //
+
+const ds::usize LATENCY_INSERTS = 4'000'000U;
+
+/**
+ * Times every insert and prints the latency percentiles, rehashing the whole
+ *   bucket in a single insert shows up in the tail
+ **/
+template <typename Policy> void print_insert_latency(const char* name) {
+  policy_hash_map<Policy> map{};
+  std::vector<ds::u64> latencies{};
+  latencies.reserve(LATENCY_INSERTS);
+
+  ds::error_code error_code{};
+  for (ds::usize i = 0U; i < LATENCY_INSERTS; ++i) {
+    auto key = (ds::u64)std::rand() * LATENCY_INSERTS + i; // NOLINT
+
+    auto start = std::chrono::steady_clock::now();
+    error_code = map.insert(key, key);
+    auto end = std::chrono::steady_clock::now();
+
+    latencies.push_back(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+            .count()
+    );
+  }
+
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&latencies](ds::f64 percent) {
+    return latencies[(ds::usize)(percent * (latencies.size() - 1U))];
+  };
+
+  printf(
+      "%-16s p50 %8llu ns  p99 %8llu ns  p99.9 %8llu ns  max %10llu ns\n",
+      name, percentile(0.5), percentile(0.99), percentile(0.999),
+      latencies.back()
+  );
+}
+
+TEST_CASE("hash_map insert latency", "[!benchmark][hash_map]") {
+  print_insert_latency<ds::prime_hash_policy>("prime");
+  print_insert_latency<ds::incremental_hash_policy<ds::prime_hash_policy>>(
+      "incremental"
+  );
+}
+
+// === Batched Lookups === //
+
+const ds::usize BATCH_LOOKUPS = 100'000U;
+
+/**
+ * Random lookups where half of the keys exist, the same keys are used for
+ *   the single and batched lookups
+ **/
+std::vector<ds::u64> create_batch_lookups(ds::usize size) {
+  std::vector<ds::u64> lookups{};
+  lookups.reserve(BATCH_LOOKUPS);
+  for (ds::usize i = 0U; i < BATCH_LOOKUPS; ++i) {
+    lookups.push_back((ds::u64)std::rand() % (size * 2U)); // NOLINT
+  }
+  return lookups;
+}
+
+void benchmark_batch_lookup(ds::usize size) {
+  // NOTE: Only even keys are inserted
+  ds::hash_map<ds::u64, ds::u64> map{};
+  ds::hash_set<ds::u64> set{};
+  ds::error_code error_code{};
+  for (ds::u64 i = 0U; i < size; ++i) {
+    error_code = map.insert(i * 2U, i);
+    error_code = set.insert(i * 2U);
+  }
+
+  auto lookups = create_batch_lookups(size);
+  std::vector<ds::u64*> values(lookups.size());
+  // NOTE: vector<bool> is packed, a plain array is needed for the output
+  bool* found = new bool[lookups.size()]; // NOLINT
+
+  BENCHMARK_ADVANCED("operator[] ds::hash_map")
+  (Catch::Benchmark::Chronometer meter) {
+    meter.measure([&map, &lookups, &values]() {
+      for (ds::usize i = 0U; i < lookups.size(); ++i) {
+        values[i] = map[lookups[i]];
+      }
+      return values.back();
+    });
+  };
+
+  BENCHMARK_ADVANCED("find_batch ds::hash_map")
+  (Catch::Benchmark::Chronometer meter) {
+    meter.measure([&map, &lookups, &values]() {
+      map.find_batch(lookups.data(), lookups.size(), values.data());
+      return values.back();
+    });
+  };
+
+  BENCHMARK_ADVANCED("contains ds::hash_map")
+  (Catch::Benchmark::Chronometer meter) {
+    meter.measure([&map, &lookups, found]() {
+      for (ds::usize i = 0U; i < lookups.size(); ++i) {
+        found[i] = map.contains(lookups[i]);
+      }
+      return found[0];
+    });
+  };
+
+  BENCHMARK_ADVANCED("contains_batch ds::hash_map")
+  (Catch::Benchmark::Chronometer meter) {
+    meter.measure([&map, &lookups, found]() {
+      map.contains_batch(lookups.data(), lookups.size(), found);
+      return found[0];
+    });
+  };
+
+  BENCHMARK_ADVANCED("contains ds::hash_set")
+  (Catch::Benchmark::Chronometer meter) {
+    meter.measure([&set, &lookups, found]() {
+      for (ds::usize i = 0U; i < lookups.size(); ++i) {
+        found[i] = set.contains(lookups[i]);
+      }
+      return found[0];
+    });
+  };
+
+  BENCHMARK_ADVANCED("contains_batch ds::hash_set")
+  (Catch::Benchmark::Chronometer meter) {
+    meter.measure([&set, &lookups, found]() {
+      set.contains_batch(lookups.data(), lookups.size(), found);
+      return found[0];
+    });
+  };
+
+  delete[] found; // NOLINT
+}
+
+TEST_CASE("hash_map batched lookup benchmarks", "[!benchmark][hash_map]") {
+  SECTION("64k keys, fits in the cache") {
+    benchmark_batch_lookup(64'000U);
+  }
+
+  SECTION("16m keys, larger than the last level cache") {
+    benchmark_batch_lookup(16'000'000U);
+  }
+}
+
+// === Stored Hashes === //
+
+const ds::usize URL_KEYS = 200'000U;
+
+// NOLINTNEXTLINE
+const ds::c8* URL_HOSTS[] = {
+    "https://api.example.com",
+    "https://static.example-cdn.net",
+    "https://accounts.example.org",
+    "http://internal.service.local:8080",
+};
+
+/**
+ * URL-like keys, long shared prefixes with the differences near the end
+ **/
+std::vector<std::string> create_urls(ds::usize count, ds::usize seed) {
+  std::vector<std::string> urls{};
+  urls.reserve(count);
+
+  ds::c8 characters[128]; // NOLINT
+  for (ds::usize i = 0U; i < count; ++i) {
+    std::snprintf(
+        characters, sizeof(characters),
+        "%s/v2/users/%08llu/repositories/%06llu/commits?page=%04llu",
+        URL_HOSTS[i % 4U], (ds::u64)seed + i / 64U, (ds::u64)i % 64U * 7919U,
+        (ds::u64)i % 1000U
+    );
+    urls.emplace_back(characters);
+  }
+
+  return urls;
+}
+
+template <typename Policy>
+using url_hash_map = ds::hash_map<
+    ds::string, ds::usize, ds::hash<ds::string>, ds::equal<ds::string>,
+    Policy>;
+
+template <typename Policy>
+using url_hash_set = ds::hash_set<
+    ds::string, ds::hash<ds::string>, ds::equal<ds::string>, Policy>;
+
+template <typename Policy>
+void benchmark_stored_hash(
+    const std::vector<std::string>& urls,
+    const std::vector<std::string>& missing, const char* name
+) {
+  BENCHMARK_ADVANCED(std::string{"insert hash_map "} + name)
+  (Catch::Benchmark::Chronometer meter) {
+    meter.measure([&urls]() {
+      url_hash_map<Policy> map{};
+      ds::error_code error_code{};
+      for (ds::usize i = 0U; i < urls.size(); ++i) {
+        error_code = map.insert(urls[i].c_str(), i);
+      }
+      return map.get_size();
+    });
+  };
+
+  BENCHMARK_ADVANCED(std::string{"insert hash_set "} + name)
+  (Catch::Benchmark::Chronometer meter) {
+    meter.measure([&urls]() {
+      url_hash_set<Policy> set{};
+      ds::error_code error_code{};
+      for (const auto& url : urls) {
+        error_code = set.insert(url.c_str());
+      }
+      return set.get_size();
+    });
+  };
+
+  url_hash_map<Policy> map{};
+  ds::error_code error_code{};
+  for (ds::usize i = 0U; i < urls.size(); ++i) {
+    error_code = map.insert(urls[i].c_str(), i);
+  }
+
+  BENCHMARK_ADVANCED(std::string{"contains "} + name)
+  (Catch::Benchmark::Chronometer meter) {
+    meter.measure([&map, &urls]() {
+      ds::usize found = 0U;
+      for (const auto& url : urls) {
+        found += map.contains(url.c_str());
+      }
+      return found;
+    });
+  };
+
+  BENCHMARK_ADVANCED(std::string{"contains missing "} + name)
+  (Catch::Benchmark::Chronometer meter) {
+    meter.measure([&map, &missing]() {
+      ds::usize found = 0U;
+      for (const auto& url : missing) {
+        found += map.contains(url.c_str());
+      }
+      return found;
+    });
+  };
+}
+
+TEST_CASE("hash_map stored hash benchmarks", "[!benchmark][hash_map]") {
+  auto urls = create_urls(URL_KEYS, 0U);
+  // NOTE: Only the user id differs from the inserted urls
+  auto missing = create_urls(URL_KEYS, URL_KEYS);
+
+  benchmark_stored_hash<ds::prime_hash_policy>(urls, missing, "prime");
+  benchmark_stored_hash<ds::stored_hash_policy<ds::prime_hash_policy>>(
+      urls, missing, "stored hash"
+  );
+}
+
+// === Bulk Load === //
+
+const ds::usize BULK_KEYS = 4'000'000U;
+
+/**
+ * Inserts BULK_KEYS keys into a new hash map, with reserve the bucket is sized
+ *   once instead of going through every growth of the policy
+ **/
+void benchmark_bulk_load(ds::f32 load_factor, const char* name, bool reserve) {
+  BENCHMARK_ADVANCED(std::string{name} + (reserve ? " reserve" : " growing"))
+  (Catch::Benchmark::Chronometer meter) {
+    meter.measure([load_factor, reserve]() {
+      ds::hash_map<ds::u64, ds::u64> map{};
+      ds::error_code error_code = map.set_max_load_factor(load_factor);
+      if (reserve) {
+        error_code = map.reserve(BULK_KEYS);
+      }
+      for (ds::u64 i = 0U; i < BULK_KEYS; ++i) {
+        error_code = map.insert(i * 0x9E3779B97F4A7C15ULL, i);
+      }
+      return map.get_size();
+    });
+  };
+}
+
+TEST_CASE("hash_map bulk load benchmarks", "[!benchmark][hash_map]") {
+  benchmark_bulk_load(ds::HASHMAP_LOAD_FACTOR, "load factor 0.9", false);
+  benchmark_bulk_load(ds::HASHMAP_LOAD_FACTOR, "load factor 0.9", true);
+  benchmark_bulk_load(0.5F, "load factor 0.5", false);
+  benchmark_bulk_load(0.5F, "load factor 0.5", true);
+}
+
+// === Copying === //
+
+const ds::usize COPY_KEYS = 1'000'000U;
+const ds::usize COPY_STRING_KEYS = 200'000U;
+
+template <typename Map, typename Fill>
+void benchmark_copy(const Map& map, Fill&& fill, const std::string& name) {
+  BENCHMARK_ADVANCED("copy " + name)
+  (Catch::Benchmark::Chronometer meter) {
+    meter.measure([&map]() {
+      Map copy{};
+      ds::error_code error_code = copy.copy(map);
+      return copy.get_size() + error_code;
+    });
+  };
+
+  BENCHMARK_ADVANCED("rebuild by insert " + name)
+  (Catch::Benchmark::Chronometer meter) {
+    meter.measure([&fill]() {
+      Map copy{};
+      fill(copy);
+      return copy.get_size();
+    });
+  };
+}
+
+TEST_CASE("hash_map copy benchmarks", "[!benchmark][hash_map]") {
+  ds::hash_map<ds::u64, ds::u64> map{};
+  auto fill_map = [](ds::hash_map<ds::u64, ds::u64>& target) {
+    ds::error_code error_code{};
+    for (ds::u64 i = 0U; i < COPY_KEYS; ++i) {
+      error_code = target.insert(i * 0x9E3779B97F4A7C15ULL, i);
+    }
+  };
+  fill_map(map);
+  benchmark_copy(map, fill_map, "hash_map<u64, u64>");
+
+  auto urls = create_urls(COPY_STRING_KEYS, 0U);
+  ds::hash_map<ds::string, ds::u64> string_map{};
+  auto fill_string_map = [&urls](ds::hash_map<ds::string, ds::u64>& target) {
+    ds::error_code error_code{};
+    for (ds::usize i = 0U; i < urls.size(); ++i) {
+      error_code = target.insert(urls[i].c_str(), i);
+    }
+  };
+  fill_string_map(string_map);
+  benchmark_copy(string_map, fill_string_map, "hash_map<string, u64>");
+}
+
+// === Sparse Tables === //
+
+const ds::usize SPARSE_CAPACITY = 4'000'000U;
+const ds::usize SPARSE_KEYS = 1'000U;
+
+// Value that costs a constructor and destructor call per node
+struct heavy_value {
+  ds::u64 data[8]{}; // NOLINT
+};
+
+TEST_CASE("hash_map sparse table benchmarks", "[!benchmark][hash_map]") {
+  BENCHMARK_ADVANCED("reserve and destroy sparse hash_map<u64, heavy_value>")
+  (Catch::Benchmark::Chronometer meter) {
+    meter.measure([]() {
+      ds::hash_map<ds::u64, heavy_value> map{};
+      ds::error_code error_code = map.reserve(SPARSE_CAPACITY);
+      for (ds::u64 i = 0U; i < SPARSE_KEYS; ++i) {
+        error_code = map.insert(i, heavy_value{});
+      }
+      return map.get_capacity() + error_code;
+    });
+  };
+
+  BENCHMARK_ADVANCED("reserve and destroy sparse hash_map<u64, string>")
+  (Catch::Benchmark::Chronometer meter) {
+    meter.measure([]() {
+      ds::hash_map<ds::u64, ds::string> map{};
+      ds::error_code error_code = map.reserve(SPARSE_CAPACITY);
+      for (ds::u64 i = 0U; i < SPARSE_KEYS; ++i) {
+        error_code = map.insert(i, "value");
+      }
+      return map.get_capacity() + error_code;
+    });
+  };
+}
+
+// === Upserts === //
+
+const ds::usize UPSERTS = 1'000'000U;
+const ds::u64 UPSERT_KEYS = 10'000U;
+
+TEST_CASE("hash_map upsert benchmarks", "[!benchmark][hash_map]") {
+  // Word counts with a lot of repeated keys
+  std::vector<std::string> words{};
+  for (ds::usize i = 0U; i < UPSERTS; ++i) {
+    words.push_back("word-" + std::to_string(std::rand() % UPSERT_KEYS));
+  }
+
+  BENCHMARK("u64 counter with find and insert") {
+    ds::hash_map<ds::u64, ds::u64> map{};
+    ds::error_code error_code{};
+    for (ds::usize i = 0U; i < UPSERTS; ++i) {
+      ds::u64 key = i % UPSERT_KEYS;
+      ds::u64* value = map[key];
+      error_code = map.insert(key, value == nullptr ? 1U : *value + 1U);
+    }
+    return map.get_size() + error_code;
+  };
+
+  BENCHMARK("u64 counter with get_or_insert") {
+    ds::hash_map<ds::u64, ds::u64> map{};
+    for (ds::usize i = 0U; i < UPSERTS; ++i) {
+      ++**map.get_or_insert(i % UPSERT_KEYS);
+    }
+    return map.get_size();
+  };
+
+  BENCHMARK("string counter with find and insert") {
+    ds::hash_map<ds::string, ds::u64> map{};
+    ds::error_code error_code{};
+    for (const auto& word : words) {
+      ds::u64* value = map[word.c_str()];
+      error_code =
+          map.insert(word.c_str(), value == nullptr ? 1U : *value + 1U);
+    }
+    return map.get_size() + error_code;
+  };
+
+  BENCHMARK("string counter with get_or_insert") {
+    ds::hash_map<ds::string, ds::u64> map{};
+    for (const auto& word : words) {
+      ++**map.get_or_insert(word.c_str());
+    }
+    return map.get_size();
+  };
+}
+
+// === Hash Flooding === //
+
+// NOTE: Stays below the max probe distance so the unseeded map still accepts
+//   every key
+const ds::u64 FLOODING_KEYS = 250U;
+const ds::usize FLOODING_ROUNDS = 100U;
+
+// Keys that all land in slot 0 of an unseeded power of two map
+ds::u64 get_flooding_key(ds::u64 index) noexcept {
+  // NOTE: Newton's iteration for the inverse of an odd number modulo 2^64
+  ds::u64 inverse = ds::FIBONACCI_MULTIPLIER;
+  for (ds::u32 i = 0U; i < 5U; ++i) {
+    inverse *= 2U - ds::FIBONACCI_MULTIPLIER * inverse;
+  }
+  return index * inverse;
+}
+
+template <typename Policy>
+void benchmark_flooding(const std::vector<ds::u64>& keys, const char* name) {
+  BENCHMARK_ADVANCED(std::string{"insert "} + name)
+  (Catch::Benchmark::Chronometer meter) {
+    meter.measure([&keys]() {
+      ds::usize size = 0U;
+      for (ds::usize round = 0U; round < FLOODING_ROUNDS; ++round) {
+        policy_hash_map<Policy> map{};
+        ds::error_code error_code{};
+        for (auto key : keys) {
+          error_code = map.insert(key, key);
+        }
+        size += map.get_size() + error_code;
+      }
+      return size;
+    });
+  };
+
+  policy_hash_map<Policy> map{};
+  ds::error_code error_code{};
+  for (auto key : keys) {
+    error_code = map.insert(key, key);
+  }
+
+  BENCHMARK_ADVANCED(std::string{"contains "} + name)
+  (Catch::Benchmark::Chronometer meter) {
+    meter.measure([&map, &keys]() {
+      ds::usize found = 0U;
+      for (ds::usize round = 0U; round < FLOODING_ROUNDS; ++round) {
+        for (auto key : keys) {
+          found += map.contains(key);
+        }
+      }
+      return found;
+    });
+  };
+}
+
+TEST_CASE("hash_map flooding benchmarks", "[!benchmark][hash_map]") {
+  std::vector<ds::u64> keys{};
+  for (ds::u64 i = 0U; i < FLOODING_KEYS; ++i) {
+    keys.push_back(get_flooding_key(i));
+  }
+
+  benchmark_flooding<ds::power_of_two_hash_policy>(keys, "unseeded");
+  benchmark_flooding<ds::seeded_hash_policy<ds::power_of_two_hash_policy>>(
+      keys, "seeded"
+  );
+}
@@ -0,0 +1,264 @@
+/*===============================*
+ * Author/s:
+ *  - silentrald
+ * Version: 1.0
+ * Created: 2024-10-17
+ *===============================*/
+
+#ifndef DS_THREAD_CONCURRENT_HASH_MAP_HPP
+#define DS_THREAD_CONCURRENT_HASH_MAP_HPP
+
+#include "./mutex.hpp"
+#include "ds/equal.hpp"
+#include "ds/hash.hpp"
+#include "ds/hash_map.hpp"
+#include "ds/hash_policy.hpp"
+#include "ds/types.hpp"
+#include <utility>
+
+namespace ds {
+
+// NOTE: Each shard starts on its own cache line so the locks of different
+//   shards never share a line
+inline const usize CONCURRENT_HASHMAP_CACHE_LINE_SIZE = 64U;
+
+/**
+ * Hash map shared between threads, the keys are split into `ShardCount`
+ *   hash_maps with their own lock so threads working on different shards do
+ *   not wait on each other. The shard is picked with the low bits of the
+ *   fmix64 mixed hash, so it stays independent of the index the policy of the
+ *   shard hash_map takes from the same hash.
+ *
+ * Values are only reachable inside the callbacks while the shard is locked,
+ *   no pointer to a value is ever handed out. Callbacks should not access the
+ *   same concurrent_hash_map since the shard lock is not recursive.
+ **/
+template <
+    typename Key, typename Value, typename Hash = hash<Key>,
+    typename KeyEqual = equal<Key>, typename Policy = prime_hash_policy,
+    usize ShardCount = 16U>
+class concurrent_hash_map {
+public:
+  static_assert(
+      ShardCount > 0U && (ShardCount & (ShardCount - 1U)) == 0U,
+      "ShardCount should be a power of two"
+  );
+
+  using key_type = Key;
+  using value_type = Value;
+  using map_type = hash_map<Key, Value, Hash, KeyEqual, Policy>;
+
+  concurrent_hash_map() noexcept = default;
+  concurrent_hash_map(const concurrent_hash_map&) = delete;
+  concurrent_hash_map& operator=(const concurrent_hash_map&) = delete;
+  concurrent_hash_map(concurrent_hash_map&&) = delete;
+  concurrent_hash_map& operator=(concurrent_hash_map&&) = delete;
+  ~concurrent_hash_map() noexcept = default;
+
+  // === Capacity === //
+
+  /**
+   * Counts the pairs of every shard, each shard is locked one at a time so the
+   *   count can be stale if other threads are mutating the map
+   *
+   * @errors
+   *  - error_codes::THREAD_ERROR
+   **/
+  [[nodiscard]] expected<usize, error_code> get_size() const noexcept {
+    usize size = 0U;
+    for (auto& shard : this->shards) {
+      DS_TRY(shard.lock.lock(), to_unexpected);
+      size += shard.map.get_size();
+      shard.lock.unlock();
+    }
+    return size;
+  }
+
+  [[nodiscard]] static constexpr usize get_shard_count() noexcept {
+    return ShardCount;
+  }
+
+  // === Modifiers === //
+
+  /**
+   * Inserts a value in the hash map, accepts anything the insert of the
+   *   shard's hash_map accepts
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION - bucket resize or key/value copy
+   *  - error_codes::CONTAINER_FULL - max limit of hash_map
+   *  - error_codes::THREAD_ERROR
+   *  - error_code from copy for key or value
+   **/
+  template <typename Key_, typename Value_>
+  [[nodiscard]] error_code insert(Key_&& key, Value_&& value) noexcept {
+    auto& shard = this->shards[get_shard_index(key)];
+    DS_TRY(shard.lock.lock());
+    error_code error =
+        shard.map.insert(std::forward<Key_>(key), std::forward<Value_>(value));
+    shard.lock.unlock();
+    return error;
+  }
+
+  /**
+   * Removes a key/value pair in the hash map
+   * If no key was found, nothing will happen to the hash map
+   *
+   * @errors
+   *  - error_codes::THREAD_ERROR
+   **/
+  template <typename Key_>
+  [[nodiscard]] error_code remove(const Key_& key) noexcept {
+    auto& shard = this->shards[get_shard_index(key)];
+    DS_TRY(shard.lock.lock());
+    shard.map.remove(key);
+    shard.lock.unlock();
+    return error_codes::OK;
+  }
+
+  /**
+   * Removes all the pairs, each shard is cleared one at a time
+   *
+   * @errors
+   *  - error_codes::THREAD_ERROR
+   **/
+  [[nodiscard]] error_code clear() noexcept {
+    for (auto& shard : this->shards) {
+      DS_TRY(shard.lock.lock());
+      shard.map.clear();
+      shard.lock.unlock();
+    }
+    return error_codes::OK;
+  }
+
+  // === Lookup === //
+
+  /**
+   * Calls `callback(const Value&)` with the value of the key while its shard is
+   *   locked
+   *
+   * @errors
+   *  - error_codes::NOT_FOUND
+   *  - error_codes::THREAD_ERROR
+   **/
+  template <typename Key_, typename Callback>
+  [[nodiscard]] error_code
+  find(const Key_& key, Callback&& callback) const noexcept {
+    auto& shard = this->shards[get_shard_index(key)];
+    DS_TRY(shard.lock.lock());
+
+    const Value* value = shard.map[key];
+    if (value == nullptr) {
+      shard.lock.unlock();
+      return error_codes::NOT_FOUND;
+    }
+
+    callback(*value);
+    shard.lock.unlock();
+    return error_codes::OK;
+  }
+
+  /**
+   * Calls `callback(Value&)` with the value of the key while its shard is
+   *   locked, the value can be modified in place
+   *
+   * @errors
+   *  - error_codes::NOT_FOUND
+   *  - error_codes::THREAD_ERROR
+   **/
+  template <typename Key_, typename Callback>
+  [[nodiscard]] error_code
+  update(const Key_& key, Callback&& callback) noexcept {
+    auto& shard = this->shards[get_shard_index(key)];
+    DS_TRY(shard.lock.lock());
+
+    Value* value = shard.map[key];
+    if (value == nullptr) {
+      shard.lock.unlock();
+      return error_codes::NOT_FOUND;
+    }
+
+    callback(*value);
+    shard.lock.unlock();
+    return error_codes::OK;
+  }
+
+  /**
+   * Checks if the key exists in the hash map
+   *
+   * @errors
+   *  - error_codes::THREAD_ERROR
+   **/
+  template <typename Key_>
+  [[nodiscard]] expected<bool, error_code>
+  contains(const Key_& key) const noexcept {
+    auto& shard = this->shards[get_shard_index(key)];
+    DS_TRY(shard.lock.lock(), to_unexpected);
+    bool found = shard.map.contains(key);
+    shard.lock.unlock();
+    return found;
+  }
+
+  /**
+   * Calls `callback(const Key&, const Value&)` for every pair, each shard is
+   *   locked while its pairs are visited
+   *
+   * @errors
+   *  - error_codes::THREAD_ERROR
+   **/
+  template <typename Callback>
+  [[nodiscard]] error_code for_each(Callback&& callback) const noexcept {
+    for (auto& shard : this->shards) {
+      DS_TRY(shard.lock.lock());
+      for (auto it = shard.map.cbegin(); it != shard.map.cend(); ++it) {
+        callback(it.key(), it.value());
+      }
+      shard.lock.unlock();
+    }
+    return error_codes::OK;
+  }
+
+#ifdef DS_HASH_STATS
+  /**
+   * Collects the stats of the hash_map of a shard, see hash_map::get_stats
+   *
+   * @errors
+   *  - error_codes::THREAD_ERROR
+   **/
+  [[nodiscard]] expected<hash_stats, error_code>
+  get_stats(usize shard_index) const noexcept {
+    auto& shard = this->shards[shard_index];
+    DS_TRY(shard.lock.lock(), to_unexpected);
+    hash_stats stats = shard.map.get_stats();
+    shard.lock.unlock();
+    return stats;
+  }
+#endif
+
+private:
+  struct alignas(CONCURRENT_HASHMAP_CACHE_LINE_SIZE) shard_type {
+    mutable mutex lock{};
+    map_type map{};
+  };
+
+  shard_type shards[ShardCount]; // NOLINT
+
+  /**
+   * Picks the shard with the low bits of the fmix64 mixed hash. Taking the
+   *   same bits as the policy (e.g. the high bits of the fibonacci multiply in
+   *   power_of_two_hash_policy) would leave every shard with keys that only
+   *   reach a fraction of its buckets.
+   **/
+  template <typename Key_>
+  [[nodiscard]] static usize get_shard_index(const Key_& key) noexcept {
+    if constexpr (ShardCount == 1U) {
+      return 0U;
+    } else {
+      return (usize)fmix64((u64)Hash{}(key)) & (ShardCount - 1U);
+    }
+  }
+};
+
+} // namespace ds
+
+#endif
@@ -6,12 +6,8 @@
  *===============================*/
 
 #include "./mutex.hpp"
-#include "ds-error/error.hpp"
-#include "ds/macro.hpp"
-#include "ds/optional.hpp"
 #include "ds/types.hpp"
 #include <pthread.h>
-#include <utility>
 
 namespace ds {
 
@@ -20,15 +16,15 @@ mutex::~mutex() noexcept {
   pthread_mutex_destroy(&this->_mutex);
 }
 
-opt_err mutex::lock() noexcept {
+error_code mutex::lock() noexcept {
   if (pthread_mutex_lock(&this->_mutex) != 0) {
-    return error{DS_ERROR_THREAD, def_err_vals};
+    return error_codes::THREAD_ERROR;
   }
-  return null;
+  return error_codes::OK;
 }
 
-void mutex::try_lock() noexcept {
-  pthread_mutex_trylock(&this->_mutex); // NOLINT
+bool mutex::try_lock() noexcept {
+  return pthread_mutex_trylock(&this->_mutex) == 0;
 }
 
 void mutex::unlock() noexcept {
@@ -36,4 +32,3 @@ void mutex::unlock() noexcept {
 }
 
 } // namespace ds
-
@@ -10,7 +10,6 @@
 
 // TODO: Look into window thread
 
-#include "ds-error/types.hpp"
 #include "ds/types.hpp"
 #include <pthread.h>
 
@@ -33,12 +32,24 @@ public:
 
   // === Functions === //
 
-  opt_err lock() noexcept;
-  void try_lock() noexcept;
+  /**
+   * Blocks until the mutex is acquired
+   *
+   * @errors
+   *  - error_codes::THREAD_ERROR
+   **/
+  [[nodiscard]] error_code lock() noexcept;
+
+  /**
+   * Acquires the mutex without blocking
+   *
+   * @returns whether the mutex was acquired
+   **/
+  [[nodiscard]] bool try_lock() noexcept;
+
   void unlock() noexcept;
 };
 
 } // namespace ds
 
 #endif
-
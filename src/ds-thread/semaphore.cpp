@@ -6,29 +6,27 @@
  *===============================*/
 
 #include "./semaphore.hpp"
-#include "ds/macro.hpp"
-#include "ds/optional.hpp"
 #include "ds/types.hpp"
 #include <semaphore.h>
 
 namespace ds {
 
-opt_err semaphore::init(u32 max) noexcept {
+error_code semaphore::init(u32 max) noexcept {
   if (sem_init(&this->sem, 0, max) != 0) {
-    return error{DS_ERROR_THREAD, def_err_vals};
+    return error_codes::THREAD_ERROR;
   }
-  return null;
+  return error_codes::OK;
 }
 
 semaphore::~semaphore() noexcept {
   sem_destroy(&this->sem);
 }
 
-opt_err semaphore::acquire() noexcept {
+error_code semaphore::acquire() noexcept {
   if (sem_wait(&this->sem) != 0) {
-    return error{DS_ERROR_THREAD, def_err_vals};
+    return error_codes::THREAD_ERROR;
   }
-  return null;
+  return error_codes::OK;
 }
 
 void semaphore::release() noexcept {
@@ -36,4 +34,3 @@ void semaphore::release() noexcept {
 }
 
 } // namespace ds
-
@@ -10,7 +10,6 @@
 
 // TODO: Look into window thread
 
-#include "ds-error/types.hpp"
 #include "ds/types.hpp"
 #include <semaphore.h>
 
@@ -29,16 +28,25 @@ public:
 
   // === Constructor === //
 
-  opt_err init(u32 max) noexcept;
+  /**
+   * @errors
+   *  - error_codes::THREAD_ERROR
+   **/
+  [[nodiscard]] error_code init(u32 max) noexcept;
   ~semaphore() noexcept;
 
   // === Functions === //
 
-  opt_err acquire() noexcept;
+  /**
+   * Blocks until the semaphore is acquired
+   *
+   * @errors
+   *  - error_codes::THREAD_ERROR
+   **/
+  [[nodiscard]] error_code acquire() noexcept;
   void release() noexcept;
 };
 
 } // namespace ds
 
 #endif
-
@@ -12,6 +12,7 @@
 #include "./bptree_map_iterator.hpp"
 #include "./bptree_map_node.hpp"
 #include "./compare.hpp"
+#include "./node_pool.hpp"
 #include "./types.hpp"
 #include "./vector.hpp"
 #include <type_traits>
@@ -24,21 +25,36 @@ namespace ds {
 
 /**
  * B+ Tree implementation
- * NOTE: No support for Key class type, might need in the future
- * NOTE: No implementation for strings yet, might need in the future
+ * NOTE: Keys are copied between nodes by assignment, so class type keys have
+ *   to be trivially copyable (e.g. a struct of integers with its own
+ *   KeyCompare). Keys that own memory are not supported.
+ * NOTE: String keys are stored as views, see bptree_map_string.hpp
+ *
+ * `Degree` is the number of keys in a node, see bptree_degree to get it from
+ *   the size of the node in bytes
  *
  * Reference: https://en.wikipedia.org/wiki/B%2B_tree
  **/
 template <
     typename Derived, typename Key, typename Value,
-    typename KeyCompare = compare<Key>, typename Allocator = allocator<void>>
+    typename KeyCompare = compare<Key>, typename Allocator = allocator<void>,
+    usize Degree = bptree_degree<Key>(BPTREE_NODE_SIZE)>
 class base_bptree_map {
 private:
+  static_assert(
+      Degree >= 4U && Degree % 2U == 0U,
+      "bptree_map nodes need an even number of keys, at least 4"
+  );
+  static_assert(
+      std::is_trivially_copyable_v<Key>,
+      "bptree_map keys should be trivially copyable, see bptree_map_string.hpp "
+      "for string keys"
+  );
+
   // === Definitions === //
 
   [[nodiscard]] static constexpr i32 get_degree() noexcept {
-    // Minimum degree is 3
-    return 64U / sizeof(Key) > 3U ? 64U / sizeof(Key) : 3U;
+    return (i32)Degree;
   }
 
   [[nodiscard]] constexpr i32 middle() const noexcept {
@@ -76,7 +92,9 @@ public:
   // === Move === //
 
   base_bptree_map(base_bptree_map&& rhs) noexcept
-      : root(rhs.root), size(rhs.size), height(height) {
+      : root(rhs.root), size(rhs.size), height(rhs.height),
+        leaf_pool(std::move(rhs.leaf_pool)),
+        inner_pool(std::move(rhs.inner_pool)) {
     rhs.root = nullptr;
     rhs.size = rhs.height = 0;
   }
@@ -86,6 +104,9 @@ public:
       return *this;
     }
 
+    this->clear();
+    this->leaf_pool = std::move(rhs.leaf_pool);
+    this->inner_pool = std::move(rhs.inner_pool);
     this->root = rhs.root;
     this->size = rhs.size;
     this->height = rhs.height;
@@ -107,66 +128,15 @@ public:
   }
 
   /**
-   * Removes all elements in the map
+   * Removes all elements in the map, the nodes are freed with their slabs
    **/
   void clear() noexcept {
-    if (this->height == 0) {
-      return;
-    }
-
-    if (this->height == 1) {
-      static_cast<leaf_node*>(this->root)->clear();
-      Allocator{}.deallocate(this->root);
-
-      this->root = nullptr;
-      this->size = this->height = 0;
-      return;
-    }
-
-    auto* node = static_cast<inner_node*>(this->root);
-    if (this->height == 2) {
-      node->destroy_leaf_children();
-      Allocator{}.deallocate(node);
-
-      this->root = nullptr;
-      this->size = this->height = 0;
-      return;
-    }
-
-    // State based deletion, DFS on the right side
-    usize h = this->height;
-    while (true) {
-      // Inner node containing leaf nodes
-      if (h == 2) {
-        node->destroy_leaf_children();
-
-        node = node->get_parent();
-        node->destroy_last_child();
-
-        ++h;
-        continue;
-      }
-
-      // If the inner node has children, traverse the last child
-      if (node->get_size() > -1) {
-        node = static_cast<inner_node*>(node->back_child());
-        --h;
-
-        continue;
-      }
-
-      // The inner node doesn't have any more children so delete the node
-      if (node->get_parent() != nullptr) {
-        node = node->get_parent();
-        node->destroy_last_child();
-        ++h;
-        continue;
-      }
-
-      // This is the root node
-      Allocator{}.deallocate(this->root);
-      break;
+    // NOTE: Releasing the slabs does not run the destructors of the nodes
+    if constexpr (!std::is_trivially_destructible_v<Value>) {
+      this->destroy_leaves();
     }
+    this->leaf_pool.release();
+    this->inner_pool.release();
 
     this->root = nullptr;
     this->size = this->height = 0;
@@ -464,6 +434,61 @@ public:
     return this->insert_impl<Value&&>(key, std::move(value));
   }
 
+  /**
+   * Replaces the contents of the bptree with `n` keys in ascending order and
+   *   their values. The leaves are packed to `fill` of a node and linked in
+   *   one pass, then each inner level is built from the one below it, so no
+   *   node is ever split. If an error happens, the bptree is left empty.
+   *
+   * @errors
+   *  - error_codes::INVALID_ARGUMENT - keys are not strictly ascending or
+   *      fill is not in (0, 1]
+   *  - bad allocation in creating the nodes
+   *  - bad allocation in copying the values
+   **/
+  [[nodiscard]] error_code build_from_sorted(
+      const Key* keys, const Value* values, usize n,
+      f32 fill = BPTREE_FILL_FACTOR
+  ) noexcept {
+    if (!(fill > 0.0F && fill <= 1.0F)) {
+      return error_codes::INVALID_ARGUMENT;
+    }
+
+    for (usize i = 1U; i < n; ++i) {
+      if (KeyCompare{}(keys[i - 1U], keys[i]) >= 0) {
+        return error_codes::INVALID_ARGUMENT;
+      }
+    }
+
+    this->clear();
+    if (n == 0U) {
+      return error_codes::OK;
+    }
+
+    // Nodes of the last built level and the smallest key under each of them
+    vector<void*> level{};
+    vector<Key> level_keys{};
+
+    error_code error =
+        this->build_leaves(keys, values, n, fill, level, level_keys);
+    usize height = 1U;
+    while (!error && level.get_size() > 1U) {
+      error = this->build_inner_level(fill, level, level_keys);
+      ++height;
+    }
+
+    // NOTE: The map was cleared, so the pools only hold the new nodes
+    if (error) {
+      this->clear();
+      return error;
+    }
+
+    this->root = level[0U];
+    this->size = n;
+    this->height = height;
+    return error_codes::OK;
+  }
+
   /*
    * Erases an element in the bptree
    * If the element does not exist in the bptree, then this will not change
@@ -767,6 +792,27 @@ public:
       leaf = leaf->get_next();
     }
   }
+
+  /**
+   * Checks the invariants of the tree: sorted keys, node sizes within the
+   *   degree, children within the keys of their parent, parent pointers, every
+   *   leaf at the same height and linked in order, and the element count
+   **/
+  [[nodiscard]] bool is_valid() const noexcept {
+    if (this->height == 0) {
+      return this->root == nullptr && this->size == 0U;
+    }
+
+    leaf_node* previous = nullptr;
+    usize count = 0U;
+    if (!this->is_valid_node(
+            this->root, this->height, nullptr, nullptr, nullptr, previous,
+            count
+        )) {
+      return false;
+    }
+    return previous->get_next() == nullptr && count == this->size;
+  }
 #endif
 
 private:
@@ -774,6 +820,75 @@ private:
   usize size = 0U;
   usize height = 0U;
 
+  node_pool<sizeof(leaf_node), Allocator> leaf_pool{};
+  node_pool<sizeof(inner_node), Allocator> inner_pool{};
+
+#if DS_TEST
+  /**
+   * Checks the subtree of `node`, its keys must be in [lower, upper), a null
+   *   bound is unbounded. `previous` is the last leaf checked. The first key
+   *   of a leaf must be its lower bound, remove relies on the separators
+   *   being keys that are still in the leaves.
+   **/
+  [[nodiscard]] bool is_valid_node(
+      void* node, usize height, inner_node* parent, const Key* lower,
+      const Key* upper, leaf_node*& previous, usize& count
+  ) const noexcept {
+    bool is_root = parent == nullptr;
+    if (height == 1) {
+      auto* leaf = static_cast<leaf_node*>(node);
+      if (leaf->get_parent() != parent ||
+          !is_valid_keys(leaf->get_keys(), leaf->get_size(), lower, upper) ||
+          leaf->get_size() > get_degree() ||
+          (is_root ? leaf->get_size() < 1
+                   : leaf->get_size() < this->min_leaf_children()) ||
+          (lower != nullptr && KeyCompare{}(leaf->front_key(), *lower) != 0) ||
+          leaf->get_prev() != previous ||
+          (previous != nullptr && previous->get_next() != leaf)) {
+        return false;
+      }
+
+      previous = leaf;
+      count += leaf->get_size();
+      return true;
+    }
+
+    auto* inner = static_cast<inner_node*>(node);
+    i32 size = inner->get_size();
+    if (inner->get_parent() != parent ||
+        !is_valid_keys(inner->get_keys(), size, lower, upper) ||
+        size > get_degree() ||
+        (is_root ? size < 1 : size < this->min_inner_children())) {
+      return false;
+    }
+
+    const Key* keys = inner->get_keys();
+    for (i32 i = 0; i <= size; ++i) {
+      if (!this->is_valid_node(
+              inner->get_children()[i], height - 1, inner,
+              i == 0 ? lower : keys + i - 1, i == size ? upper : keys + i,
+              previous, count
+          )) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  [[nodiscard]] static bool is_valid_keys(
+      const Key* keys, i32 size, const Key* lower, const Key* upper
+  ) noexcept {
+    for (i32 i = 0; i < size; ++i) {
+      if ((i > 0 && KeyCompare{}(keys[i - 1], keys[i]) >= 0) ||
+          (lower != nullptr && KeyCompare{}(keys[i], *lower) < 0) ||
+          (upper != nullptr && KeyCompare{}(keys[i], *upper) >= 0)) {
+        return false;
+      }
+    }
+    return true;
+  }
+#endif
+
   // === Lookup === //
 
   /**
@@ -794,6 +909,26 @@ private:
     return static_cast<leaf_node*>(node->find_smaller_child(key));
   }
 
+  /**
+   * Destroys the keys and values of every leaf, the nodes stay in the pool
+   **/
+  void destroy_leaves() noexcept {
+    if (this->height == 0) {
+      return;
+    }
+
+    void* node = this->root;
+    for (usize h = this->height; h > 1; --h) {
+      node = static_cast<inner_node*>(node)->front_child();
+    }
+
+    for (auto* leaf = static_cast<leaf_node*>(node); leaf != nullptr;) {
+      leaf_node* next = leaf->get_next();
+      leaf->destroy();
+      leaf = next;
+    }
+  }
+
   // === Insert Helpers === //
 
   /**
@@ -806,16 +941,14 @@ private:
    * @return inner_ptr
    **/
   [[nodiscard]] inner_node* create_inner_node(void* child) noexcept {
-    auto* node =
-        static_cast<inner_node*>(Allocator{}.allocate(sizeof(inner_node)));
+    auto* node = static_cast<inner_node*>(this->inner_pool.allocate());
     if (node == nullptr) {
       return nullptr;
     }
 
     new (node) inner_node{};
     if constexpr (std::is_class_v<Key>) {
-      new (node->get_keys())
-          Key[base_bptree_map<Derived, Key, Value, KeyCompare>::get_degree()];
+      new (node->get_keys()) Key[get_degree()];
     }
     node->get_children()[0] = child;
 
@@ -832,21 +965,18 @@ private:
    * @return leaf_node*
    **/
   [[nodiscard]] leaf_node* create_leaf_node() noexcept {
-    auto* node =
-        static_cast<leaf_node*>(Allocator{}.allocate(sizeof(leaf_node)));
+    auto* node = static_cast<leaf_node*>(this->leaf_pool.allocate());
     if (node == nullptr) {
       return nullptr;
     }
 
     new (node) leaf_node{};
     if constexpr (std::is_class_v<Key>) {
-      new (node->get_keys())
-          Key[base_bptree_map<Derived, Key, Value, KeyCompare>::get_degree()];
+      new (node->get_keys()) Key[get_degree()];
     }
 
     if constexpr (std::is_class_v<Value>) {
-      new (node->get_values())
-          Value[base_bptree_map<Derived, Key, Value, KeyCompare>::get_degree()];
+      new (node->get_values()) Value[get_degree()];
     }
 
     return node;
@@ -882,10 +1012,10 @@ private:
       if (parent == nullptr) {
         parent = this->create_inner_node(left_node);
         if (parent == nullptr) {
-          Allocator{}.deallocate(right_node);
+          this->inner_pool.deallocate(right_node);
           while (!stack.is_empty()) {
-            stack.pop();                         // Left node
-            Allocator{}.deallocate(stack.pop()); // Right node
+            stack.pop();                              // Left node
+            this->inner_pool.deallocate(stack.pop()); // Right node
           }
           return error_codes::BAD_ALLOCATION;
         }
@@ -948,7 +1078,7 @@ private:
     if (parent == nullptr) {
       parent = this->create_inner_node(left_leaf);
       if (parent == nullptr) {
-        Allocator{}.deallocate(right_leaf);
+        this->leaf_pool.deallocate(right_leaf);
         return error_codes::BAD_ALLOCATION;
       }
     }
@@ -965,9 +1095,9 @@ private:
     parent->insert(key, right_leaf);
     if (parent->get_size() == get_degree()) {
       if (auto error = this->split_inner_node(parent)) {
-        Allocator{}.deallocate(right_leaf);
+        this->leaf_pool.deallocate(right_leaf);
         if (parent->get_size() == 1) {
-          Allocator{}.deallocate(parent);
+          this->inner_pool.deallocate(parent);
           left_leaf->set_parent(nullptr);
         }
 
@@ -1061,6 +1191,123 @@ private:
     return error_codes::OK;
   }
 
+  // === Bulk Load Helpers === //
+
+  /**
+   * Number of elements in a node filled to `fill`, at most `max_size`
+   **/
+  [[nodiscard]] usize bulk_node_size(f32 fill, i32 max_size) const noexcept {
+    auto node_size = (i32)(fill * (f32)max_size + 0.5F);
+    if (node_size < this->min_leaf_children()) {
+      return this->min_leaf_children();
+    }
+    return node_size < max_size ? node_size : max_size;
+  }
+
+  /**
+   * Number of nodes holding `count` elements, about `node_size` each. Fewer
+   *   nodes are used if spreading the elements evenly would leave them under
+   *   the minimum.
+   **/
+  [[nodiscard]] usize
+  bulk_node_count(usize count, usize node_size) const noexcept {
+    usize node_count = (count + node_size - 1U) / node_size;
+    auto min_size = (usize)this->min_leaf_children();
+    if (node_count > 1U && count / node_count < min_size) {
+      node_count = count / min_size;
+    }
+    return node_count;
+  }
+
+  /**
+   * Fills the leaves with the sorted elements and links them in order
+   *
+   * @errors
+   *  - bad allocation in creating the nodes
+   *  - bad allocation in copying the values
+   **/
+  [[nodiscard]] error_code build_leaves(
+      const Key* keys, const Value* values, usize n, f32 fill,
+      vector<void*>& level, vector<Key>& level_keys
+  ) noexcept {
+    usize count =
+        this->bulk_node_count(n, this->bulk_node_size(fill, get_degree() - 1));
+    DS_TRY(level.reserve(count));
+    DS_TRY(level_keys.reserve(count));
+
+    leaf_node* previous = nullptr;
+    usize index = 0U;
+    for (usize i = 0U; i < count; ++i) {
+      leaf_node* leaf = this->create_leaf_node();
+      if (leaf == nullptr) {
+        return error_codes::BAD_ALLOCATION;
+      }
+
+      usize leaf_size = n / count + (i < n % count ? 1U : 0U);
+      DS_TRY(level.push(leaf));
+      DS_TRY(level_keys.push(Key{keys[index]}));
+
+      for (usize j = 0U; j < leaf_size; ++j, ++index) {
+        Value value{};
+        if constexpr (std::is_copy_assignable_v<Value>) {
+          value = values[index];
+        } else {
+          DS_TRY(value.copy(values[index]));
+        }
+        leaf->push(keys[index], std::move(value));
+      }
+
+      leaf->set_prev(previous);
+      if (previous != nullptr) {
+        previous->set_next(leaf);
+      }
+      previous = leaf;
+    }
+
+    return error_codes::OK;
+  }
+
+  /**
+   * Builds the inner nodes over `level` and replaces it with them
+   *
+   * @errors
+   *  - bad allocation in creating the nodes
+   **/
+  [[nodiscard]] error_code build_inner_level(
+      f32 fill, vector<void*>& level, vector<Key>& level_keys
+  ) noexcept {
+    usize children = level.get_size();
+    usize count = this->bulk_node_count(
+        children, this->bulk_node_size(fill, get_degree())
+    );
+
+    vector<void*> next{};
+    vector<Key> next_keys{};
+    DS_TRY(next.reserve(count));
+    DS_TRY(next_keys.reserve(count));
+
+    usize index = 0U;
+    for (usize i = 0U; i < count; ++i) {
+      inner_node* node = this->create_inner_node(level[index]);
+      if (node == nullptr) {
+        return error_codes::BAD_ALLOCATION;
+      }
+      DS_TRY(next.push(node));
+      DS_TRY(next_keys.push(Key{level_keys[index]}));
+
+      usize node_size = children / count + (i < children % count ? 1U : 0U);
+      for (usize j = 1U; j < node_size; ++j) {
+        node->push(level_keys[index + j], level[index + j]);
+      }
+      node->reparent_children();
+      index += node_size;
+    }
+
+    level = std::move(next);
+    level_keys = std::move(next_keys);
+    return error_codes::OK;
+  }
+
   // === Erase Helpers === //
 
   void remove_traversal(
@@ -1160,7 +1407,9 @@ private:
       }
 
       // Try to merge
-      grandparent->merge_children(index < sz ? index : sz - 1);
+      this->inner_pool.deallocate(
+          grandparent->merge_children(index < sz ? index : sz - 1)
+      );
 
       // Check if the sz suffices the rule, else merge again from the parent's
       // parent
@@ -1175,7 +1424,7 @@ private:
           static_cast<inner_node*>(this->root)->set_parent(nullptr);
 
           --this->height;
-          Allocator{}.deallocate(grandparent);
+          this->inner_pool.deallocate(grandparent);
         }
         break;
       }
@@ -1215,7 +1464,7 @@ private:
     if (!has_right_sibling) {
       leaf = leaf->get_prev();
     }
-    leaf->merge_right_sibling();
+    this->leaf_pool.deallocate(leaf->merge_right_sibling());
 
     inner_node* parent = leaf->get_parent();
     if (parent->get_size() >= this->min_inner_children()) {
@@ -1225,7 +1474,7 @@ private:
     if (parent == this->root) {
       if (parent->get_size() == 0) {
         this->root = parent->front_child();
-        Allocator{}.deallocate(parent);
+        this->inner_pool.deallocate(parent);
 
         static_cast<leaf_node*>(this->root)->set_parent(nullptr);
         static_cast<leaf_node*>(this->root)->set_next(nullptr);
@@ -1255,7 +1504,8 @@ private:
         --this->size;
         if (this->size == 0) {
           this->height = 0;
-          Allocator{}.deallocate(this->root);
+          this->leaf_pool.deallocate(this->root);
+          this->root = nullptr;
         }
 
         return;
@@ -1272,11 +1522,24 @@ private:
 
 namespace ds {
 
-template <typename Key, typename Value, typename KeyCompare = compare<Key>>
+/**
+ * B+ Tree map with nodes of `NodeSize` bytes of keys. Larger nodes make the
+ *   tree shallower, so a lookup follows fewer pointers, but each node takes
+ *   longer to search and to shift on insert. Sizes of 256 bytes, 1KiB and
+ *   4KiB are validated in the tests.
+ **/
+template <
+    typename Key, typename Value, typename KeyCompare = compare<Key>,
+    usize NodeSize = BPTREE_KEY_NODE_SIZE<Key>>
 class bptree_map
     : public base_bptree_map<
-          bptree_map<Key, Value, KeyCompare>, Key, Value, KeyCompare> {};
+          bptree_map<Key, Value, KeyCompare, NodeSize>, Key, Value, KeyCompare,
+          allocator<void>, bptree_degree<Key>(NodeSize)> {};
 
 } // namespace ds
 
+#ifndef DS_BPTREE_MAP_STRING_HPP
+#include "./bptree_map_string.hpp"
+#endif
+
 #endif
@@ -8,19 +8,286 @@
 #ifndef DS_BPTREE_MAP_NODE_HPP
 #define DS_BPTREE_MAP_NODE_HPP
 
+#include "./compare.hpp"
 #include "./types.hpp"
+#include <bit>
 #include <cstring>
 #include <type_traits>
 
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
 #ifdef DS_TEST
 #include <cstdio>
 #endif
 
+namespace ds {
+
+// === Node Size === //
+
+// Bytes of keys in a node by default, one cache line
+inline const usize BPTREE_NODE_SIZE = 64U;
+
+/**
+ * Node size of a bptree_map with `Key` keys when none is given, specialized
+ *   for keys that do not fit a cache line well
+ **/
+template <typename Key>
+inline constexpr usize BPTREE_KEY_NODE_SIZE = BPTREE_NODE_SIZE;
+
+// Share of a node filled by build_from_sorted, the rest is left for inserts
+inline const f32 BPTREE_FILL_FACTOR = 0.9F;
+
+/**
+ * Number of keys that fit in `node_size` bytes, rounded down to an even
+ *   number and at least 4. A split gives both halves the minimum number of
+ *   keys only at even degrees.
+ **/
+template <typename Key>
+[[nodiscard]] constexpr usize bptree_degree(usize node_size) noexcept {
+  usize degree = node_size / sizeof(Key) & ~(usize)1U;
+  return degree > 4U ? degree : 4U;
+}
+
+} // namespace ds
+
 namespace ds::_bptree_map {
 
+// === Key Search === //
+
+/**
+ * Checks if the keys can be searched with SIMD compares, only integer keys of
+ *   4 or 8 bytes that are ordered by the default compare
+ **/
+template <typename Key, typename KeyCompare>
+inline constexpr bool SIMD_SEARCH =
+    std::is_integral_v<Key> && (sizeof(Key) == 4U || sizeof(Key) == 8U) &&
+    std::is_same_v<KeyCompare, compare<Key>>;
+
+#ifdef __AVX2__
+
+/**
+ * Lanes of the keys in `vector` that are less than `key` (Upper: not larger),
+ *   one bit per lane
+ **/
+template <typename Key, bool Upper>
+[[nodiscard]] inline u32 simd_less_mask(__m256i vector, __m256i key) noexcept {
+  if constexpr (std::is_unsigned_v<Key>) {
+    // NOTE: AVX2 only compares signed lanes, flipping the sign bit keeps the
+    //   order
+    __m256i sign = sizeof(Key) == 4U ? _mm256_set1_epi32(INT32_MIN)
+                                     : _mm256_set1_epi64x(INT64_MIN);
+    vector = _mm256_xor_si256(vector, sign);
+    key = _mm256_xor_si256(key, sign);
+  }
+
+  __m256i mask{};
+  if constexpr (sizeof(Key) == 4U) {
+    mask = Upper ? _mm256_cmpgt_epi32(vector, key)
+                 : _mm256_cmpgt_epi32(key, vector);
+  } else {
+    mask = Upper ? _mm256_cmpgt_epi64(vector, key)
+                 : _mm256_cmpgt_epi64(key, vector);
+  }
+
+  u32 bits = sizeof(Key) == 4U
+                 ? (u32)_mm256_movemask_ps(_mm256_castsi256_ps(mask))
+                 : (u32)_mm256_movemask_pd(_mm256_castsi256_pd(mask));
+  // Upper compared the other way around, the lanes not larger than the key
+  return Upper ? ~bits & ((1U << (32U / sizeof(Key))) - 1U) : bits;
+}
+
+/**
+ * Counts the keys less than `key` (Upper: not larger) by comparing a whole
+ *   vector of keys at a time, there is no branch on the keys
+ **/
+template <typename Key, bool Upper>
+[[nodiscard]] inline i32
+simd_count_keys(const Key* keys, i32 size, Key key) noexcept {
+  const i32 LANES = 32U / sizeof(Key);
+  const bool WIDE = sizeof(Key) == 8U;
+  __m256i vector_key =
+      WIDE ? _mm256_set1_epi64x((i64)key) : _mm256_set1_epi32((i32)key);
+
+  const u32 FULL = (1U << LANES) - 1U;
+  i32 i = 0;
+  for (; i + LANES <= size; i += LANES) {
+    __m256i vector = _mm256_loadu_si256((const __m256i*)(keys + i));
+    u32 bits = simd_less_mask<Key, Upper>(vector, vector_key);
+    // NOTE: The keys are sorted, so the less than lanes are a prefix
+    if (bits != FULL) {
+      return i + std::popcount(bits);
+    }
+  }
+
+  // NOTE: The keys that do not fill a vector are compared one at a time, a
+  //   masked load is slow right after the stores of an insert
+  for (; i < size; ++i) {
+    if (Upper ? key < keys[i] : key <= keys[i]) {
+      break;
+    }
+  }
+  return i;
+}
+
+#endif
+
+// Nodes up to this size are searched with a linear scan
+inline const i32 BPTREE_LINEAR_SEARCH_SIZE = 16;
+
+// Bytes of keys the SIMD compares scan, larger nodes are halved down to it
+inline const usize BPTREE_SIMD_SEARCH_SIZE = 256U;
+
+/**
+ * Branchless halving of the keys while more than `limit` are left, `base` and
+ *   `size` become the part that holds the position of `key`. The halving does
+ *   not depend on the keys so its compare turns into a conditional move.
+ **/
+template <typename Key, typename KeyCompare, bool Upper>
+inline void narrow_keys(
+    const Key*& base, i32& size, const Key& key, i32 limit
+) noexcept {
+  while (size > limit) {
+    i32 half = size / 2;
+    isize comparison = KeyCompare{}(key, base[half]);
+    base = (Upper ? comparison >= 0 : comparison > 0) ? base + half : base;
+    size -= half;
+  }
+}
+
+/**
+ * Branchless binary search down to BPTREE_LINEAR_SEARCH_SIZE keys, then a
+ *   linear scan. The scan keeps its branch, a predicted branch lets the CPU
+ *   start loading the next node before the compares resolve.
+ *
+ * @return number of keys less than `key` (Upper: not larger)
+ **/
+template <typename Key, typename KeyCompare, bool Upper>
+[[nodiscard]] inline i32
+generic_count_keys(const Key* keys, i32 size, const Key& key) noexcept {
+  const Key* base = keys;
+  narrow_keys<Key, KeyCompare, Upper>(
+      base, size, key, BPTREE_LINEAR_SEARCH_SIZE
+  );
+
+  i32 index = 0;
+  for (; index < size; ++index) {
+    isize comparison = KeyCompare{}(key, base[index]);
+    if (Upper ? comparison < 0 : comparison <= 0) {
+      break;
+    }
+  }
+  return (i32)(base - keys) + index;
+}
+
+#ifdef __AVX2__
+
+/**
+ * simd_count_keys over the part of the keys left after halving them down to
+ *   BPTREE_SIMD_SEARCH_SIZE bytes
+ **/
+template <typename Key, typename KeyCompare, bool Upper>
+[[nodiscard]] inline i32
+simd_search_keys(const Key* keys, i32 size, const Key& key) noexcept {
+  const Key* base = keys;
+  narrow_keys<Key, KeyCompare, Upper>(
+      base, size, key, (i32)(BPTREE_SIMD_SEARCH_SIZE / sizeof(Key))
+  );
+  return (i32)(base - keys) + simd_count_keys<Key, Upper>(base, size, key);
+}
+
+#endif
+
+/**
+ * Index of the first key that is not less than `key`, `size` if every key is
+ *   less than it
+ **/
+template <typename Key, typename KeyCompare>
+[[nodiscard]] inline i32
+lower_bound(const Key* keys, i32 size, const Key& key) noexcept {
+#ifdef __AVX2__
+  if constexpr (SIMD_SEARCH<Key, KeyCompare>) {
+    return simd_search_keys<Key, KeyCompare, false>(keys, size, key);
+  }
+#endif
+  return generic_count_keys<Key, KeyCompare, false>(keys, size, key);
+}
+
+/**
+ * Index of the first key that is larger than `key`, `size` if no key is
+ *   larger than it
+ **/
+template <typename Key, typename KeyCompare>
+[[nodiscard]] inline i32
+upper_bound(const Key* keys, i32 size, const Key& key) noexcept {
+#ifdef __AVX2__
+  if constexpr (SIMD_SEARCH<Key, KeyCompare>) {
+    return simd_search_keys<Key, KeyCompare, true>(keys, size, key);
+  }
+#endif
+  return generic_count_keys<Key, KeyCompare, true>(keys, size, key);
+}
+
+/**
+ * Index of the key equal to `key`, -1 if there is none. Without SIMD the
+ *   keys are scanned for an equal key instead of the first key that is not
+ *   less, that branch is only taken once the key is found so it is rarely
+ *   mispredicted.
+ **/
+template <typename Key, typename KeyCompare>
+[[nodiscard]] inline i32
+find_key(const Key* keys, i32 size, const Key& key) noexcept {
+#ifdef __AVX2__
+  if constexpr (SIMD_SEARCH<Key, KeyCompare>) {
+    i32 index = simd_search_keys<Key, KeyCompare, false>(keys, size, key);
+    return index < size && keys[index] == key ? index : -1;
+  }
+#endif
+
+  const Key* base = keys;
+  narrow_keys<Key, KeyCompare, true>(
+      base, size, key, BPTREE_LINEAR_SEARCH_SIZE
+  );
+
+  for (i32 i = 0; i < size; ++i) {
+    if (KeyCompare{}(key, base[i]) == 0) {
+      return (i32)(base - keys) + i;
+    }
+  }
+  return -1;
+}
+
+/**
+ * Common prefix of the keys in a leaf, so it is kept once per leaf and the
+ *   searches can skip it. Keys without a prefix (the default) keep nothing,
+ *   see bptree_map_string.hpp for the string keys.
+ **/
+template <typename Key, typename KeyCompare> class leaf_prefix {
+public:
+  void update(const Key* /* keys */, i32 /* size */) noexcept {}
+
+  [[nodiscard]] i32
+  lower_bound(const Key* keys, i32 size, const Key& key) const noexcept {
+    return _bptree_map::lower_bound<Key, KeyCompare>(keys, size, key);
+  }
+
+  [[nodiscard]] i32
+  upper_bound(const Key* keys, i32 size, const Key& key) const noexcept {
+    return _bptree_map::upper_bound<Key, KeyCompare>(keys, size, key);
+  }
+
+  [[nodiscard]] i32
+  find_key(const Key* keys, i32 size, const Key& key) const noexcept {
+    return _bptree_map::find_key<Key, KeyCompare>(keys, size, key);
+  }
+};
+
+// === Nodes === //
+
 template <
     typename Derived, typename Key, typename Value, typename KeyCompare,
-    typename Allocator>
+    typename Allocator, usize Degree>
 class base_bptree_map;
 template <
     usize Degree, typename Key, typename Value, typename KeyCompare,
@@ -34,8 +301,7 @@ class _leaf_node {
 private:
   // === Definitions === //
   [[nodiscard]] static constexpr i32 get_degree() noexcept {
-    // Minimum degree is 3
-    return 64U / sizeof(Key) > 3U ? 64U / sizeof(Key) : 3U;
+    return (i32)Degree;
   }
 
 public:
@@ -204,30 +470,26 @@ public:
   // === Modifiers === //
 
   i32 insert(Key key, Value&& value) noexcept {
-    isize comparison = 0;
-
-    for (i32 i = 0; i < this->size; ++i) {
-      comparison = KeyCompare{}(key, this->keys[i]);
-
-      if (comparison == 0) {
-        this->values[i] = std::move(value);
-        return -1;
-      }
+    i32 index = this->search_lower(key);
+    if (index < this->size && KeyCompare{}(key, this->keys[index]) == 0) {
+      this->values[index] = std::move(value);
+      return -1;
+    }
 
-      if (comparison < 0) {
-        this->insert_indexed(i, key, std::move(value));
-        return i;
-      }
+    if (index == this->size) {
+      this->push(key, std::move(value));
+      return this->size;
     }
 
-    this->push(key, std::move(value));
-    return this->size;
+    this->insert_indexed(index, key, std::move(value));
+    return index;
   }
 
   void push(Key key, Value&& value) noexcept {
     this->keys[this->size] = key;
     this->values[this->size] = std::move(value);
     ++this->size;
+    this->prefix.update(this->keys, this->size);
   }
 
   void remove(i32 index) noexcept {
@@ -237,10 +499,17 @@ public:
     }
 
     --this->size;
+    // NOTE: Frees the removed value if it was the last, the slot is left
+    //   empty so clear only has to destroy the leaves still in the tree
+    if constexpr (std::is_class_v<Value>) {
+      this->values[this->size] = Value{};
+    }
+    this->prefix.update(this->keys, this->size);
   }
 
   void clear() noexcept {
     this->size = 0;
+    this->prefix.update(this->keys, this->size);
   }
 
   void redistribute(_leaf_node* other, i32 mid) noexcept {
@@ -248,6 +517,7 @@ public:
       other->push(this->keys[i], std::move(this->values[i]));
     }
     this->size = mid;
+    this->prefix.update(this->keys, this->size);
   }
 
   void borrow_right_sibling() noexcept {
@@ -278,7 +548,10 @@ public:
     }
   }
 
-  void merge_right_sibling() noexcept {
+  /**
+   * @return the emptied right sibling, to be freed by the map
+   **/
+  [[nodiscard]] _leaf_node* merge_right_sibling() noexcept {
     // Move all the children of the right child to this node
     _leaf_node* sibling = this->next;
     for (i32 i = 0; i < sibling->size; ++i) {
@@ -304,70 +577,36 @@ public:
       }
     }
 
-    // Merged to right sibling, delete this pointer
-    Allocator{}.deallocate(sibling);
+    return sibling;
   }
 
   // === Lookup === //
 
   [[nodiscard]] Value* get_value(Key key) noexcept {
-    for (i32 i = 0; i < this->size; ++i) {
-      if (KeyCompare{}(key, this->keys[i]) == 0) {
-        return this->values + i;
-      }
-    }
-
-    return nullptr;
+    i32 index = this->find_index(key);
+    return index > -1 ? this->values + index : nullptr;
   }
 
   [[nodiscard]] i32 find_index(Key key) const noexcept {
-    for (i32 i = 0U; i < this->size; ++i) {
-      if (KeyCompare{}(key, this->keys[i]) == 0) {
-        return i;
-      }
-    }
-
-    return -1;
+    return this->prefix.find_key(this->keys, this->size, key);
   }
 
   [[nodiscard]] i32 find_smaller_index(Key key) const noexcept {
-    for (i32 i = this->size - 1; i > -1; --i) {
-      if (KeyCompare{}(key, this->keys[i]) > 0) {
-        return i;
-      }
-    }
-
-    return -1;
+    return this->search_lower(key) - 1;
   }
 
   [[nodiscard]] i32 find_larger_index(Key key) const noexcept {
-    for (i32 i = 0; i < this->size; ++i) {
-      if (KeyCompare{}(key, this->keys[i]) < 0) {
-        return i;
-      }
-    }
-
-    return -1;
+    i32 index = this->search_upper(key);
+    return index < this->size ? index : -1;
   }
 
   [[nodiscard]] i32 find_not_smaller_index(Key key) const noexcept {
-    for (i32 i = 0; i < this->size; ++i) {
-      if (KeyCompare{}(key, this->keys[i]) <= 0) {
-        return i;
-      }
-    }
-
-    return -1;
+    i32 index = this->search_lower(key);
+    return index < this->size ? index : -1;
   }
 
   [[nodiscard]] i32 find_not_larger_index(Key key) const noexcept {
-    for (i32 i = this->size - 1; i > -1; --i) {
-      if (KeyCompare{}(key, this->keys[i]) >= 0) {
-        return i;
-      }
-    }
-
-    return -1;
+    return this->search_upper(key) - 1;
   }
 
 #ifdef DS_TEST
@@ -393,6 +632,16 @@ private:
 
   Value values[Degree]; // NOLINT
 
+  [[no_unique_address]] leaf_prefix<Key, KeyCompare> prefix{};
+
+  [[nodiscard]] i32 search_lower(const Key& key) const noexcept {
+    return this->prefix.lower_bound(this->keys, this->size, key);
+  }
+
+  [[nodiscard]] i32 search_upper(const Key& key) const noexcept {
+    return this->prefix.upper_bound(this->keys, this->size, key);
+  }
+
   void insert_indexed(i32 index, Key key, Value&& value) noexcept {
     if (index == this->size) {
       this->push(key, std::move(value));
@@ -410,6 +659,7 @@ private:
     this->keys[index] = key;
     this->values[index] = std::move(value);
     ++this->size;
+    this->prefix.update(this->keys, this->size);
   }
 };
 
@@ -451,18 +701,6 @@ public:
     this->size = 0;
   }
 
-  void destroy_last_child() noexcept {
-    // NOTE: inner_node & leaf_node parent are aligned
-    Allocator{}.deallocate(this->children[this->size]);
-    --this->size;
-  }
-
-  void destroy_leaf_children() noexcept {
-    for (i32 i = 0; i <= this->size; ++i) {
-      Allocator{}.deallocate(this->children[i]);
-    }
-  }
-
   // === Setters === //
 
   void set_parent(_inner_node* parent) noexcept {
@@ -497,23 +735,11 @@ public:
    * key passed, this returns the last child
    **/
   [[nodiscard]] void* find_smaller_child(Key key) const noexcept {
-    for (i32 i = 0; i < this->size; ++i) {
-      if (KeyCompare{}(key, this->keys[i]) < 0) {
-        return this->children[i];
-      }
-    }
-
-    return this->children[this->size];
+    return this->children[this->find_smaller_index(key)];
   }
 
   [[nodiscard]] i32 find_smaller_index(Key key) const noexcept {
-    for (i32 i = 0; i < this->size; ++i) {
-      if (KeyCompare{}(key, this->keys[i]) < 0) {
-        return i;
-      }
-    }
-
-    return this->size;
+    return upper_bound<Key, KeyCompare>(this->keys, this->size, key);
   }
 
   [[nodiscard]] Key at_key(i32 index) const noexcept {
@@ -539,14 +765,13 @@ public:
   // === Modifiers === //
 
   void insert(Key key, void* child) noexcept {
-    for (i32 i = 0; i < this->size; ++i) {
-      if (KeyCompare{}(key, this->keys[i]) < 0) {
-        this->insert_indexed(i, key, child);
-        return;
-      }
+    i32 index = this->find_smaller_index(key);
+    if (index == this->size) {
+      this->push(key, child);
+      return;
     }
 
-    this->push(key, child);
+    this->insert_indexed(index, key, child);
   }
 
   void push(Key key, void* child) noexcept {
@@ -648,8 +873,12 @@ public:
     left_uncle->pop();
   }
 
-  // Merges index and index + 1
-  void merge_children(i32 index) noexcept {
+  /**
+   * Merges index and index + 1
+   *
+   * @return the emptied child at index + 1, to be freed by the map
+   **/
+  [[nodiscard]] _inner_node* merge_children(i32 index) noexcept {
     auto* child = static_cast<_inner_node*>(this->children[index]);
     auto* sibling = static_cast<_inner_node*>(this->children[index + 1]);
 
@@ -669,8 +898,8 @@ public:
       child->push(sibling_keys[i], grandchild);
     }
 
-    Allocator{}.deallocate(sibling);
     this->remove(index);
+    return sibling;
   }
 
 #ifdef DS_TEST
@@ -0,0 +1,360 @@
+/*===============================*
+ * Author/s:
+ *  - silentrald
+ * Version: 1.0
+ * Created: 2024-10-17
+ *===============================*/
+
+#ifndef DS_BPTREE_MAP_STRING_HPP
+#define DS_BPTREE_MAP_STRING_HPP
+
+#include "./bptree_map.hpp"
+#include "./compare.hpp"
+#include "./string.hpp"
+#include "./string_view.hpp"
+#include "./types.hpp"
+#include "./vector.hpp"
+#include <cstring>
+#include <type_traits>
+
+namespace ds {
+
+// NOTE: The nodes keep 16 byte views, a cache line would only fit 4 of them
+template <> inline constexpr usize BPTREE_KEY_NODE_SIZE<string> = 256U;
+
+} // namespace ds
+
+namespace ds::_bptree_map {
+
+/**
+ * Common prefix of the string keys in a leaf. The keys are sorted, so the
+ *   prefix shared by every key is the one of the first and the last key. A
+ *   key that does not start with it sorts before or after the whole leaf, the
+ *   others are only compared past it.
+ **/
+template <> class leaf_prefix<string_view, compare<string>> {
+public:
+  void update(const string_view* keys, i32 size) noexcept {
+    if (size == 0) {
+      this->size = 0U;
+      return;
+    }
+
+    string_view first = keys[0];
+    string_view last = keys[size - 1];
+    usize length =
+        first.get_size() < last.get_size() ? first.get_size() : last.get_size();
+    usize i = 0U;
+    while (i < length && first[i] == last[i]) {
+      ++i;
+    }
+    this->size = i;
+  }
+
+  [[nodiscard]] i32 lower_bound(
+      const string_view* keys, i32 size, string_view key
+  ) const noexcept {
+    return this->count_keys<false>(keys, size, key);
+  }
+
+  [[nodiscard]] i32 upper_bound(
+      const string_view* keys, i32 size, string_view key
+  ) const noexcept {
+    return this->count_keys<true>(keys, size, key);
+  }
+
+  [[nodiscard]] i32
+  find_key(const string_view* keys, i32 size, string_view key) const noexcept {
+    i32 index = this->count_keys<false>(keys, size, key);
+    return index < size && keys[index] == key ? index : -1;
+  }
+
+#ifdef DS_TEST
+  [[nodiscard]] usize get_size() const noexcept {
+    return this->size;
+  }
+#endif
+
+private:
+  usize size = 0U;
+
+  /**
+   * @return number of keys less than `key` (Upper: not larger)
+   **/
+  template <bool Upper>
+  [[nodiscard]] i32 count_keys(
+      const string_view* keys, i32 size, string_view key
+  ) const noexcept {
+    usize prefix = this->size;
+    if (prefix > 0U) {
+      usize length = key.get_size() < prefix ? key.get_size() : prefix;
+      i32 comparison =
+          length > 0U ? std::memcmp(key.data(), keys[0].data(), length) : 0;
+      if (comparison > 0) {
+        return size;
+      }
+
+      // A key that is a part of the prefix is smaller than every key
+      if (comparison < 0 || length < prefix) {
+        return 0;
+      }
+    }
+
+    string_view rest{key.data() + prefix, key.get_size() - prefix};
+    i32 low = 0;
+    i32 high = size;
+    while (low < high) {
+      i32 mid = (low + high) / 2;
+      isize comparison = rest.compare(
+          string_view{keys[mid].data() + prefix, keys[mid].get_size() - prefix}
+      );
+      if (Upper ? comparison >= 0 : comparison > 0) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+    return low;
+  }
+};
+
+} // namespace ds::_bptree_map
+
+namespace ds {
+
+// === bptree_map with string key === //
+
+/**
+ * B+ Tree with string keys. The map owns one copy of each key and the nodes
+ *   keep views of it, a separator in an inner node views the same copy as the
+ *   first key of its leaf. The lookups take a string_view, so string and c8*
+ *   keys are compared in place.
+ *
+ * NOTE: KeyCompare compares string_views, like compare<string>
+ **/
+template <
+    typename Derived, typename Value, typename KeyCompare = compare<string>,
+    typename Allocator = allocator<void>,
+    usize Degree = bptree_degree<string_view>(BPTREE_KEY_NODE_SIZE<string>)>
+class string_key_bptree_map
+    : public base_bptree_map<
+          Derived, string_view, Value, KeyCompare, Allocator, Degree> {
+private:
+  using base = base_bptree_map<
+      Derived, string_view, Value, KeyCompare, Allocator, Degree>;
+
+  // NOTE: Remove keeps the separators equal to a key in a leaf only above 3
+  //   keys a node, a separator must never view a freed key
+  static_assert(Degree > 3U, "string bptree_map nodes need more than 3 keys");
+
+public:
+  string_key_bptree_map() noexcept = default;
+  string_key_bptree_map(const string_key_bptree_map&) = delete;
+  string_key_bptree_map& operator=(const string_key_bptree_map&) = delete;
+
+  // === Move === //
+
+  string_key_bptree_map(string_key_bptree_map&&) noexcept = default;
+
+  string_key_bptree_map& operator=(string_key_bptree_map&& rhs) noexcept {
+    if (&rhs == this) {
+      return *this;
+    }
+
+    this->clear();
+    base::operator=(std::move(rhs));
+    return *this;
+  }
+
+  // === Destructor === //
+
+  ~string_key_bptree_map() noexcept {
+    this->clear();
+  }
+
+  void destroy() noexcept {
+    this->clear();
+  }
+
+  /**
+   * Removes all elements in the map and frees their keys
+   **/
+  void clear() noexcept {
+    for (auto it = this->begin(); it != this->end(); ++it) {
+      free_key(it.key());
+    }
+    base::clear();
+  }
+
+  // === Modifiers === //
+
+  /**
+   * Inserts a value into the bptree, the key is copied only if it is new
+   *
+   * @errors
+   *  - bad allocation in creating the containers
+   *  - bad allocation in copying the key or value
+   **/
+  [[nodiscard]] error_code
+  insert(string_view key, const Value& value) noexcept {
+    return this->insert_key<const Value&>(key, value);
+  }
+
+  /**
+   * Inserts a value into the bptree, the key is copied only if it is new
+   *
+   * @errors
+   *  - bad allocation in creating the containers
+   *  - bad allocation in copying the key
+   **/
+  [[nodiscard]] error_code insert(string_view key, Value&& value) noexcept {
+    return this->insert_key<Value&&>(key, std::move(value));
+  }
+
+  /**
+   * Replaces the contents of the bptree with `n` keys (string, c8* or
+   *   string_view) in ascending order and their values, see
+   *   base_bptree_map::build_from_sorted
+   *
+   * @errors
+   *  - error_codes::INVALID_ARGUMENT - keys are not strictly ascending or
+   *      fill is not in (0, 1]
+   *  - bad allocation in creating the nodes
+   *  - bad allocation in copying the keys or values
+   **/
+  template <typename Key_>
+  [[nodiscard]] error_code build_from_sorted(
+      const Key_* keys, const Value* values, usize n,
+      f32 fill = BPTREE_FILL_FACTOR
+  ) noexcept {
+    // NOTE: Checked before the old keys are freed, the base checks it again
+    if (!(fill > 0.0F && fill <= 1.0F)) {
+      return error_codes::INVALID_ARGUMENT;
+    }
+
+    for (usize i = 1U; i < n; ++i) {
+      if (KeyCompare{}(string_view{keys[i - 1U]}, string_view{keys[i]}) >= 0) {
+        return error_codes::INVALID_ARGUMENT;
+      }
+    }
+
+    this->clear();
+
+    vector<string_view> copies{};
+    DS_TRY(copies.reserve(n));
+
+    error_code error = error_codes::OK;
+    for (usize i = 0U; i < n; ++i) {
+      auto copy = copy_key(string_view{keys[i]});
+      if (!copy) {
+        error = copy.error();
+        break;
+      }
+
+      error = copies.push(std::move(*copy));
+      if (error) {
+        free_key(*copy);
+        break;
+      }
+    }
+
+    if (!error) {
+      error = base::build_from_sorted(copies.get_data(), values, n, fill);
+    }
+
+    if (error) {
+      for (auto key : copies) {
+        free_key(key);
+      }
+    }
+    return error;
+  }
+
+  /*
+   * Erases an element in the bptree and frees its key
+   * If the element does not exist in the bptree, then this will not change
+   * anything in the bptree and no error is thrown
+   **/
+  void remove(string_view key) noexcept {
+    auto it = this->find(key);
+    if (it == this->end()) {
+      return;
+    }
+
+    // NOTE: The separators that viewed the key are replaced by the remove
+    string_view owned = it.key();
+    base::remove(key);
+    free_key(owned);
+  }
+
+private:
+  /**
+   * Replaces the value if the key is already in the map, otherwise inserts a
+   *   copy of the key, so an overwrite never allocates a key
+   **/
+  template <typename Value_>
+  [[nodiscard]] error_code insert_key(string_view key, Value_ value) noexcept {
+    Value* existing = base::operator[](key);
+    if (existing != nullptr) {
+      if constexpr (std::is_rvalue_reference_v<Value_>) {
+        *existing = std::move(value);
+      } else if constexpr (std::is_copy_assignable_v<Value>) {
+        *existing = value;
+      } else {
+        Value value_copy{};
+        DS_TRY(value_copy.copy(value));
+        *existing = std::move(value_copy);
+      }
+      return error_codes::OK;
+    }
+
+    auto copy = copy_key(key);
+    if (!copy) {
+      return copy.error();
+    }
+
+    error_code error = base::insert(*copy, std::forward<Value_>(value));
+    if (error) {
+      free_key(*copy);
+    }
+    return error;
+  }
+
+  /**
+   * Copies the characters of `key` with a null terminator, so the views of
+   *   the map can be used as a c string
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION
+   **/
+  [[nodiscard]] static expected<string_view, error_code>
+  copy_key(string_view key) noexcept {
+    usize size = key.get_size();
+    auto* data = static_cast<c8*>(Allocator{}.allocate(size + 1U));
+    if (data == nullptr) {
+      return unexpected<error_code>{error_codes::BAD_ALLOCATION};
+    }
+
+    if (size > 0U) {
+      std::memcpy(data, key.data(), size);
+    }
+    data[size] = '\0';
+    return string_view{data, size};
+  }
+
+  static void free_key(string_view key) noexcept {
+    Allocator{}.deallocate(const_cast<c8*>(key.data())); // NOLINT
+  }
+};
+
+// === bptree_map string specializations === //
+
+template <typename Value, typename KeyCompare, usize NodeSize>
+class bptree_map<string, Value, KeyCompare, NodeSize>
+    : public string_key_bptree_map<
+          bptree_map<string, Value, KeyCompare, NodeSize>, Value, KeyCompare,
+          allocator<void>, bptree_degree<string_view>(NodeSize)> {};
+
+} // namespace ds
+
+#endif
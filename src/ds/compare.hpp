@@ -9,6 +9,7 @@
 #define DS_COMPARE_HPP
 
 #include "./string.hpp"
+#include "./string_view.hpp"
 #include <cstring>
 
 // NOTE: Subtraction can overflow
@@ -86,6 +87,21 @@ public:
   operator()(const char* str1, const char* str2) const noexcept {
     return std::strcmp(str1, str2);
   }
+
+  [[nodiscard]] isize
+  operator()(string_view str1, const string& str2) const noexcept {
+    return str1.compare(str2);
+  }
+
+  [[nodiscard]] isize
+  operator()(const string& str1, string_view str2) const noexcept {
+    return string_view{str1}.compare(str2);
+  }
+
+  [[nodiscard]] isize
+  operator()(string_view str1, string_view str2) const noexcept {
+    return str1.compare(str2);
+  }
 };
 
 } // namespace ds
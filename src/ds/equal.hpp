@@ -9,6 +9,7 @@
 #define DS_EQUAL_HPP
 
 #include "./string.hpp"
+#include "./string_view.hpp"
 #include <cstring>
 
 namespace ds {
@@ -41,6 +42,35 @@ public:
   operator()(const char* str1, const char* str2) const noexcept {
     return std::strcmp(str1, str2) == 0;
   }
+
+  [[nodiscard]] bool
+  operator()(string_view str1, const string& str2) const noexcept {
+    return str1 == string_view{str2};
+  }
+
+  [[nodiscard]] bool
+  operator()(const string& str1, string_view str2) const noexcept {
+    return string_view{str1} == str2;
+  }
+};
+
+// NOTE: Compares the characters, not the address, same as hash<const c8*>
+template <> class equal<const c8*> {
+public:
+  [[nodiscard]] bool
+  operator()(const c8* str1, const c8* str2) const noexcept {
+    return std::strcmp(str1, str2) == 0;
+  }
+
+  [[nodiscard]] bool
+  operator()(string_view str1, const c8* str2) const noexcept {
+    return str1 == string_view{str2};
+  }
+
+  [[nodiscard]] bool
+  operator()(const c8* str1, string_view str2) const noexcept {
+    return string_view{str1} == str2;
+  }
 };
 
 } // namespace ds
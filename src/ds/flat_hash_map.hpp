@@ -0,0 +1,727 @@
+/*===============================*
+ * Author/s:
+ *  - silentrald
+ * Version: 1.0
+ * Created: 2024-10-16
+ *===============================*/
+
+#ifndef DS_FLAT_HASH_MAP_HPP
+#define DS_FLAT_HASH_MAP_HPP
+
+#include "./equal.hpp"
+#include "./flat_hash_map_iterator.hpp"
+#include "./hash.hpp"
+#include "./hash_policy.hpp"
+#include "types.hpp"
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#if !defined(DS_NO_SIMD) &&                                                    \
+    (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64))
+#define DS_FLAT_HASH_MAP_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace ds {
+
+inline const usize FLAT_HASHMAP_GROUP_SIZE = 16U;
+inline const usize FLAT_HASHMAP_MAX_SIZE = USIZE_MAX - 1U;
+// Control bytes, a full slot stores the top 7 bits of the hash (0 - 127)
+inline const u8 FLAT_HASHMAP_EMPTY = 0x80U;
+inline const u8 FLAT_HASHMAP_DELETED = 0xFEU;
+inline const u32 FLAT_HASHMAP_FINGERPRINT_BITS = 7U;
+
+/**
+ * 16 control bytes that are compared at the same time. Each match returns a
+ *   bitmask where the nth bit is set if the nth control byte matched.
+ **/
+class flat_hash_map_group {
+public:
+  explicit flat_hash_map_group(const u8* ctrl) noexcept
+#ifdef DS_FLAT_HASH_MAP_SSE2
+      : ctrl(_mm_load_si128((const __m128i*)ctrl)) { // NOLINT
+  }
+#else
+      : ctrl(ctrl) {
+  }
+#endif
+
+  /**
+   * Slots with the same fingerprint, the keys still need to be compared
+   **/
+  [[nodiscard]] u32 match(u8 fingerprint) const noexcept {
+#ifdef DS_FLAT_HASH_MAP_SSE2
+    return (u32)_mm_movemask_epi8(
+        _mm_cmpeq_epi8(this->ctrl, _mm_set1_epi8((i8)fingerprint))
+    );
+#else
+    return this->match_scalar(
+        [fingerprint](u8 byte) { return byte == fingerprint; }
+    );
+#endif
+  }
+
+  [[nodiscard]] u32 match_empty() const noexcept {
+#ifdef DS_FLAT_HASH_MAP_SSE2
+    return (u32)_mm_movemask_epi8(
+        _mm_cmpeq_epi8(this->ctrl, _mm_set1_epi8((i8)FLAT_HASHMAP_EMPTY))
+    );
+#else
+    return this->match_scalar([](u8 byte) { return byte == FLAT_HASHMAP_EMPTY; }
+    );
+#endif
+  }
+
+  /**
+   * NOTE: Only empty and deleted slots have their highest bit set
+   **/
+  [[nodiscard]] u32 match_empty_or_deleted() const noexcept {
+#ifdef DS_FLAT_HASH_MAP_SSE2
+    return (u32)_mm_movemask_epi8(this->ctrl);
+#else
+    return this->match_scalar([](u8 byte) { return (byte & 0x80U) != 0U; });
+#endif
+  }
+
+private:
+#ifdef DS_FLAT_HASH_MAP_SSE2
+  __m128i ctrl;
+#else
+  const u8* ctrl;
+
+  template <typename Predicate>
+  [[nodiscard]] u32 match_scalar(Predicate predicate) const noexcept {
+    u32 mask = 0U;
+    for (u32 i = 0U; i < FLAT_HASHMAP_GROUP_SIZE; ++i) {
+      mask |= (u32)predicate(this->ctrl[i]) << i;
+    }
+    return mask;
+  }
+#endif
+};
+
+/**
+ * Open addressing hash map that probes a group of 16 slots at a time.
+ *   Each slot has a control byte with 7 bits of the hash, so a whole group
+ *   of fingerprints is compared before any key is touched. Removed slots
+ *   leave a tombstone unless the group never overflowed.
+ *
+ * Has the same interface as hash_map so both can be swapped with a typedef.
+ *
+ * References:
+ *  https://abseil.io/about/design/swisstables
+ **/
+template <
+    typename Derived, typename Key, typename Value, typename Hash = hash<Key>,
+    typename KeyEqual = equal<Key>>
+class base_flat_hash_map {
+public:
+  friend Derived;
+
+  using key_type = Key;
+  using value_type = Value;
+
+  struct node_type {
+    Key key{};
+    Value value{};
+  };
+
+  using iterator = flat_hash_map_iterator<
+      base_flat_hash_map<Derived, Key, Value, Hash, KeyEqual>>;
+  using citerator = flat_hash_map_const_iterator<
+      base_flat_hash_map<Derived, Key, Value, Hash, KeyEqual>>;
+
+  base_flat_hash_map() noexcept = default;
+  base_flat_hash_map(const base_flat_hash_map&) = delete;
+  base_flat_hash_map& operator=(const base_flat_hash_map&) = delete;
+
+  // === Copy ===
+
+  /**
+   * Copies the hash map slot for slot, the control bytes and tombstones are
+   *   kept so no key is hashed or probed again. The hash map is cleared if a
+   *   key/value copy fails.
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION - bucket resize or key/value copy
+   *  - error_code from copy for key or value
+   **/
+  [[nodiscard]] error_code copy(const base_flat_hash_map& other) noexcept {
+    if (this == &other) {
+      return error_codes::OK;
+    }
+
+    if (other.bucket == nullptr) {
+      this->destroy();
+      return error_codes::OK;
+    }
+
+    this->clear();
+    if (this->capacity != other.capacity) {
+      this->destroy();
+      DS_TRY(this->allocate(other.capacity));
+    }
+
+    if constexpr (std::is_trivially_copyable_v<node_type>) {
+      std::memcpy(
+          this->bucket, other.bucket, sizeof(node_type) * other.capacity
+      );
+    } else {
+      for (usize i = 0U; i < other.capacity; ++i) {
+        if ((other.ctrl[i] & FLAT_HASHMAP_EMPTY) != 0U) {
+          continue;
+        }
+
+        error_code error = assign(this->bucket[i].key, other.bucket[i].key);
+        if (!error) {
+          error = assign(this->bucket[i].value, other.bucket[i].value);
+        }
+        if (error) {
+          this->clear();
+          return error;
+        }
+      }
+    }
+
+    std::memcpy(this->ctrl, other.ctrl, other.capacity);
+    this->size = other.size;
+    this->growth_left = other.growth_left;
+    return error_codes::OK;
+  }
+
+  // === Move ===
+
+  base_flat_hash_map(base_flat_hash_map&& other) noexcept
+      : bucket(other.bucket),
+        ctrl(other.ctrl),
+        size(other.size),
+        max_size(other.max_size),
+        capacity(other.capacity),
+        growth_left(other.growth_left),
+        shift(other.shift) {
+    other.bucket = nullptr;
+    other.ctrl = nullptr;
+    other.size = other.max_size = other.capacity = other.growth_left = 0U;
+  }
+
+  base_flat_hash_map& operator=(base_flat_hash_map&& rhs) noexcept {
+    if (this == &rhs) {
+      return *this;
+    }
+
+    this->destroy();
+    this->bucket = rhs.bucket;
+    this->ctrl = rhs.ctrl;
+    this->size = rhs.size;
+    this->max_size = rhs.max_size;
+    this->capacity = rhs.capacity;
+    this->growth_left = rhs.growth_left;
+    this->shift = rhs.shift;
+    rhs.bucket = nullptr;
+    rhs.ctrl = nullptr;
+    rhs.size = rhs.max_size = rhs.capacity = rhs.growth_left = 0U;
+
+    return *this;
+  }
+
+  // === Destructor === //
+
+  ~base_flat_hash_map() noexcept {
+    this->destroy();
+  }
+
+  /**
+   * Removes all elements
+   **/
+  void destroy() noexcept {
+    if (this->bucket == nullptr) {
+      return;
+    }
+
+    this->deallocate(this->bucket, this->capacity);
+    this->bucket = nullptr;
+    this->ctrl = nullptr;
+    this->size = this->max_size = this->capacity = this->growth_left = 0U;
+  }
+
+  /**
+   * Removes all elements without destroying each nodes.
+   **/
+  void clear() noexcept {
+    if (this->bucket == nullptr) {
+      return;
+    }
+
+    std::memset(this->ctrl, FLAT_HASHMAP_EMPTY, this->capacity);
+    this->size = 0U;
+    this->growth_left = this->max_size;
+  }
+
+  // === Iterator === //
+
+  /**
+   * Returns an iterator pointing at the first element found
+   *
+   * @return iterator
+   **/
+  [[nodiscard]] iterator begin() noexcept {
+    return iterator{this->bucket, this->ctrl, this->capacity};
+  }
+
+  /**
+   * Returns an iterator pointing at the first element found
+   *
+   * @return citerator
+   **/
+  [[nodiscard]] citerator cbegin() const noexcept {
+    return citerator{this->bucket, this->ctrl, this->capacity};
+  }
+
+  /**
+   * Returns an iterator pointing to null
+   *
+   * @return iterator
+   **/
+  [[nodiscard]] iterator end() noexcept {
+    return iterator{};
+  }
+
+  /**
+   * Returns an iterator pointing to null
+   *
+   * @return citerator
+   **/
+  [[nodiscard]] citerator cend() const noexcept {
+    return citerator{};
+  }
+
+  // === Capacity ===
+
+  /**
+   * Check if the hash node has no nodes
+   **/
+  [[nodiscard]] bool is_empty() const noexcept {
+    return this->size == 0;
+  }
+
+  /**
+   * Returns the current size of the hash map
+   **/
+  [[nodiscard]] usize get_size() const noexcept {
+    return this->size;
+  }
+
+  [[nodiscard]] usize get_capacity() const noexcept {
+    return this->capacity;
+  }
+
+  // === Modifiers ===
+
+  /**
+   * Inserts a value in the hash map
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION - bucket resize or key/value copy
+   *  - error_codes::CONTAINER_FULL - max limit of hash_map
+   *  - error_code from copy for key or value
+   **/
+  [[nodiscard]] error_code insert(const Key& key, const Value& value) noexcept {
+    return this->insert_impl<const Key&, const Value&>(key, value);
+  }
+
+  /**
+   * Inserts a value in the hash map
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION - bucket resize or key copy
+   *  - error_codes::CONTAINER_FULL - max limit of hash_map
+   *  - error_code from copy for key
+   **/
+  [[nodiscard]] error_code insert(const Key& key, Value&& value) noexcept {
+    return this->insert_impl<const Key&, Value&&>(key, std::move(value));
+  }
+
+  /**
+   * Inserts a value in the hash map
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION - bucket resize or value copy
+   *  - error_codes::CONTAINER_FULL - max limit of hash_map
+   *  - error_code from copy for value
+   **/
+  [[nodiscard]] error_code insert(Key&& key, const Value& value) noexcept {
+    return this->insert_impl<Key&&, const Value&>(std::move(key), value);
+  }
+
+  /**
+   * Inserts a value in the hash map
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION - bucket resize
+   *  - error_codes::CONTAINER_FULL - max limit of hash_map
+   **/
+  [[nodiscard]] error_code insert(Key&& key, Value&& value) noexcept {
+    return this->insert_impl<Key&&, Value&&>(std::move(key), std::move(value));
+  }
+
+  /**
+   * Removes a key/value pair in the hash map
+   * If no key was found, nothing will happen to the hash map
+   **/
+  void remove(const Key& key) noexcept {
+    this->erase_impl<const Key&>(key);
+  }
+
+  // === Accessors === //
+
+  /**
+   * Safe lookup - If the key was found then return the value else return an
+   *error
+   *
+   * @errors
+   *   - error_codes::NOT_FOUND
+   **/
+  [[nodiscard]] expected<Value*, error_code> at(const Key& key) noexcept {
+    node_type* node = this->find_node<const Key&>(key);
+    if (node == nullptr) {
+      return unexpected<error_code>{error_codes::NOT_FOUND};
+    }
+    return &node->value;
+  }
+
+  /**
+   * Unsafe lookup - if a value was found then return the value's address
+   *   else return nullptr
+   **/
+  [[nodiscard]] Value* operator[](const Key& key) noexcept {
+    node_type* node = this->find_node<const Key&>(key);
+    return node == nullptr ? nullptr : &node->value;
+  }
+
+  /**
+   * Unsafe lookup - if a value was found then return the value's address
+   *   else return nullptr
+   **/
+  [[nodiscard]] const Value* operator[](const Key& key) const noexcept {
+    node_type* node = this->find_node<const Key&>(key);
+    return node == nullptr ? nullptr : &node->value;
+  }
+
+  /**
+   * Checks if the value exists in the hash map
+   **/
+  [[nodiscard]] bool contains(const Key& key) const noexcept {
+    return this->find_node<const Key&>(key) != nullptr;
+  }
+
+protected:
+  node_type* bucket = nullptr;
+  // Control byte of each node, aligned to a group
+  u8* ctrl = nullptr;
+  usize size = 0U;
+  usize max_size = 0U;
+  usize capacity = 0U;
+  // Empty slots that can still be used before the bucket is rehashed
+  usize growth_left = 0U;
+  // Shift to get the group index from the hash
+  u32 shift = 0U;
+
+  // === Helpers === //
+
+  /**
+   * hash<T> is the identity for integers, so mix it before splitting it
+   **/
+  template <typename Key_>
+  [[nodiscard]] static usize calculate_hash(Key_ key) noexcept {
+    return Hash{}(key) * FIBONACCI_MULTIPLIER;
+  }
+
+  /**
+   * Top bits of the hash, stored in the control byte
+   **/
+  [[nodiscard]] static u8 get_fingerprint(usize hash) noexcept {
+    return (u8)(hash >> (sizeof(usize) * 8U - FLAT_HASHMAP_FINGERPRINT_BITS));
+  }
+
+  /**
+   * Bits below the fingerprint choose the first group to probe
+   **/
+  [[nodiscard]] usize get_group(usize hash) const noexcept {
+    return (hash >> this->shift) &
+           (this->capacity / FLAT_HASHMAP_GROUP_SIZE - 1U);
+  }
+
+  /**
+   * Returns the next group of the triangular probe sequence, this visits all
+   *   groups since the group count is a power of two
+   **/
+  [[nodiscard]] usize
+  get_next_group(usize group, usize probe) const noexcept {
+    return (group + probe) & (this->capacity / FLAT_HASHMAP_GROUP_SIZE - 1U);
+  }
+
+  template <typename Key_>
+  [[nodiscard]] node_type* find_node(Key_ key) const noexcept {
+    if (this->is_empty()) {
+      return nullptr;
+    }
+
+    return this->find_node_with_hash<Key_>(
+        key, this->calculate_hash<Key_>(key)
+    );
+  }
+
+  template <typename Key_>
+  [[nodiscard]] node_type*
+  find_node_with_hash(Key_ key, usize hash) const noexcept {
+    u8 fingerprint = get_fingerprint(hash);
+
+    // NOTE: No infinite loop since some slots will always be empty
+    for (usize group = this->get_group(hash), probe = 1U;; ++probe) {
+      usize start = group * FLAT_HASHMAP_GROUP_SIZE;
+      flat_hash_map_group control{this->ctrl + start};
+
+      for (u32 mask = control.match(fingerprint); mask != 0U;
+           mask &= mask - 1U) {
+        usize index = start + std::countr_zero(mask);
+        if (KeyEqual()(key, this->bucket[index].key)) {
+          return this->bucket + index;
+        }
+      }
+
+      // The key would have been placed in this group
+      if (control.match_empty() != 0U) {
+        return nullptr;
+      }
+
+      group = this->get_next_group(group, probe);
+    }
+  }
+
+  /**
+   * Finds the first empty or deleted slot in the probe sequence of the hash
+   **/
+  [[nodiscard]] usize find_free_slot(usize hash) const noexcept {
+    // NOTE: No infinite loop since some slots will always be empty
+    for (usize group = this->get_group(hash), probe = 1U;; ++probe) {
+      usize start = group * FLAT_HASHMAP_GROUP_SIZE;
+      u32 mask =
+          flat_hash_map_group{this->ctrl + start}.match_empty_or_deleted();
+      if (mask != 0U) {
+        return start + std::countr_zero(mask);
+      }
+
+      group = this->get_next_group(group, probe);
+    }
+  }
+
+  /**
+   * Places a node whose key is not in the hash map yet
+   **/
+  void place_node(node_type&& node, usize hash) noexcept {
+    usize index = this->find_free_slot(hash);
+    if (this->ctrl[index] == FLAT_HASHMAP_EMPTY) {
+      --this->growth_left;
+    }
+
+    this->bucket[index] = std::move(node);
+    this->ctrl[index] = get_fingerprint(hash);
+    ++this->size;
+  }
+
+  /**
+   * Copies or moves the source depending on its reference type
+   *
+   * @errors
+   *  - error_code from copy
+   **/
+  template <typename Target, typename Source>
+  [[nodiscard]] static error_code
+  assign(Target& target, Source&& source) noexcept {
+    if constexpr (std::is_rvalue_reference_v<Source&&> &&
+                  std::is_same_v<std::remove_cvref_t<Source>, Target>) {
+      target = std::move(source);
+    } else if constexpr (std::is_class_v<Target>) {
+      DS_TRY(target.copy(source));
+    } else {
+      target = source;
+    }
+    return error_codes::OK;
+  }
+
+  /**
+   * Inserts a value in the hash map, if the key already exists then only the
+   *   value is overwritten
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION - bucket resize or key/value copy
+   *  - error_codes::CONTAINER_FULL - max limit of hash_map
+   *  - error_code from copy for key or value
+   **/
+  template <typename Key_, typename Value_>
+  [[nodiscard]] error_code insert_impl(Key_ key, Value_ value) noexcept {
+    usize hash = this->calculate_hash<const Key_&>(key);
+
+    if (!this->is_empty()) {
+      node_type* node = this->find_node_with_hash<const Key_&>(key, hash);
+      if (node != nullptr) {
+        return assign(node->value, std::forward<Value_>(value));
+      }
+    }
+
+    DS_TRY(this->check_allocation());
+
+    node_type node{};
+    DS_TRY(assign(node.key, std::forward<Key_>(key)));
+    DS_TRY(assign(node.value, std::forward<Value_>(value)));
+    this->place_node(std::move(node), hash);
+
+    return error_codes::OK;
+  }
+
+  template <typename Key_> void erase_impl(Key_ key) noexcept {
+    node_type* node = this->find_node<Key_>(key);
+    if (node == nullptr) {
+      return;
+    }
+
+    usize index = node - this->bucket;
+    usize start = index - index % FLAT_HASHMAP_GROUP_SIZE;
+
+    // NOTE: A group with an empty slot was never full, so no probe sequence
+    //   went past it and the slot can be reused freely
+    if (flat_hash_map_group{this->ctrl + start}.match_empty() != 0U) {
+      this->ctrl[index] = FLAT_HASHMAP_EMPTY;
+      ++this->growth_left;
+    } else {
+      this->ctrl[index] = FLAT_HASHMAP_DELETED;
+    }
+    --this->size;
+  }
+
+  // === Memory === //
+
+  /**
+   * Check if the allocation can handle any mutation done to the hash map
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION
+   *  - error_codes::CONTAINER_FULL
+   **/
+  [[nodiscard]] error_code check_allocation() noexcept {
+    if (this->bucket == nullptr) {
+      return this->allocate(FLAT_HASHMAP_GROUP_SIZE);
+    }
+
+    if (this->size >= FLAT_HASHMAP_MAX_SIZE) {
+      return error_codes::CONTAINER_FULL;
+    }
+
+    if (this->growth_left > 0U) {
+      return error_codes::OK;
+    }
+
+    // Mostly tombstones, rehash to the same capacity to clear them
+    if (this->size < this->max_size / 2U) {
+      return this->reallocate(this->capacity);
+    }
+    return this->reallocate(this->capacity * 2U);
+  }
+
+  /**
+   * Allocates the bucket and the control bytes in a single block
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION
+   **/
+  [[nodiscard]] error_code allocate(usize new_capacity) noexcept {
+    // NOTE: The capacity is a multiple of the group size, so the control bytes
+    //   stay aligned for the group loads
+    auto* new_bucket = (node_type*)std::aligned_alloc( // NOLINT
+        FLAT_HASHMAP_GROUP_SIZE,
+        new_capacity * (sizeof(node_type) + sizeof(u8))
+    );
+    if (new_bucket == nullptr) {
+      return error_codes::BAD_ALLOCATION;
+    }
+
+    new (new_bucket) node_type[new_capacity];
+
+    this->bucket = new_bucket;
+    this->ctrl = (u8*)(new_bucket + new_capacity); // NOLINT
+    std::memset(this->ctrl, FLAT_HASHMAP_EMPTY, new_capacity);
+
+    // Max load factor of 7/8
+    this->capacity = new_capacity;
+    this->max_size = new_capacity - new_capacity / 8U;
+    this->growth_left = this->max_size - this->size;
+    this->shift = sizeof(usize) * 8U - FLAT_HASHMAP_FINGERPRINT_BITS -
+                  std::countr_zero(new_capacity / FLAT_HASHMAP_GROUP_SIZE);
+
+    return error_codes::OK;
+  }
+
+  /**
+   * Moves all the nodes to a new bucket
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION
+   **/
+  [[nodiscard]] error_code reallocate(usize new_capacity) noexcept {
+    node_type* prev_bucket = this->bucket;
+    u8* prev_ctrl = this->ctrl;
+    usize prev_capacity = this->capacity;
+
+    usize prev_size = this->size;
+
+    // NOTE: Every node is placed again, so start the growth from an empty map
+    this->size = 0U;
+    if (auto error = this->allocate(new_capacity)) {
+      this->size = prev_size;
+      return error;
+    }
+
+    for (usize i = 0U; i < prev_capacity; ++i) {
+      if ((prev_ctrl[i] & FLAT_HASHMAP_EMPTY) != 0U) {
+        continue;
+      }
+
+      usize hash = this->calculate_hash<const Key&>(prev_bucket[i].key);
+      this->place_node(std::move(prev_bucket[i]), hash);
+    }
+
+    this->deallocate(prev_bucket, prev_capacity);
+    return error_codes::OK;
+  }
+
+  void deallocate(node_type* prev_bucket, usize prev_capacity) noexcept {
+    if constexpr (std::is_class_v<Key> || std::is_class_v<Value>) {
+      for (usize i = 0U; i < prev_capacity; ++i) {
+        prev_bucket[i].~node_type();
+      }
+    }
+
+    std::free(prev_bucket); // NOLINT
+  }
+};
+
+// === flat_hash_map definition === //
+
+template <
+    typename Key, typename Value, typename Hash = hash<Key>,
+    typename KeyEqual = equal<Key>>
+class flat_hash_map
+    : public base_flat_hash_map<
+          flat_hash_map<Key, Value, Hash, KeyEqual>, Key, Value, Hash,
+          KeyEqual> {};
+
+} // namespace ds
+
+#ifndef DS_FLAT_HASH_MAP_STRING_HPP
+#include "./flat_hash_map_string.hpp"
+#endif
+
+#endif
@@ -0,0 +1,171 @@
+/*===============================*
+ * Author/s:
+ *  - silentrald
+ * Version: 1.0
+ * Created: 2024-10-16
+ *===============================*/
+
+#ifndef DS_FLAT_HASH_MAP_ITERATOR_HPP
+#define DS_FLAT_HASH_MAP_ITERATOR_HPP
+
+#include "./types.hpp"
+
+namespace ds {
+
+template <typename FlatHashMap> class flat_hash_map_iterator {
+public:
+  using key_type = typename FlatHashMap::key_type;
+  using value_type = typename FlatHashMap::value_type;
+  using node_type = typename FlatHashMap::node_type;
+
+private:
+  node_type* bucket = nullptr;
+  // NOTE: Empty and deleted control bytes have their highest bit set
+  const u8* ctrl = nullptr;
+  node_type* ptr = nullptr;
+  usize index = 0;
+  usize capacity = 0;
+
+  void find_element(usize start) noexcept {
+    // Find a bucket with a node
+    for (this->index = start; this->index < this->capacity; ++this->index) {
+      if ((this->ctrl[this->index] & 0x80U) == 0U) {
+        this->ptr = this->bucket + this->index;
+        return;
+      }
+    }
+
+    // No more nodes
+    this->ptr = nullptr;
+  }
+
+public:
+  flat_hash_map_iterator() noexcept = default;
+
+  explicit flat_hash_map_iterator(
+      node_type* bucket, const u8* ctrl, usize capacity
+  ) noexcept
+      : bucket(bucket), ctrl(ctrl), capacity(capacity) {
+    this->find_element(0U);
+  }
+
+  // === Element Access === //
+  const key_type& key() const noexcept {
+    return this->ptr->key;
+  }
+
+  value_type& value() noexcept {
+    return this->ptr->value;
+  }
+
+  const value_type& value() const noexcept {
+    return this->ptr->value;
+  }
+
+  // === Iterator Move === //
+  flat_hash_map_iterator& operator++() noexcept {
+    if (this->ptr != nullptr) {
+      this->find_element(this->index + 1U);
+    }
+    return *this;
+  }
+
+  const flat_hash_map_iterator operator++(i32) noexcept {
+    flat_hash_map_iterator tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  // === Non-member Operator === //
+  friend bool operator==(
+      const flat_hash_map_iterator& lhs, const flat_hash_map_iterator& rhs
+  ) noexcept {
+    return lhs.ptr == rhs.ptr;
+  }
+
+  friend bool operator!=(
+      const flat_hash_map_iterator& lhs, const flat_hash_map_iterator& rhs
+  ) noexcept {
+    return lhs.ptr != rhs.ptr;
+  }
+};
+
+template <typename FlatHashMap> class flat_hash_map_const_iterator {
+public:
+  using key_type = typename FlatHashMap::key_type;
+  using value_type = typename FlatHashMap::value_type;
+  using node_type = typename FlatHashMap::node_type;
+
+private:
+  const node_type* bucket = nullptr;
+  // NOTE: Empty and deleted control bytes have their highest bit set
+  const u8* ctrl = nullptr;
+  const node_type* ptr = nullptr;
+  usize index = 0;
+  usize capacity = 0;
+
+  void find_element(usize start) noexcept {
+    // Find a bucket with a node
+    for (this->index = start; this->index < this->capacity; ++this->index) {
+      if ((this->ctrl[this->index] & 0x80U) == 0U) {
+        this->ptr = this->bucket + this->index;
+        return;
+      }
+    }
+
+    // No more nodes
+    this->ptr = nullptr;
+  }
+
+public:
+  flat_hash_map_const_iterator() noexcept = default;
+
+  explicit flat_hash_map_const_iterator(
+      const node_type* bucket, const u8* ctrl, usize capacity
+  ) noexcept
+      : bucket(bucket), ctrl(ctrl), capacity(capacity) {
+    this->find_element(0U);
+  }
+
+  // === Element Access === //
+  const key_type& key() const noexcept {
+    return this->ptr->key;
+  }
+
+  const value_type& value() const noexcept {
+    return this->ptr->value;
+  }
+
+  // === Iterator Move === //
+  flat_hash_map_const_iterator& operator++() noexcept {
+    if (this->ptr != nullptr) {
+      this->find_element(this->index + 1U);
+    }
+    return *this;
+  }
+
+  const flat_hash_map_const_iterator operator++(i32) noexcept {
+    flat_hash_map_const_iterator tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  // === Non-member Operator === //
+  friend bool operator==(
+      const flat_hash_map_const_iterator& lhs,
+      const flat_hash_map_const_iterator& rhs
+  ) noexcept {
+    return lhs.ptr == rhs.ptr;
+  }
+
+  friend bool operator!=(
+      const flat_hash_map_const_iterator& lhs,
+      const flat_hash_map_const_iterator& rhs
+  ) noexcept {
+    return lhs.ptr != rhs.ptr;
+  }
+};
+
+} // namespace ds
+
+#endif
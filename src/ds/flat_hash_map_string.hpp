@@ -0,0 +1,392 @@
+/*===============================*
+ * Author/s:
+ *  - silentrald
+ * Version: 1.0
+ * Created: 2024-10-16
+ *===============================*/
+
+#ifndef DS_FLAT_HASH_MAP_STRING_HPP
+#define DS_FLAT_HASH_MAP_STRING_HPP
+
+#include "./flat_hash_map.hpp"
+#include "./string.hpp"
+#include "./string_view.hpp"
+#include "types.hpp"
+
+namespace ds {
+
+// === flat_hash_map with string key/value === //
+
+template <
+    typename Derived, typename Hash = hash<string>,
+    typename KeyEqual = equal<string>>
+class string_flat_hash_map
+    : public base_flat_hash_map<Derived, string, string, Hash, KeyEqual> {
+public:
+  using base = base_flat_hash_map<Derived, string, string, Hash, KeyEqual>;
+  using base::at;
+  using base::contains;
+  using base::insert;
+  using base::remove;
+  using base::operator[];
+
+  // === Accessors === //
+
+  /**
+   * Safe lookup - If the key was found then return the value
+   *   else return an error
+   *
+   * @errors
+   *   - error_codes::NOT_FOUND
+   **/
+  [[nodiscard]] expected<string*, error_code> at(const c8* key) noexcept {
+    auto* node = this->template find_node<const c8*>(key);
+    if (node == nullptr) {
+      return unexpected<error_code>{error_codes::NOT_FOUND};
+    }
+    return &node->value;
+  }
+
+  /**
+   * Unsafe lookup - if a value was found then return the value's address
+   *   else return nullptr
+   **/
+  [[nodiscard]] string* operator[](const c8* key) noexcept {
+    auto* node = this->template find_node<const c8*>(key);
+    return node == nullptr ? nullptr : &node->value;
+  }
+
+  /**
+   * Unsafe lookup - if a value was found then return the value's address
+   *   else return nullptr
+   **/
+  [[nodiscard]] const string* operator[](const c8* key) const noexcept {
+    auto* node = this->template find_node<const c8*>(key);
+    return node == nullptr ? nullptr : &node->value;
+  }
+
+  /**
+   * Checks if the value exists in the hash map
+   **/
+  [[nodiscard]] bool contains(const c8* key) const noexcept {
+    return this->template find_node<const c8*>(key) != nullptr;
+  }
+
+  /**
+   * Safe lookup with a view of the key, no copy of the key is made
+   *
+   * @errors
+   *   - error_codes::NOT_FOUND
+   **/
+  [[nodiscard]] expected<string*, error_code> at(string_view key) noexcept {
+    auto* node = this->template find_node<string_view>(key);
+    if (node == nullptr) {
+      return unexpected<error_code>{error_codes::NOT_FOUND};
+    }
+    return &node->value;
+  }
+
+  /**
+   * Unsafe lookup with a view of the key - if a value was found then return
+   *   the value's address else return nullptr
+   **/
+  [[nodiscard]] string* operator[](string_view key) noexcept {
+    auto* node = this->template find_node<string_view>(key);
+    return node == nullptr ? nullptr : &node->value;
+  }
+
+  /**
+   * Unsafe lookup with a view of the key - if a value was found then return
+   *   the value's address else return nullptr
+   **/
+  [[nodiscard]] const string* operator[](string_view key) const noexcept {
+    auto* node = this->template find_node<string_view>(key);
+    return node == nullptr ? nullptr : &node->value;
+  }
+
+  /**
+   * Checks if the key of the view exists in the hash map
+   **/
+  [[nodiscard]] bool contains(string_view key) const noexcept {
+    return this->template find_node<string_view>(key) != nullptr;
+  }
+
+  // === Mutations === //
+
+  /**
+   * Inserts a value in the hash map
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION - bucket resize or value copy
+   *  - error_codes::CONTAINER_FULL - max limit of hash_map
+   *  - error_code from copy for key or value
+   **/
+  [[nodiscard]] error_code insert(const c8* key, const string& value) noexcept {
+    return this->template insert_impl<const c8*, const string&>(key, value);
+  }
+
+  /**
+   * Inserts a value in the hash map
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION - bucket resize or value copy
+   *  - error_codes::CONTAINER_FULL - max limit of hash_map
+   *  - error_code from copy for key
+   **/
+  [[nodiscard]] error_code insert(const c8* key, string&& value) noexcept {
+    return this->template insert_impl<const c8*, string&&>(
+        key, std::move(value)
+    );
+  }
+
+  /**
+   * Inserts a value in the hash map
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION - bucket resize or value copy
+   *  - error_codes::CONTAINER_FULL - max limit of hash_map
+   *  - error_code from copy for key or value
+   **/
+  [[nodiscard]] error_code insert(const string& key, const c8* value) noexcept {
+    return this->template insert_impl<const string&, const c8*>(key, value);
+  }
+
+  /**
+   * Inserts a value in the hash map
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION - bucket resize or value copy
+   *  - error_codes::CONTAINER_FULL - max limit of hash_map
+   *  - error_code from copy for value
+   **/
+  [[nodiscard]] error_code insert(string&& key, const c8* value) noexcept {
+    return this->template insert_impl<string&&, const c8*>(
+        std::move(key), value
+    );
+  }
+
+  /**
+   * Inserts a value in the hash map
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION - bucket resize or value copy
+   *  - error_codes::CONTAINER_FULL - max limit of hash_map
+   *  - error_code from copy for key or value
+   **/
+  [[nodiscard]] error_code insert(const c8* key, const c8* value) noexcept {
+    return this->template insert_impl<const c8*, const c8*>(key, value);
+  }
+
+  /**
+   * Removes a key/value pair in the hash map
+   * If no key was found, nothing will happen to the hash map
+   **/
+  void remove(const c8* key) noexcept {
+    this->template erase_impl<const c8*>(key);
+  }
+
+  /**
+   * Removes the key/value pair of the view's key in the hash map
+   * If no key was found, nothing will happen to the hash map
+   **/
+  void remove(string_view key) noexcept {
+    this->template erase_impl<string_view>(key);
+  }
+};
+
+template <
+    typename Derived, typename Value, typename Hash = hash<string>,
+    typename KeyEqual = equal<string>>
+class string_key_flat_hash_map
+    : public base_flat_hash_map<Derived, string, Value, Hash, KeyEqual> {
+public:
+  using base = base_flat_hash_map<Derived, string, Value, Hash, KeyEqual>;
+  using base::at;
+  using base::contains;
+  using base::insert;
+  using base::remove;
+  using base::operator[];
+
+  // === Accessors === //
+
+  /**
+   * Safe lookup - If the key was found then return the value
+   *   else return an error
+   *
+   * @errors
+   *   - error_codes::NOT_FOUND
+   **/
+  [[nodiscard]] expected<Value*, error_code> at(const c8* key) noexcept {
+    auto* node = this->template find_node<const c8*>(key);
+    if (node == nullptr) {
+      return unexpected<error_code>{error_codes::NOT_FOUND};
+    }
+    return &node->value;
+  }
+
+  /**
+   * Unsafe lookup - if a value was found then return the value's address
+   *   else return nullptr
+   **/
+  [[nodiscard]] Value* operator[](const c8* key) noexcept {
+    auto* node = this->template find_node<const c8*>(key);
+    return node == nullptr ? nullptr : &node->value;
+  }
+
+  /**
+   * Unsafe lookup - if a value was found then return the value's address
+   *   else return nullptr
+   **/
+  [[nodiscard]] const Value* operator[](const c8* key) const noexcept {
+    auto* node = this->template find_node<const c8*>(key);
+    return node == nullptr ? nullptr : &node->value;
+  }
+
+  /**
+   * Checks if the value exists in the hash map
+   **/
+  [[nodiscard]] bool contains(const c8* key) const noexcept {
+    return this->template find_node<const c8*>(key) != nullptr;
+  }
+
+  /**
+   * Safe lookup with a view of the key, no copy of the key is made
+   *
+   * @errors
+   *   - error_codes::NOT_FOUND
+   **/
+  [[nodiscard]] expected<Value*, error_code> at(string_view key) noexcept {
+    auto* node = this->template find_node<string_view>(key);
+    if (node == nullptr) {
+      return unexpected<error_code>{error_codes::NOT_FOUND};
+    }
+    return &node->value;
+  }
+
+  /**
+   * Unsafe lookup with a view of the key - if a value was found then return
+   *   the value's address else return nullptr
+   **/
+  [[nodiscard]] Value* operator[](string_view key) noexcept {
+    auto* node = this->template find_node<string_view>(key);
+    return node == nullptr ? nullptr : &node->value;
+  }
+
+  /**
+   * Unsafe lookup with a view of the key - if a value was found then return
+   *   the value's address else return nullptr
+   **/
+  [[nodiscard]] const Value* operator[](string_view key) const noexcept {
+    auto* node = this->template find_node<string_view>(key);
+    return node == nullptr ? nullptr : &node->value;
+  }
+
+  /**
+   * Checks if the key of the view exists in the hash map
+   **/
+  [[nodiscard]] bool contains(string_view key) const noexcept {
+    return this->template find_node<string_view>(key) != nullptr;
+  }
+
+  // === Mutations === //
+
+  /**
+   * Inserts a value in the hash map
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION - bucket resize or key/value copy
+   *  - error_codes::CONTAINER_FULL - max limit of hash_map
+   *  - error_code from copy for key or value
+   **/
+  [[nodiscard]] error_code insert(const c8* key, const Value& value) noexcept {
+    return this->template insert_impl<const c8*, const Value&>(key, value);
+  }
+
+  /**
+   * Inserts a value in the hash map
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION - bucket resize or key copy
+   *  - error_codes::CONTAINER_FULL - max limit of hash_map
+   *  - error_code from copy for key
+   **/
+  [[nodiscard]] error_code insert(const c8* key, Value&& value) noexcept {
+    return this->template insert_impl<const c8*, Value&&>(
+        key, std::move(value)
+    );
+  }
+
+  /**
+   * Removes a key/value pair in the hash map
+   * If no key was found, nothing will happen to the hash map
+   **/
+  void remove(const c8* key) noexcept {
+    this->template erase_impl<const c8*>(key);
+  }
+
+  /**
+   * Removes the key/value pair of the view's key in the hash map
+   * If no key was found, nothing will happen to the hash map
+   **/
+  void remove(string_view key) noexcept {
+    this->template erase_impl<string_view>(key);
+  }
+};
+
+template <
+    typename Derived, typename Key, typename Hash = hash<Key>,
+    typename KeyEqual = equal<Key>>
+class string_value_flat_hash_map
+    : public base_flat_hash_map<Derived, Key, string, Hash, KeyEqual> {
+public:
+  using base = base_flat_hash_map<Derived, Key, string, Hash, KeyEqual>;
+  using base::insert;
+
+  // === Mutations === //
+
+  /**
+   * Inserts a value in the hash map
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION - bucket resize or key/value copy
+   *  - error_codes::CONTAINER_FULL - max limit of hash_map
+   *  - error_code from copy for key or value
+   **/
+  [[nodiscard]] error_code insert(const Key& key, const c8* value) noexcept {
+    return this->template insert_impl<const Key&, const c8*>(key, value);
+  }
+
+  /**
+   * Inserts a value in the hash map
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION - bucket resize or value copy
+   *  - error_codes::CONTAINER_FULL - max limit of hash_map
+   *  - error_code from copy for value
+   **/
+  [[nodiscard]] error_code insert(Key&& key, const c8* value) noexcept {
+    return this->template insert_impl<Key&&, const c8*>(std::move(key), value);
+  }
+};
+
+// === flat_hash_map string specializations === //
+
+template <typename Hash, typename KeyEqual>
+class flat_hash_map<string, string, Hash, KeyEqual>
+    : public string_flat_hash_map<
+          flat_hash_map<string, string, Hash, KeyEqual>, Hash, KeyEqual> {};
+
+template <typename Value, typename Hash, typename KeyEqual>
+class flat_hash_map<string, Value, Hash, KeyEqual>
+    : public string_key_flat_hash_map<
+          flat_hash_map<string, Value, Hash, KeyEqual>, Value, Hash,
+          KeyEqual> {};
+
+template <typename Key, typename Hash, typename KeyEqual>
+class flat_hash_map<Key, string, Hash, KeyEqual>
+    : public string_value_flat_hash_map<
+          flat_hash_map<Key, string, Hash, KeyEqual>, Key, Hash, KeyEqual> {};
+
+} // namespace ds
+
+#endif
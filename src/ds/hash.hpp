@@ -9,14 +9,26 @@
 #define DS_HASH_HPP
 
 #include "../hash/murmur3.h"
+#include "../hash/wyhash.h"
 #include "./string.hpp"
+#include "./string_view.hpp"
 #include "types.hpp"
+#include <chrono>
+#include <concepts>
 #include <cstring>
 
+#ifdef __linux__
+#include <sys/random.h>
+#endif
+
 namespace ds {
 
-// TODO: Configurable in cmake
+// NOTE: Set with -DDS_HASH_SEED=<value> in cmake
+#ifdef DS_HASH_SEED
+const i32 SEED = DS_HASH_SEED;
+#else
 const i32 SEED = 69'420;
+#endif
 
 template <typename T> class hash {
 public:
@@ -25,19 +37,309 @@ public:
   }
 };
 
-template <> class hash<string> {
+// === Integer Mixers === //
+
+/**
+ * Murmur3 64 bit finalizer, every input bit affects every output bit
+ **/
+[[nodiscard]] constexpr u64 fmix64(u64 key) noexcept {
+  key ^= key >> 33U;
+  key *= 0xFF51AFD7ED558CCDULL;
+  key ^= key >> 33U;
+  key *= 0xC4CEB9FE1A85EC53ULL;
+  key ^= key >> 33U;
+  return key;
+}
+
+/**
+ * Splitmix64 finalizer, also maps 0 to a non zero hash
+ **/
+[[nodiscard]] constexpr u64 splitmix64(u64 key) noexcept {
+  key += 0x9E3779B97F4A7C15ULL;
+  key = (key ^ (key >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+  key = (key ^ (key >> 27U)) * 0x94D049BB133111EBULL;
+  return key ^ (key >> 31U);
+}
+
+/**
+ * Integer hash with the fmix64 finalizer, every bit of the key affects every
+ *   bit of the hash. hash<T> is the identity, which is fine under prime modulo
+ *   and the fibonacci multiply of power_of_two_hash_policy, but not for code
+ *   that masks the low bits of the hash or combines several hashes.
+ **/
+template <typename T> class fmix_hash {
 public:
-  usize operator()(const string& data) const noexcept {
-    usize out = 0U;
-    MurmurHash3_x86_32(data.c_str(), data.get_size(), SEED, &out);
-    return out;
+  usize operator()(T data) const noexcept {
+    return (usize)fmix64((u64)data);
   }
+};
+
+/**
+ * Integer hash with the splitmix64 finalizer, see fmix_hash
+ **/
+template <typename T> class splitmix_hash {
+public:
+  usize operator()(T data) const noexcept {
+    return (usize)splitmix64((u64)data);
+  }
+};
+
+// === Seeds === //
+
+/**
+ * Random seed from the OS, falls back to mixing the clock and a stack address
+ *   if getrandom is not available or fails
+ **/
+[[nodiscard]] inline usize random_seed() noexcept {
+  usize seed = 0U;
+#ifdef __linux__
+  if (getrandom(&seed, sizeof(seed), GRND_NONBLOCK) == sizeof(seed)) {
+    return seed;
+  }
+#endif
+  auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+  return (usize)splitmix64((u64)now ^ (u64)reinterpret_cast<usize>(&seed));
+}
 
-  usize operator()(const c8* data) const noexcept {
-    usize out = 0U;
-    MurmurHash3_x86_32(data, std::strlen(data), SEED, &out);
+/**
+ * Seed of the hashes. With DS_HASH_RANDOM_SEED a random seed is drawn once
+ *   per process, so colliding keys cannot be crafted ahead of time, otherwise
+ *   it is SEED and the hashes are the same on every run.
+ **/
+[[nodiscard]] inline usize get_hash_seed() noexcept {
+#ifdef DS_HASH_RANDOM_SEED
+  static const usize seed = random_seed();
+  return seed;
+#else
+  return (usize)SEED;
+#endif
+}
+
+// === Composite Keys === //
+
+/**
+ * Mixes the hash of the next field into `seed`. The order of the fields
+ *   matters, combining (a, b) and (b, a) gives different hashes.
+ **/
+[[nodiscard]] constexpr usize hash_combine(usize seed, usize value) noexcept {
+  return (usize)splitmix64((u64)seed ^ (u64)value);
+}
+
+/**
+ * Hashes a key made of several fields, each field is hashed with `Hash` and
+ *   combined into the running state
+ *
+ *   usize operator()(const key& data) const noexcept {
+ *     return hasher{}.add(data.tenant_id).add(data.object_id).finish();
+ *   }
+ **/
+class hasher {
+public:
+  hasher() noexcept = default;
+  explicit hasher(usize seed) noexcept : state(seed) {}
+
+  template <typename T, typename Hash = hash<T>>
+  hasher& add(const T& value) noexcept {
+    this->state = hash_combine(this->state, Hash{}(value));
+    return *this;
+  }
+
+  hasher& add_bytes(const void* data, usize size) noexcept;
+
+  [[nodiscard]] usize finish() const noexcept {
+    return this->state;
+  }
+
+private:
+  usize state = get_hash_seed();
+};
+
+/**
+ * 64 bit wyhash of the bytes, strong and fast on short keys
+ **/
+inline u64 wyhash_bytes(
+    const void* data, usize size, usize seed = get_hash_seed()
+) noexcept {
+  return wyhash64(data, size, (u64)seed);
+}
+
+/**
+ * 32 bit murmur3 (x86_32) of the bytes, only the low 32 bits of the seed are
+ *   used
+ **/
+inline u32 murmur3_bytes(
+    const void* data, usize size, usize seed = get_hash_seed()
+) noexcept {
+  u32 out = 0U;
+  MurmurHash3_x86_32(data, (i32)size, (u32)seed, &out);
+  return out;
+}
+
+/**
+ * Hash of the bytes used by the string hashes, wyhash unless DS_HASH_MURMUR3
+ *   is defined
+ **/
+inline usize hash_bytes(
+    const void* data, usize size, usize seed = get_hash_seed()
+) noexcept {
+#ifdef DS_HASH_MURMUR3
+  return murmur3_bytes(data, size, seed);
+#else
+  return (usize)wyhash_bytes(data, size, seed);
+#endif
+}
+
+/**
+ * Streaming murmur3 (x86_32), the fragments of a key are fed one at a time
+ *   and give the same hash as murmur3_bytes over the concatenated bytes, so
+ *   the key never has to be copied into a single buffer
+ **/
+class murmur3_hasher {
+public:
+  murmur3_hasher() noexcept {
+    MurmurHash3_x86_32_init(&this->state, (u32)get_hash_seed());
+  }
+
+  murmur3_hasher& update(const void* data, usize size) noexcept {
+    MurmurHash3_x86_32_update(&this->state, data, (i32)size);
+    return *this;
+  }
+
+  murmur3_hasher& update(string_view data) noexcept {
+    return this->update(data.data(), data.get_size());
+  }
+
+  [[nodiscard]] u32 finish() const noexcept {
+    u32 out = 0U;
+    MurmurHash3_x86_32_final(&this->state, &out);
     return out;
   }
+
+private:
+  MurmurHash3_x86_32_state state{};
+};
+
+inline hasher& hasher::add_bytes(const void* data, usize size) noexcept {
+  this->state = hash_combine(this->state, hash_bytes(data, size));
+  return *this;
+}
+
+// Number of keys hash_bytes_batch hashes together
+inline const usize HASH_BATCH_SIZE = 16U;
+
+/**
+ * hash_bytes of `count` buffers. With DS_HASH_MURMUR3 the buffers are hashed
+ *   in SIMD lanes, wyhash has no vector form (it needs a 64x64 bit multiply)
+ *   so its buffers are hashed one after the other.
+ **/
+inline void hash_bytes_batch(
+    const void* const* data, const usize* sizes, usize count, usize* out,
+    usize seed = get_hash_seed()
+) noexcept {
+#ifdef DS_HASH_MURMUR3
+  i32 lens[HASH_BATCH_SIZE];   // NOLINT
+  u32 hashes[HASH_BATCH_SIZE]; // NOLINT
+  for (usize start = 0U; start < count; start += HASH_BATCH_SIZE) {
+    usize batch =
+        count - start < HASH_BATCH_SIZE ? count - start : HASH_BATCH_SIZE;
+    for (usize i = 0U; i < batch; ++i) {
+      lens[i] = (i32)sizes[start + i];
+    }
+    MurmurHash3_x86_32_batch(data + start, lens, (i32)batch, (u32)seed, hashes);
+    for (usize i = 0U; i < batch; ++i) {
+      out[start + i] = hashes[i];
+    }
+  }
+#else
+  for (usize i = 0U; i < count; ++i) {
+    out[i] = hash_bytes(data[i], sizes[i], seed);
+  }
+#endif
+}
+
+/**
+ * Checks if `Hash` can hash a batch of keys with
+ *   hash_batch(const Key*, usize, usize*), used by the batched lookups
+ **/
+template <typename Hash, typename Key>
+concept batch_hash = requires(const Key* keys, usize* out) {
+  Hash{}.hash_batch(keys, usize{}, out);
+};
+
+/**
+ * Checks if `Hash` takes the seed as a second argument, used by the tables
+ *   that draw their own seed
+ **/
+template <typename Hash, typename Key>
+concept seeded_hash = requires(const Key& key) {
+  { Hash{}(key, usize{}) } -> std::same_as<usize>;
+};
+
+template <> class hash<string> {
+public:
+  usize
+  operator()(const string& data, usize seed = get_hash_seed()) const noexcept {
+    return hash_bytes(data.c_str(), data.get_size(), seed);
+  }
+
+  usize
+  operator()(const c8* data, usize seed = get_hash_seed()) const noexcept {
+    return hash_bytes(data, std::strlen(data), seed);
+  }
+
+  usize
+  operator()(string_view data, usize seed = get_hash_seed()) const noexcept {
+    return hash_bytes(data.data(), data.get_size(), seed);
+  }
+
+  /**
+   * Hashes `count` keys together, same hashes as hashing them one at a time
+   **/
+  void hash_batch(const string* keys, usize count, usize* out) const noexcept {
+    const void* data[HASH_BATCH_SIZE]; // NOLINT
+    usize sizes[HASH_BATCH_SIZE];      // NOLINT
+    for (usize start = 0U; start < count; start += HASH_BATCH_SIZE) {
+      usize batch =
+          count - start < HASH_BATCH_SIZE ? count - start : HASH_BATCH_SIZE;
+      for (usize i = 0U; i < batch; ++i) {
+        data[i] = keys[start + i].c_str();
+        sizes[i] = keys[start + i].get_size();
+      }
+      hash_bytes_batch(data, sizes, batch, out + start);
+    }
+  }
+
+  /**
+   * Hashes `count` keys together, same hashes as hashing them one at a time
+   **/
+  void
+  hash_batch(const c8* const* keys, usize count, usize* out) const noexcept {
+    const void* data[HASH_BATCH_SIZE]; // NOLINT
+    usize sizes[HASH_BATCH_SIZE];      // NOLINT
+    for (usize start = 0U; start < count; start += HASH_BATCH_SIZE) {
+      usize batch =
+          count - start < HASH_BATCH_SIZE ? count - start : HASH_BATCH_SIZE;
+      for (usize i = 0U; i < batch; ++i) {
+        data[i] = keys[start + i];
+        sizes[i] = std::strlen(keys[start + i]);
+      }
+      hash_bytes_batch(data, sizes, batch, out + start);
+    }
+  }
+};
+
+// NOTE: Hashes the characters, not the address
+template <> class hash<const c8*> {
+public:
+  usize
+  operator()(const c8* data, usize seed = get_hash_seed()) const noexcept {
+    return hash_bytes(data, std::strlen(data), seed);
+  }
+
+  usize
+  operator()(string_view data, usize seed = get_hash_seed()) const noexcept {
+    return hash_bytes(data.data(), data.get_size(), seed);
+  }
 };
 
 } // namespace ds
@@ -8,12 +8,16 @@
 #ifndef DS_HASH_MAP_HPP
 #define DS_HASH_MAP_HPP
 
+#include "./allocator.hpp"
 #include "./hash.hpp"
 #include "./hash_map_iterator.hpp"
+#include "./hash_policy.hpp"
+#include "./hash_stats.hpp"
+#include "./prefetch.hpp"
 #include "ds/equal.hpp"
-#include "prime.hpp"
 #include "types.hpp"
 #include <cstdlib>
+#include <cstring>
 #include <type_traits>
 #include <utility>
 
@@ -23,10 +27,17 @@
 
 namespace ds {
 
+// Default max load factor, can be changed per hash map with set_max_load_factor
 inline const f32 HASHMAP_LOAD_FACTOR = 0.9F;
 inline const usize HASHMAP_MAX_SIZE = USIZE_MAX - 1U;
-// Indicator if the node is empty or not
-inline const usize HASHMAP_EMPTY_VALUE = USIZE_MAX;
+// Indicator if the node is empty or not, distances are stored with an offset of
+// 1 so an empty slot can be marked with 0
+inline const u8 HASHMAP_EMPTY_VALUE = 0U;
+// Largest distance that fits in a byte, the distance of a node further away
+// from its hashed index is saturated to it and computed again from its hash
+inline const u8 HASHMAP_MAX_DISTANCE = UINT8_MAX;
+// Number of keys hashed and prefetched together by the batched lookups
+inline const usize HASHMAP_BATCH_SIZE = 16U;
 
 /**
  * Hash map / table implementation with robin hood hashing
@@ -35,10 +46,17 @@ inline const usize HASHMAP_EMPTY_VALUE = USIZE_MAX;
  * References:
  *  https://programming.guide/robin-hood-hashing.html
  *  https://codecapsule.com/2013/11/17/robin-hood-hashing-backward-shift-deletion
+ *
+ * Policy decides the bucket capacities and how hashes map to an index, see
+ *   hash_policy.hpp
+ *
+ * Allocator provides the memory of the bucket, the nodes and the distances of
+ *   a bucket are a single allocation
  **/
 template <
     typename Derived, typename Key, typename Value, typename Hash = hash<Key>,
-    typename KeyEqual = equal<Key>>
+    typename KeyEqual = equal<Key>, typename Policy = prime_hash_policy,
+    typename Allocator = allocator<void>>
 class base_hash_map {
 public:
   friend Derived;
@@ -46,26 +64,18 @@ public:
   using key_type = Key;
   using value_type = Value;
 
-  // NOTE: Check if key/value pair can be separated with distance
-  //   Since accessing is faster caching
+  // NOTE: The probe distance of each node is stored in a separate byte array
+  //   so small keys and values do not pay for the alignment padding
   struct node_type {
     Key key{};
     Value value{};
-    usize distance = HASHMAP_EMPTY_VALUE;
-
-    void to_empty() noexcept {
-      this->distance = HASHMAP_EMPTY_VALUE;
-    }
-
-    [[nodiscard]] bool is_node_empty() const noexcept {
-      return this->distance == HASHMAP_EMPTY_VALUE;
-    }
+    [[no_unique_address]] stored_hash<Policy::STORE_HASH> hash{};
   };
 
-  using iterator =
-      hash_map_iterator<base_hash_map<Derived, Key, Value, Hash, KeyEqual>>;
+  using iterator = hash_map_iterator<
+      base_hash_map<Derived, Key, Value, Hash, KeyEqual, Policy, Allocator>>;
   using citerator = hash_map_const_iterator<
-      base_hash_map<Derived, Key, Value, Hash, KeyEqual>>;
+      base_hash_map<Derived, Key, Value, Hash, KeyEqual, Policy, Allocator>>;
 
   base_hash_map() noexcept = default;
   base_hash_map(const base_hash_map&) = delete;
@@ -74,23 +84,85 @@ public:
   // === Copy ===
 
   /**
-   * Copies the hash map
+   * Copies the hash map slot for slot, the bucket layout is kept so no key is
+   *   hashed or probed again. Trivially copyable nodes are copied with a
+   *   single memcpy. The hash map is cleared if a key/value copy fails.
    *
    * @errors
-   *  - error_codes::BAD_ALLOCATION - bucket resize
+   *  - error_codes::BAD_ALLOCATION - bucket resize or key/value copy
+   *  - error_code from copy for key or value
    **/
   [[nodiscard]] error_code copy(const base_hash_map& other) noexcept {
-    return error_codes::NOT_IMPLEMENTED;
+    if (this == &other) {
+      return error_codes::OK;
+    }
+
+    this->max_load_factor = other.max_load_factor;
+    if (other.bucket == nullptr) {
+      this->destroy();
+      return error_codes::OK;
+    }
+
+    this->clear();
+    // NOTE: The slots are copied as is, so they need the same seed
+    this->seed = other.seed;
+    if (this->capacity != other.capacity) {
+      this->destroy();
+      DS_TRY(this->allocate(other.capacity));
+    }
+
+    if (auto error = copy_bucket(this->bucket, other.bucket, other.capacity)) {
+      this->clear();
+      return error;
+    }
+    this->size = other.size;
+    this->max_size = other.max_size;
+
+    // Nodes not migrated yet are copied in their own bucket
+    if (other.is_migrating()) {
+      node_type* new_bucket = allocate_bucket(other.old_capacity);
+      if (new_bucket == nullptr) {
+        this->clear();
+        return error_codes::BAD_ALLOCATION;
+      }
+
+      if (auto error =
+              copy_bucket(new_bucket, other.old_bucket, other.old_capacity)) {
+        this->deallocate(new_bucket, other.old_capacity);
+        this->clear();
+        return error;
+      }
+
+      this->old_bucket = new_bucket;
+      this->old_distances = (u8*)(new_bucket + other.old_capacity); // NOLINT
+      this->old_capacity = other.old_capacity;
+      this->migrate_index = other.migrate_index;
+    }
+
+    return error_codes::OK;
   }
 
   // === Move ===
 
   base_hash_map(base_hash_map&& other) noexcept
       : bucket(other.bucket),
+        distances(other.distances),
         size(other.size),
         max_size(other.max_size),
-        capacity(other.capacity) {
+        capacity(other.capacity),
+        max_load_factor(other.max_load_factor),
+        seed(other.seed),
+        old_bucket(other.old_bucket),
+        old_distances(other.old_distances),
+        old_capacity(other.old_capacity),
+        migrate_index(other.migrate_index) {
+#ifdef DS_HASH_STATS
+    this->counters = other.counters;
+#endif
     other.bucket = nullptr;
+    other.distances = nullptr;
+    other.old_bucket = nullptr;
+    other.old_distances = nullptr;
   }
 
   base_hash_map& operator=(base_hash_map&& rhs) noexcept {
@@ -99,10 +171,23 @@ public:
     }
 
     this->bucket = rhs.bucket;
+    this->distances = rhs.distances;
     this->size = rhs.size;
     this->max_size = rhs.max_size;
     this->capacity = rhs.capacity;
+    this->max_load_factor = rhs.max_load_factor;
+    this->seed = rhs.seed;
+    this->old_bucket = rhs.old_bucket;
+    this->old_distances = rhs.old_distances;
+    this->old_capacity = rhs.old_capacity;
+    this->migrate_index = rhs.migrate_index;
+#ifdef DS_HASH_STATS
+    this->counters = rhs.counters;
+#endif
     rhs.bucket = nullptr;
+    rhs.distances = nullptr;
+    rhs.old_bucket = nullptr;
+    rhs.old_distances = nullptr;
 
     return *this;
   }
@@ -121,28 +206,24 @@ public:
       return;
     }
 
-    if constexpr (std::is_class_v<Key> || std::is_class_v<Value>) {
-      for (usize i = 0; i < this->capacity; ++i) {
-        this->bucket[i].~node_type();
-      }
-    }
-
-    std::free(this->bucket); // NOLINT
+    this->release_old_bucket();
+    this->deallocate(this->bucket, this->capacity);
     this->bucket = nullptr;
+    this->distances = nullptr;
     this->size = this->max_size = this->capacity = 0U;
   }
 
   /**
-   * Removes all elements without destroying each nodes.
+   * Removes all elements while keeping the bucket
    **/
   void clear() noexcept {
     if (this->bucket == nullptr) {
       return;
     }
 
-    for (usize i = 0; i < this->capacity; ++i) {
-      this->bucket[i].to_empty();
-    }
+    this->release_old_bucket();
+    destroy_nodes(this->bucket, this->distances, this->capacity);
+    std::memset(this->distances, HASHMAP_EMPTY_VALUE, this->capacity);
     this->size = 0U;
   }
 
@@ -154,7 +235,10 @@ public:
    * @return iterator
    **/
   [[nodiscard]] iterator begin() noexcept {
-    return iterator{this->bucket, this->capacity};
+    return iterator{
+        this->bucket, this->distances, this->capacity, this->old_bucket,
+        this->old_distances, this->old_capacity
+    };
   }
 
   /**
@@ -163,7 +247,10 @@ public:
    * @return citerator
    **/
   [[nodiscard]] citerator cbegin() const noexcept {
-    return citerator{this->bucket, this->capacity};
+    return citerator{
+        this->bucket, this->distances, this->capacity, this->old_bucket,
+        this->old_distances, this->old_capacity
+    };
   }
 
   /**
@@ -204,6 +291,90 @@ public:
     return this->capacity;
   }
 
+  [[nodiscard]] f32 get_max_load_factor() const noexcept {
+    return this->max_load_factor;
+  }
+
+  /**
+   * Sets the ratio of keys to bucket slots the hash map grows at, lower values
+   *   trade memory for shorter probe sequences. Rehashes right away if the
+   *   keys no longer fit the bucket.
+   *
+   * @errors
+   *  - error_codes::INVALID_ARGUMENT - load factor is not between 0 and 1
+   *  - error_codes::BAD_ALLOCATION
+   **/
+  [[nodiscard]] error_code set_max_load_factor(f32 load_factor) noexcept {
+    if (!(load_factor > 0.0F && load_factor < 1.0F)) {
+      return error_codes::INVALID_ARGUMENT;
+    }
+
+    this->max_load_factor = load_factor;
+    if (this->bucket == nullptr) {
+      return error_codes::OK;
+    }
+
+    this->max_size = this->get_max_size(this->capacity);
+    return this->reserve(this->size);
+  }
+
+  /**
+   * Grows the bucket once so `count` keys can be inserted without any rehash,
+   *   does nothing if they already fit
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION
+   *  - error_codes::CONTAINER_FULL - max limit of hash_map
+   **/
+  [[nodiscard]] error_code reserve(usize count) noexcept {
+    if (count > HASHMAP_MAX_SIZE) {
+      return error_codes::CONTAINER_FULL;
+    }
+
+    usize new_capacity = this->get_fitting_capacity(count);
+    if (new_capacity == 0U) {
+      return error_codes::BAD_ALLOCATION;
+    }
+
+    if (this->bucket == nullptr) {
+      return this->allocate(new_capacity);
+    }
+
+    // Only a single bucket can be reallocated
+    if (this->is_migrating()) {
+      this->migrate(USIZE_MAX);
+    }
+
+    if (count <= this->max_size) {
+      return error_codes::OK;
+    }
+    return this->reallocate(new_capacity);
+  }
+
+  /**
+   * Rehashes to the smallest capacity that fits the keys, the bucket is freed
+   *   if the hash map is empty
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION
+   **/
+  [[nodiscard]] error_code shrink_to_fit() noexcept {
+    if (this->is_empty()) {
+      this->destroy();
+      return error_codes::OK;
+    }
+
+    if (this->is_migrating()) {
+      this->migrate(USIZE_MAX);
+    }
+
+    usize new_capacity = this->get_fitting_capacity(this->size);
+    if (new_capacity >= this->capacity) {
+      return error_codes::OK;
+    }
+    return this->reallocate(new_capacity);
+  }
+
   // === Modifiers ===
 
   /**
@@ -253,6 +424,66 @@ public:
     return this->insert_impl(std::move(key), std::move(value));
   }
 
+  /**
+   * Inserts a value constructed from `args` only if the key does not exist
+   *   yet, nothing is constructed or copied if the key is already present
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION - bucket resize or key copy
+   *  - error_codes::CONTAINER_FULL - max limit of hash_map
+   *  - error_code from copy for key
+   **/
+  template <typename... Args>
+  [[nodiscard]] error_code
+  try_emplace(const Key& key, Args&&... args) noexcept {
+    auto value = this->template emplace_impl<const Key&>(
+        key, std::forward<Args>(args)...
+    );
+    return value ? error_codes::OK : value.error();
+  }
+
+  /**
+   * Inserts a value constructed from `args` only if the key does not exist
+   *   yet, the key is left untouched if it is already present
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION - bucket resize
+   *  - error_codes::CONTAINER_FULL - max limit of hash_map
+   **/
+  template <typename... Args>
+  [[nodiscard]] error_code try_emplace(Key&& key, Args&&... args) noexcept {
+    auto value = this->template emplace_impl<Key&&>(
+        std::move(key), std::forward<Args>(args)...
+    );
+    return value ? error_codes::OK : value.error();
+  }
+
+  /**
+   * Gets the value of the key, a default constructed value is inserted first
+   *   if the key does not exist yet
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION - bucket resize or key copy
+   *  - error_codes::CONTAINER_FULL - max limit of hash_map
+   *  - error_code from copy for key
+   **/
+  [[nodiscard]] expected<Value*, error_code>
+  get_or_insert(const Key& key) noexcept {
+    return this->template emplace_impl<const Key&>(key);
+  }
+
+  /**
+   * Gets the value of the key, a default constructed value is inserted first
+   *   if the key does not exist yet
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION - bucket resize
+   *  - error_codes::CONTAINER_FULL - max limit of hash_map
+   **/
+  [[nodiscard]] expected<Value*, error_code> get_or_insert(Key&& key) noexcept {
+    return this->template emplace_impl<Key&&>(std::move(key));
+  }
+
   /**
    * Removes a key/value pair in the hash map
    * If no key was found, nothing will happen to the hash map
@@ -301,6 +532,55 @@ public:
     return this->find<bool>(key);
   }
 
+  /**
+   * Batched unsafe lookup - writes the value's address of each key in
+   *   `values`, nullptr if the key was not found
+   *
+   * The slots of the keys are prefetched before probing so the cache misses
+   *   of a batch overlap instead of waiting on each other
+   **/
+  void find_batch(const Key* keys, usize count, Value** values) noexcept {
+    this->find_batch_impl<Key, Value*>(keys, count, values);
+  }
+
+  /**
+   * Batched unsafe lookup - writes the value's address of each key in
+   *   `values`, nullptr if the key was not found
+   **/
+  void find_batch(const Key* keys, usize count, const Value** values)
+      const noexcept {
+    this->find_batch_impl<Key, const Value*>(keys, count, values);
+  }
+
+  /**
+   * Batched check if each key exists in the hash map
+   **/
+  void
+  contains_batch(const Key* keys, usize count, bool* found) const noexcept {
+    this->find_batch_impl<Key, bool>(keys, count, found);
+  }
+
+#ifdef DS_HASH_STATS
+  /**
+   * Collects the probe lengths, clusters and memory of the hash map, walks
+   *   every slot of the bucket so it is not meant for hot paths
+   **/
+  [[nodiscard]] hash_stats get_stats() const noexcept {
+    hash_stats stats{};
+    collect_bucket_stats(
+        stats, this->distances, this->capacity, sizeof(node_type)
+    );
+    if (this->is_migrating()) {
+      collect_bucket_stats(
+          stats, this->old_distances, this->old_capacity, sizeof(node_type)
+      );
+    }
+    stats.resizes = this->counters.resizes;
+    stats.rehashed = this->counters.rehashed;
+    return stats;
+  }
+#endif
+
 #ifdef DS_TEST
   void print() const noexcept {
     printf("=== hash_map ===\n");
@@ -308,9 +588,13 @@ public:
       printf("No elements\n");
     }
     for (usize i = 0; i < this->capacity; ++i) {
+      if (this->distances[i] == HASHMAP_EMPTY_VALUE) {
+        printf(USIZE_FORMAT ": empty\n", i);
+        continue;
+      }
       printf(
-          USIZE_FORMAT ": (%16llx, %16llx) distance: %16llx\n", i,
-          this->bucket[i].key, this->bucket[i].value, this->bucket[i].distance
+          USIZE_FORMAT ": (%16llx, %16llx) distance: %u\n", i,
+          this->bucket[i].key, this->bucket[i].value, this->distances[i]
       );
     }
   }
@@ -318,42 +602,193 @@ public:
 
 protected:
   node_type* bucket = nullptr;
+  // Probe distance + 1 of each node in the bucket, 0 if the node is empty
+  u8* distances = nullptr;
   usize size = 0U;
   usize max_size = 0U;
   usize capacity = 0U;
+  f32 max_load_factor = HASHMAP_LOAD_FACTOR;
+  [[no_unique_address]] table_seed<Policy::RANDOM_SEED> seed{};
+#ifdef DS_HASH_STATS
+  hash_counters counters{};
+#endif
+
+  // NOTE: Only used by incremental policies, the bucket still being migrated
+  //   to `bucket`. Nodes are only removed from it, never inserted.
+  node_type* old_bucket = nullptr;
+  u8* old_distances = nullptr;
+  usize old_capacity = 0U;
+  // Every slot before this index in the old bucket is already migrated
+  usize migrate_index = 0U;
 
   // === Helpers === //
 
   /**
-   * Calculates the hash for the value, which already resizes the index within
-   * the range of the bucket count
+   * Gets the hash of the node's key, reuses the stored hash if the policy keeps
+   *   one in the node
+   **/
+  [[nodiscard]] usize get_node_hash(const node_type& node) const noexcept {
+    if constexpr (Policy::STORE_HASH) {
+      return node.hash.value;
+    } else {
+      return this->hash_key(node.key);
+    }
+  }
+
+  /**
+   * Hashes the key with the seed of the container if the policy gives it one
+   **/
+  template <typename Key_>
+  [[nodiscard]] usize hash_key(const Key_& key) const noexcept {
+    if constexpr (!Policy::RANDOM_SEED) {
+      return Hash{}(key);
+    } else if constexpr (seeded_hash<Hash, Key_>) {
+      return Hash{}(key, this->seed.value);
+    } else {
+      return hash_combine(this->seed.value, Hash{}(key));
+    }
+  }
+
+  /**
+   * Gets the hash is_node_key compares, it is only read if the policy stores
+   *   it in the node so the key is never hashed for it
+   **/
+  [[nodiscard]] static usize get_stored_hash(const node_type& node) noexcept {
+    if constexpr (Policy::STORE_HASH) {
+      return node.hash.value;
+    } else {
+      return 0U;
+    }
+  }
+
+  /**
+   * Compares the key with the node's key, the stored hashes are compared first
+   *   so most mismatches skip the key comparison
    **/
   template <typename Key_>
-  [[nodiscard]] usize calculate_hash_index(Key_ key) const noexcept {
-    return Hash{}(key) % this->capacity;
+  [[nodiscard]] static bool
+  is_node_key(Key_ key, usize hash, const node_type& node) noexcept {
+    if constexpr (Policy::STORE_HASH) {
+      if (node.hash.value != hash) {
+        return false;
+      }
+    }
+    return KeyEqual()(key, node.key);
+  }
+
+  /**
+   * Value stored in the distances, saturated at HASHMAP_MAX_DISTANCE
+   **/
+  [[nodiscard]] static u8 saturate_distance(usize distance) noexcept {
+    return distance < HASHMAP_MAX_DISTANCE ? (u8)distance
+                                           : HASHMAP_MAX_DISTANCE;
+  }
+
+  /**
+   * Probe distance + 1 of the node in the slot, a saturated distance is
+   *   computed again from the hash of the node
+   **/
+  [[nodiscard]] usize get_distance(
+      const node_type* bucket, const u8* distances, usize capacity, usize index
+  ) const noexcept {
+    if (distances[index] < HASHMAP_MAX_DISTANCE) [[likely]] {
+      return distances[index];
+    }
+    return this->get_hashed_distance(bucket, capacity, index);
   }
 
+  /**
+   * Probe distance + 1 of the node in the slot computed from its hash
+   **/
+  [[nodiscard]] usize get_hashed_distance(
+      const node_type* bucket, usize capacity, usize index
+  ) const noexcept {
+    usize hashed = Policy::get_index(get_node_hash(bucket[index]), capacity);
+    return (index >= hashed ? index - hashed : index + capacity - hashed) + 1U;
+  }
+
+  /**
+   * Checks if a bucket is still being migrated by an incremental policy
+   **/
+  [[nodiscard]] bool is_migrating() const noexcept {
+    if constexpr (Policy::INCREMENTAL_REHASH) {
+      return this->old_bucket != nullptr;
+    } else {
+      return false;
+    }
+  }
+
+  /**
+   * Places the node in the bucket, check_allocation should be called before
+   * this so the bucket always has an empty slot
+   **/
   void insert_node(node_type&& node) noexcept {
+    usize hash = this->hash_key(node.key);
+    if constexpr (Policy::STORE_HASH) {
+      node.hash.value = hash;
+    }
+
+    // The key might not be migrated yet, overwrite it where it is
+    if (this->is_migrating()) {
+      node_type* old_node = find_in_bucket<const Key&>(
+          node.key, hash, this->old_bucket, this->old_distances,
+          this->old_capacity
+      );
+      if (old_node != nullptr) {
+        old_node->value = std::move(node.value);
+        return;
+      }
+    }
+
+    this->place_node(node, hash);
+  }
+
+  /**
+   * Places the node in the current bucket, does not check the old bucket.
+   *   `hash` is the hash of the node's key so it is not computed again.
+   **/
+  void place_node(node_type& node, usize hash) noexcept {
+    this->place_node_from(
+        node, hash, Policy::get_index(hash, this->capacity), 1U
+    );
+  }
+
+  /**
+   * Continues placing the node from `index` where it is `distance` away from
+   *   its hashed index, see place_node
+   **/
+  void place_node_from(
+      node_type& node, usize hash, usize index, usize distance
+  ) noexcept {
     // NOTE: No infinite loop since 1 node will always be empty in any case
-    for (usize index = this->calculate_hash_index<const Key&>(node.key);;) {
+    for (;;) {
       // Place the node on an empty bucket slot
-      if (this->bucket[index].is_node_empty()) {
-        this->bucket[index] = std::move(node);
+      if (this->distances[index] == HASHMAP_EMPTY_VALUE) {
+        new (this->bucket + index) node_type(std::move(node));
+        this->distances[index] = saturate_distance(distance);
         ++this->size;
-        break;
+        return;
       }
 
       // If the key already exists, overwrite the value
-      if (KeyEqual()(node.key, this->bucket[index].key)) {
+      if (is_node_key<const Key&>(node.key, hash, this->bucket[index])) {
         this->bucket[index].value = std::move(node.value);
-        break;
+        return;
       }
 
       // Swapping between the `rich` and `poor` nodes
-      if (node.distance > this->bucket[index].distance) {
-        std::swap(node, this->bucket[index]);
+      if (distance > this->distances[index]) {
+        usize resident = this->get_distance(
+            this->bucket, this->distances, this->capacity, index
+        );
+        if (distance > resident) {
+          std::swap(node, this->bucket[index]);
+          hash = get_stored_hash(node);
+          this->distances[index] = saturate_distance(distance);
+          distance = resident;
+        }
       }
-      ++node.distance;
+      ++distance;
 
       if (++index >= this->capacity) {
         index = 0;
@@ -361,6 +796,89 @@ protected:
     }
   }
 
+  /**
+   * Places a node whose key is not in the hash map yet, the key comparisons of
+   *   place_node are skipped. check_allocation should be called before this.
+   *
+   * @return the slot the node ended up in
+   **/
+  node_type* place_new_node(node_type&& node, usize hash) noexcept {
+    if constexpr (Policy::STORE_HASH) {
+      node.hash.value = hash;
+    }
+
+    usize distance = 1U;
+    // NOTE: No infinite loop since 1 node will always be empty in any case
+    for (usize index = Policy::get_index(hash, this->capacity);;) {
+      if (this->distances[index] == HASHMAP_EMPTY_VALUE) {
+        new (this->bucket + index) node_type(std::move(node));
+        this->distances[index] = saturate_distance(distance);
+        ++this->size;
+        return this->bucket + index;
+      }
+
+      // Take the slot of the richer node, and move that node further down
+      if (distance > this->distances[index]) {
+        usize resident = this->get_distance(
+            this->bucket, this->distances, this->capacity, index
+        );
+        if (distance > resident) {
+          std::swap(node, this->bucket[index]);
+          this->distances[index] = saturate_distance(distance);
+
+          usize next = index + 1U < this->capacity ? index + 1U : 0U;
+          // NOTE: The displaced node is not hashed, the hash is only compared
+          //   if the policy stores it
+          this->place_node_from(
+              node, get_stored_hash(node), next, resident + 1U
+          );
+          return this->bucket + index;
+        }
+      }
+
+      ++distance;
+      if (++index >= this->capacity) {
+        index = 0U;
+      }
+    }
+  }
+
+  /**
+   * Finds the key, or inserts a value constructed from `args` if it does not
+   *   exist yet. The key is only copied or moved when it is inserted.
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION - bucket resize or key copy
+   *  - error_codes::CONTAINER_FULL - max limit of hash_map
+   *  - error_code from copy for key
+   **/
+  template <typename Key_, typename... Args>
+  [[nodiscard]] expected<Value*, error_code>
+  emplace_impl(Key_ key, Args&&... args) noexcept {
+    // NOTE: A moved key is only looked up, it is moved once it is inserted
+    using lookup_type = std::conditional_t<
+        std::is_rvalue_reference_v<Key_>, const std::remove_reference_t<Key_>&,
+        Key_>;
+
+    usize hash = this->hash_key(key);
+    node_type* node = this->find_node<lookup_type>(key, hash);
+    if (node != nullptr) {
+      return &node->value;
+    }
+
+    DS_TRY(this->check_allocation(), to_unexpected);
+
+    node_type new_node{.value = Value(std::forward<Args>(args)...)};
+    if constexpr (std::is_rvalue_reference_v<Key_>) {
+      new_node.key = std::move(key);
+    } else if constexpr (!std::is_class_v<Key>) {
+      new_node.key = key;
+    } else {
+      DS_TRY(new_node.key.copy(key), to_unexpected);
+    }
+    return &this->place_new_node(std::move(new_node), hash)->value;
+  }
+
   /**
    * Inserts a value in the hash map
    *
@@ -373,7 +891,7 @@ protected:
   insert_impl(const Key& key, const Value& value) noexcept {
     DS_TRY(this->check_allocation());
 
-    node_type node{.distance = 0U};
+    node_type node{};
     if constexpr (!std::is_class_v<Key>) {
       node.key = key;
     } else {
@@ -402,7 +920,7 @@ protected:
   insert_impl(const Key& key, Value&& value) noexcept {
     DS_TRY(this->check_allocation());
 
-    node_type node{.value = std::move(value), .distance = 0U};
+    node_type node{.value = std::move(value)};
     if constexpr (!std::is_class_v<Key>) {
       node.key = key;
     } else {
@@ -425,7 +943,7 @@ protected:
   insert_impl(Key&& key, const Value& value) noexcept {
     DS_TRY(this->check_allocation());
 
-    node_type node{.key = std::move(key), .distance = 0U};
+    node_type node{.key = std::move(key)};
     if constexpr (!std::is_class_v<Value>) {
       node.value = value;
     } else {
@@ -447,184 +965,558 @@ protected:
   insert_impl(Key&& key, Value&& value) noexcept {
     DS_TRY(this->check_allocation());
 
-    this->insert_node(
-        node_type{
-            .key = std::move(key), .value = std::move(value), .distance = 0U
-        }
+    this->insert_node(node_type{.key = std::move(key), .value = std::move(value)}
     );
 
     return error_codes::OK;
   }
 
   template <typename Key_> void erase_impl(Key_ key) noexcept {
-    usize index = this->calculate_hash_index<Key_>(key);
+    if (this->is_empty()) {
+      return;
+    }
+
+    usize hash = this->hash_key(key);
+    bool erased = erase_in_bucket<Key_>(
+        key, hash, this->bucket, this->distances, this->capacity
+    );
+    if (!erased && this->is_migrating()) {
+      erased = erase_in_bucket<Key_>(
+          key, hash, this->old_bucket, this->old_distances, this->old_capacity
+      );
+    }
+
+    if (erased) {
+      --this->size;
+    }
+  }
+
+  /**
+   * Removes the key from the bucket with the backward shift algorithm
+   *
+   * @return whether the key was found
+   **/
+  template <typename Key_>
+  [[nodiscard]] bool erase_in_bucket(
+      Key_ key, usize hash, node_type* bucket, u8* distances, usize capacity
+  ) const noexcept {
+    usize index = Policy::get_index(hash, capacity);
 
     // NOTE: No infinite loop since 1 node will always be empty in any case
-    while (true) {
-      if (this->bucket[index].is_node_empty()) {
-        return;
+    for (usize distance = 1U;; ++distance) {
+      // Robin hood invariant, the key would have displaced a richer node
+      // NOTE: This also covers empty nodes since their distance is 0
+      if (distance > distances[index] &&
+          distance > this->get_distance(bucket, distances, capacity, index)) {
+        return false;
       }
 
-      if (KeyEqual()(key, this->bucket[index].key)) {
-        --this->size;
+      if (is_node_key<Key_>(key, hash, bucket[index])) {
         break;
       }
 
-      if (++index >= this->capacity) {
+      if (++index >= capacity) {
         index = 0;
       }
     }
 
     // Backward shift delete algorithm
 
+    // NOTE: Empty nodes (0) and nodes in their original hash (1) stop the shift
+
     // index -> capacity
-    for (++index; index < this->capacity; ++index) {
-      if (this->bucket[index].is_node_empty() ||
-          this->bucket[index].distance == 0U) {
-        this->bucket[index - 1U].to_empty();
-        return;
+    for (++index; index < capacity; ++index) {
+      if (distances[index] <= 1U) {
+        distances[index - 1U] = HASHMAP_EMPTY_VALUE;
+        destroy_node(bucket[index - 1U]);
+        return true;
       }
-      --this->bucket[index].distance;
-      this->bucket[index - 1U] = std::move(this->bucket[index]);
+      this->shift_node(bucket, distances, capacity, index, index - 1U);
     }
 
     // capacity -> 0
-    if (this->bucket[0].is_node_empty() || this->bucket[0].distance == 0U) {
-      this->bucket[this->capacity - 1U].to_empty();
-      return;
+    if (distances[0] <= 1U) {
+      distances[capacity - 1U] = HASHMAP_EMPTY_VALUE;
+      destroy_node(bucket[capacity - 1U]);
+      return true;
     }
-    --this->bucket[0].distance;
-    this->bucket[this->capacity - 1U] = std::move(this->bucket[0]);
+    this->shift_node(bucket, distances, capacity, 0U, capacity - 1U);
 
     // 0 -> original hash
     // NOTE: No infinite loop since 1 node will always be empty in any case
     for (index = 1U;; ++index) {
-      if (this->bucket[index].is_node_empty() ||
-          this->bucket[index].distance == 0U) {
-        this->bucket[index - 1U].to_empty();
-        return;
+      if (distances[index] <= 1U) {
+        distances[index - 1U] = HASHMAP_EMPTY_VALUE;
+        destroy_node(bucket[index - 1U]);
+        return true;
       }
-      --this->bucket[index].distance;
-      this->bucket[index - 1U] = std::move(this->bucket[index]);
+      this->shift_node(bucket, distances, capacity, index, index - 1U);
+    }
+  }
+
+  /**
+   * Moves the node a slot back to `to`, a saturated distance is computed
+   *   again once the node is in its new slot
+   **/
+  void shift_node(
+      node_type* bucket, u8* distances, usize capacity, usize from, usize to
+  ) const noexcept {
+    bucket[to] = std::move(bucket[from]);
+    if (distances[from] < HASHMAP_MAX_DISTANCE) [[likely]] {
+      distances[to] = distances[from] - 1U;
+      return;
     }
+
+    distances[to] =
+        saturate_distance(this->get_hashed_distance(bucket, capacity, to));
   }
 
   template <typename Return>
   [[nodiscard]] Return find(const Key& key) const noexcept {
+    node_type* node = this->find_node<const Key&>(key);
+    if constexpr (std::is_same_v<Return, Value*>) {
+      return node == nullptr ? nullptr : &node->value;
+    } else if constexpr (std::is_same_v<Return, bool>) {
+      return node != nullptr;
+    }
+  }
+
+  /**
+   * Finds the node of the key in the bucket, or in the old bucket if it is not
+   *   migrated yet
+   **/
+  template <typename Key_>
+  [[nodiscard]] node_type* find_node(Key_ key) const noexcept {
+    if (this->is_empty()) {
+      return nullptr;
+    }
+    return this->find_node<Key_>(key, this->hash_key(key));
+  }
+
+  /**
+   * Finds the node of the key with its already computed hash
+   **/
+  template <typename Key_>
+  [[nodiscard]] node_type* find_node(Key_ key, usize hash) const noexcept {
     if (this->is_empty()) {
-      if constexpr (std::is_same_v<Return, Value*>) {
+      return nullptr;
+    }
+
+    node_type* node = find_in_bucket<Key_>(
+        key, hash, this->bucket, this->distances, this->capacity
+    );
+    if (node == nullptr && this->is_migrating()) {
+      node = find_in_bucket<Key_>(
+          key, hash, this->old_bucket, this->old_distances, this->old_capacity
+      );
+    }
+    return node;
+  }
+
+  template <typename Key_>
+  [[nodiscard]] node_type* find_in_bucket(
+      Key_ key, usize hash, node_type* bucket, const u8* distances,
+      usize capacity
+  ) const noexcept {
+    return this->find_in_bucket_from<Key_>(
+        key, hash, Policy::get_index(hash, capacity), bucket, distances,
+        capacity
+    );
+  }
+
+  /**
+   * Probes the bucket for the key starting from its hashed index
+   **/
+  template <typename Key_>
+  [[nodiscard]] node_type* find_in_bucket_from(
+      Key_ key, usize hash, usize index, node_type* bucket,
+      const u8* distances, usize capacity
+  ) const noexcept {
+    // NOTE: No infinite loop since 1 node will always be empty in any case
+    for (usize distance = 1U;; ++distance) {
+      // Robin hood invariant, the key would have displaced a richer node
+      // NOTE: This also covers empty nodes since their distance is 0
+      if (distance > distances[index] &&
+          distance > this->get_distance(bucket, distances, capacity, index)) {
         return nullptr;
-      } else if constexpr (std::is_same_v<Return, bool>) {
-        return false;
+      }
+
+      if (is_node_key<Key_>(key, hash, bucket[index])) {
+        return bucket + index;
+      }
+
+      if (++index >= capacity) {
+        index = 0U;
       }
     }
+  }
 
-    // NOTE: No infinite loop since 1 node will always be empty in any case
-    for (usize index = this->calculate_hash_index<const Key&>(key);;) {
-      if (this->bucket[index].is_node_empty()) {
-        if constexpr (std::is_same_v<Return, Value*>) {
-          return nullptr;
-        } else if constexpr (std::is_same_v<Return, bool>) {
-          return false;
-        }
+  /**
+   * Looks up the keys in batches of HASHMAP_BATCH_SIZE. Every key of a batch
+   *   is hashed and its slot prefetched first, then the probes are resolved.
+   *
+   * NOTE: Keys still in the old bucket of an incremental policy are not
+   *   prefetched, they fall back to a normal lookup
+   **/
+  template <typename Key_, typename Return>
+  void find_batch_impl(const Key_* keys, usize count, Return* output)
+      const noexcept {
+    if (this->is_empty()) {
+      for (usize i = 0U; i < count; ++i) {
+        output[i] = Return{};
       }
+      return;
+    }
 
-      if (KeyEqual()(key, this->bucket[index].key)) {
-        if constexpr (std::is_same_v<Return, Value*>) {
-          return &this->bucket[index].value;
-        } else if constexpr (std::is_same_v<Return, bool>) {
-          return true;
+    usize hashes[HASHMAP_BATCH_SIZE];  // NOLINT
+    usize indices[HASHMAP_BATCH_SIZE]; // NOLINT
+    for (usize start = 0U; start < count; start += HASHMAP_BATCH_SIZE) {
+      usize batch = count - start < HASHMAP_BATCH_SIZE ? count - start
+                                                       : HASHMAP_BATCH_SIZE;
+
+      // NOTE: Hashes with a batch form hash the whole batch at once
+      if constexpr (batch_hash<Hash, Key_> && !Policy::RANDOM_SEED) {
+        Hash{}.hash_batch(keys + start, batch, hashes);
+      } else {
+        for (usize i = 0U; i < batch; ++i) {
+          hashes[i] = this->hash_key(keys[start + i]);
         }
       }
 
-      if (++index >= this->capacity) {
-        index = 0U;
+      for (usize i = 0U; i < batch; ++i) {
+        indices[i] = Policy::get_index(hashes[i], this->capacity);
+        prefetch(this->distances + indices[i]);
+        prefetch(this->bucket + indices[i]);
+      }
+
+      for (usize i = 0U; i < batch; ++i) {
+        node_type* node = find_in_bucket_from<const Key_&>(
+            keys[start + i], hashes[i], indices[i], this->bucket,
+            this->distances, this->capacity
+        );
+        if (node == nullptr && this->is_migrating()) {
+          node = find_in_bucket<const Key_&>(
+              keys[start + i], hashes[i], this->old_bucket,
+              this->old_distances, this->old_capacity
+          );
+        }
+
+        if constexpr (std::is_same_v<Return, bool>) {
+          output[start + i] = node != nullptr;
+        } else {
+          output[start + i] = node == nullptr ? nullptr : &node->value;
+        }
       }
     }
   }
 
   // === Memory === //
 
+  /**
+   * Number of keys a bucket of `bucket_capacity` holds before growing
+   **/
+  [[nodiscard]] usize get_max_size(usize bucket_capacity) const noexcept {
+    auto new_max_size =
+        static_cast<usize>(bucket_capacity * this->max_load_factor);
+    // NOTE: At least 1 slot has to stay empty so the probes always stop
+    return new_max_size < bucket_capacity ? new_max_size : bucket_capacity - 1U;
+  }
+
+  /**
+   * Smallest capacity of the policy that holds `count` keys without growing
+   *
+   * @return 0 if the capacity overflows
+   **/
+  [[nodiscard]] usize get_fitting_capacity(usize count) const noexcept {
+    usize new_capacity = Policy::get_first_capacity();
+    while (this->get_max_size(new_capacity) < count) {
+      usize next_capacity = Policy::get_next_capacity(new_capacity);
+      if (next_capacity <= new_capacity) {
+        return 0U;
+      }
+      new_capacity = next_capacity;
+    }
+    return new_capacity;
+  }
+
   /**
    * Check if the allocation can handle any mutation done to the hash map
    *
    * @errors
    *  - error_codes::BAD_ALLOCATION
+   *  - error_codes::CONTAINER_FULL - max limit of hash_map
    **/
   [[nodiscard]] error_code check_allocation() noexcept {
     if (this->bucket == nullptr) {
-      return this->allocate(get_first_prime());
+      return this->allocate(Policy::get_first_capacity());
     }
 
     if (this->size >= HASHMAP_MAX_SIZE) {
       return error_codes::CONTAINER_FULL;
     }
 
-    if (this->size >= this->max_size) {
-      return this->reallocate(this->capacity * 2U + 1U);
+    if constexpr (Policy::INCREMENTAL_REHASH) {
+      if (this->is_migrating()) {
+        this->migrate(Policy::MIGRATE_COUNT);
+      }
+
+      if (this->size >= this->max_size) {
+        // NOTE: Rare, only when the migration is slower than the inserts
+        if (this->is_migrating()) {
+          this->migrate(USIZE_MAX);
+        }
+        DS_TRY(this->start_migration(Policy::get_next_capacity(this->capacity))
+        );
+      }
+    } else if (this->size >= this->max_size) {
+      DS_TRY(this->reallocate(Policy::get_next_capacity(this->capacity)));
     }
 
     return error_codes::OK;
   }
 
   /**
+   * Allocates an empty bucket with its distances right after the nodes. The
+   *   slots are left as raw storage, a node is only constructed once it is
+   *   placed in a slot.
    *
+   * @return nullptr if the allocation failed
    **/
-  [[nodiscard]] error_code allocate(usize new_capacity) noexcept {
-    // NOLINTNEXTLINE
-    this->bucket = (node_type*)std::malloc(new_capacity * sizeof(node_type));
-    if (this->bucket == nullptr) {
-      return error_codes::BAD_ALLOCATION;
+  [[nodiscard]] static node_type* allocate_bucket(usize new_capacity) noexcept {
+    if (new_capacity > USIZE_MAX / (sizeof(node_type) + sizeof(u8))) {
+      return nullptr;
     }
 
-    new (this->bucket) node_type[new_capacity];
+    auto* new_bucket = static_cast<node_type*>(
+        Allocator{}.allocate(new_capacity * (sizeof(node_type) + sizeof(u8)))
+    );
+    if (new_bucket == nullptr) {
+      return nullptr;
+    }
 
-    this->capacity = new_capacity;
-    this->max_size = new_capacity * HASHMAP_LOAD_FACTOR;
+    auto* new_distances = (u8*)(new_bucket + new_capacity); // NOLINT
+    std::memset(new_distances, HASHMAP_EMPTY_VALUE, new_capacity);
+    return new_bucket;
+  }
+
+  /**
+   * Copies the nodes and distances of a bucket into an empty bucket of the
+   *   same capacity. Each distance is set once its node is constructed, so a
+   *   failed copy can still be cleared.
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION - key/value copy
+   *  - error_code from copy for key or value
+   **/
+  [[nodiscard]] static error_code copy_bucket(
+      node_type* new_bucket, const node_type* other_bucket,
+      usize bucket_capacity
+  ) noexcept {
+    // NOTE: The distances are right after the nodes so both are copied at once
+    if constexpr (std::is_trivially_copyable_v<node_type>) {
+      std::memcpy(
+          new_bucket, other_bucket,
+          bucket_capacity * (sizeof(node_type) + sizeof(u8))
+      );
+      return error_codes::OK;
+    }
+
+    auto* new_distances = (u8*)(new_bucket + bucket_capacity); // NOLINT
+    const auto* other_distances =
+        (const u8*)(other_bucket + bucket_capacity); // NOLINT
+    for (usize i = 0U; i < bucket_capacity; ++i) {
+      if (other_distances[i] == HASHMAP_EMPTY_VALUE) {
+        continue;
+      }
+
+      new (new_bucket + i) node_type{};
+      new_distances[i] = other_distances[i];
+      if constexpr (!std::is_class_v<Key>) {
+        new_bucket[i].key = other_bucket[i].key;
+      } else {
+        DS_TRY(new_bucket[i].key.copy(other_bucket[i].key));
+      }
+
+      if constexpr (!std::is_class_v<Value>) {
+        new_bucket[i].value = other_bucket[i].value;
+      } else {
+        DS_TRY(new_bucket[i].value.copy(other_bucket[i].value));
+      }
+      new_bucket[i].hash = other_bucket[i].hash;
+    }
 
     return error_codes::OK;
   }
 
-  [[nodiscard]] error_code reallocate(usize new_capacity) noexcept {
-    // NOLINTNEXTLINE
-    auto* new_bucket =
-        // NOLINTNEXTLINE
-        (node_type*)std::malloc(new_capacity * sizeof(node_type));
+  /**
+   * Allocates the bucket and the distances in a single block
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION
+   **/
+  [[nodiscard]] error_code allocate(usize new_capacity) noexcept {
+    node_type* new_bucket = allocate_bucket(new_capacity);
     if (new_bucket == nullptr) {
       return error_codes::BAD_ALLOCATION;
     }
 
-    new (new_bucket) node_type[new_capacity];
+    this->bucket = new_bucket;
+    this->distances = (u8*)(new_bucket + new_capacity); // NOLINT
 
-    // Swap the pointers and capacity to easily use the insert function
-    std::swap(this->bucket, new_bucket);
-    std::swap(this->capacity, new_capacity);
-    this->size = 0;
-    this->max_size = this->capacity * HASHMAP_LOAD_FACTOR;
+    this->capacity = new_capacity;
+    this->max_size = this->get_max_size(new_capacity);
+
+    return error_codes::OK;
+  }
+
+  /**
+   * Moves all the nodes to a new bucket, should not be called while migrating
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION
+   **/
+  [[nodiscard]] error_code reallocate(usize new_capacity) noexcept {
+    node_type* prev_bucket = this->bucket;
+    u8* prev_distances = this->distances;
+    usize prev_capacity = this->capacity;
+
+    DS_TRY(this->allocate(new_capacity));
+    this->size = 0U;
+    DS_HASH_STATS_ADD(this->counters.resizes, 1U);
 
     // Transfer the old bucket to the new bucket
-    for (usize i = 0; i < new_capacity; ++i) {
-      if (new_bucket[i].is_node_empty()) {
+    for (usize i = 0U; i < prev_capacity; ++i) {
+      if (prev_distances[i] == HASHMAP_EMPTY_VALUE) {
         continue;
       }
 
-      new_bucket[i].distance = 0U;
-      this->insert_node(std::move(new_bucket[i]));
+      this->place_node(prev_bucket[i], get_node_hash(prev_bucket[i]));
+      DS_HASH_STATS_ADD(this->counters.rehashed, 1U);
     }
 
-    std::free(new_bucket); // NOLINT
+    this->deallocate(prev_bucket, prev_capacity);
+    return error_codes::OK;
+  }
+
+  /**
+   * Allocates a new bucket while keeping the current bucket alive, the nodes
+   *   are moved to the new bucket on the next inserts with migrate
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION
+   **/
+  [[nodiscard]] error_code start_migration(usize new_capacity) noexcept {
+    node_type* prev_bucket = this->bucket;
+    u8* prev_distances = this->distances;
+    usize prev_capacity = this->capacity;
+
+    DS_TRY(this->allocate(new_capacity));
+    DS_HASH_STATS_ADD(this->counters.resizes, 1U);
+
+    this->old_bucket = prev_bucket;
+    this->old_distances = prev_distances;
+    this->old_capacity = prev_capacity;
+    this->migrate_index = 0U;
+
     return error_codes::OK;
   }
+
+  /**
+   * Moves at least `count` slots of the old bucket to the current bucket.
+   *   Whole runs of nodes are moved starting from their last node, so the nodes
+   *   left in the old bucket never have an empty slot in their probe sequence.
+   **/
+  void migrate(usize count) noexcept {
+    usize migrated = 0U;
+    while (this->migrate_index < this->old_capacity) {
+      if (this->old_distances[this->migrate_index] == HASHMAP_EMPTY_VALUE) {
+        if (migrated >= count) {
+          return;
+        }
+        ++this->migrate_index;
+        ++migrated;
+        continue;
+      }
+
+      usize end = this->migrate_index + 1U;
+      while (end < this->old_capacity &&
+             this->old_distances[end] != HASHMAP_EMPTY_VALUE) {
+        ++end;
+      }
+
+      for (usize index = end; index > this->migrate_index;) {
+        --index;
+
+        this->old_distances[index] = HASHMAP_EMPTY_VALUE;
+        --this->size;
+        node_type& node = this->old_bucket[index];
+        this->place_node(node, get_node_hash(node));
+        destroy_node(node);
+        DS_HASH_STATS_ADD(this->counters.rehashed, 1U);
+      }
+
+      migrated += end - this->migrate_index;
+      this->migrate_index = end;
+    }
+
+    this->release_old_bucket();
+  }
+
+  void release_old_bucket() noexcept {
+    if (this->old_bucket == nullptr) {
+      return;
+    }
+
+    this->deallocate(this->old_bucket, this->old_capacity);
+    this->old_bucket = nullptr;
+    this->old_distances = nullptr;
+    this->old_capacity = this->migrate_index = 0U;
+  }
+
+  /**
+   * Ends the lifetime of a node whose slot became empty, the slot stays raw
+   *   storage until another node is placed in it
+   **/
+  static void destroy_node(node_type& node) noexcept {
+    if constexpr (!std::is_trivially_destructible_v<node_type>) {
+      node.~node_type();
+    }
+  }
+
+  /**
+   * Destroys the nodes of the occupied slots, empty slots hold no node
+   **/
+  static void destroy_nodes(
+      node_type* nodes, const u8* node_distances, usize node_capacity
+  ) noexcept {
+    if constexpr (!std::is_trivially_destructible_v<node_type>) {
+      for (usize i = 0U; i < node_capacity; ++i) {
+        if (node_distances[i] != HASHMAP_EMPTY_VALUE) {
+          nodes[i].~node_type();
+        }
+      }
+    }
+  }
+
+  void deallocate(node_type* prev_bucket, usize prev_capacity) noexcept {
+    destroy_nodes(
+        prev_bucket, (u8*)(prev_bucket + prev_capacity), // NOLINT
+        prev_capacity
+    );
+    Allocator{}.deallocate(prev_bucket);
+  }
 };
 
 // === hash_map definition === //
 
 template <
     typename Key, typename Value, typename Hash = hash<Key>,
-    typename KeyEqual = equal<Key>>
+    typename KeyEqual = equal<Key>, typename Policy = prime_hash_policy,
+    typename Allocator = allocator<void>>
 class hash_map
     : public base_hash_map<
-          hash_map<Key, Value, Hash, KeyEqual>, Key, Value, Hash, KeyEqual> {};
+          hash_map<Key, Value, Hash, KeyEqual, Policy, Allocator>, Key, Value,
+          Hash, KeyEqual, Policy, Allocator> {};
 
 } // namespace ds
 
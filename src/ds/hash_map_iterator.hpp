@@ -20,40 +20,62 @@ public:
 
 private:
   node_type* bucket = nullptr;
+  // NOTE: A distance of 0 marks an empty node
+  const u8* distances = nullptr;
   node_type* ptr = nullptr;
   usize index = 0;
   usize capacity = 0;
 
-  void find_next_element() noexcept {
-    if (this->ptr == nullptr) {
-      return;
-    }
+  // Bucket iterated after the current one, used while a hash map migrates
+  node_type* next_bucket = nullptr;
+  const u8* next_distances = nullptr;
+  usize next_capacity = 0;
 
+  void find_element(usize start) noexcept {
     // Find a bucket with a node
-    while (++this->index < this->capacity) {
-      this->ptr = this->bucket + this->index;
-      if (!this->ptr->is_node_empty()) {
+    for (this->index = start; this->index < this->capacity; ++this->index) {
+      if (this->distances[this->index] != 0U) {
+        this->ptr = this->bucket + this->index;
         return;
       }
     }
 
+    if (this->next_bucket != nullptr) {
+      this->bucket = this->next_bucket;
+      this->distances = this->next_distances;
+      this->capacity = this->next_capacity;
+      this->next_bucket = nullptr;
+      this->find_element(0U);
+      return;
+    }
+
     // No more nodes
     this->ptr = nullptr;
   }
 
+  void find_next_element() noexcept {
+    if (this->ptr == nullptr) {
+      return;
+    }
+
+    this->find_element(this->index + 1U);
+  }
+
 public:
   hash_map_iterator() noexcept = default;
 
-  explicit hash_map_iterator(node_type* bucket, usize capacity) noexcept
-      : bucket(bucket), capacity(capacity) {
-    // Find the first element
-    for (this->index = 0; this->index < capacity; ++this->index) {
-      this->ptr = bucket + this->index;
-      if (!this->ptr->is_node_empty()) {
-        return;
-      }
-    }
-    this->ptr = nullptr;
+  explicit hash_map_iterator(
+      node_type* bucket, const u8* distances, usize capacity,
+      node_type* next_bucket = nullptr, const u8* next_distances = nullptr,
+      usize next_capacity = 0U
+  ) noexcept
+      : bucket(bucket),
+        distances(distances),
+        capacity(capacity),
+        next_bucket(next_bucket),
+        next_distances(next_distances),
+        next_capacity(next_capacity) {
+    this->find_element(0U);
   }
 
   // === Element Access === //
@@ -103,40 +125,62 @@ public:
 
 private:
   node_type* bucket = nullptr;
+  // NOTE: A distance of 0 marks an empty node
+  const u8* distances = nullptr;
   node_type* ptr = nullptr;
   usize index = 0;
   usize capacity = 0;
 
-  void find_next_element() noexcept {
-    if (this->ptr == nullptr) {
-      return;
-    }
+  // Bucket iterated after the current one, used while a hash map migrates
+  node_type* next_bucket = nullptr;
+  const u8* next_distances = nullptr;
+  usize next_capacity = 0;
 
+  void find_element(usize start) noexcept {
     // Find a bucket with a node
-    while (++this->index < this->capacity) {
-      this->ptr = this->bucket + this->index;
-      if (!this->ptr->is_node_empty()) {
+    for (this->index = start; this->index < this->capacity; ++this->index) {
+      if (this->distances[this->index] != 0U) {
+        this->ptr = this->bucket + this->index;
         return;
       }
     }
 
+    if (this->next_bucket != nullptr) {
+      this->bucket = this->next_bucket;
+      this->distances = this->next_distances;
+      this->capacity = this->next_capacity;
+      this->next_bucket = nullptr;
+      this->find_element(0U);
+      return;
+    }
+
     // No more nodes
     this->ptr = nullptr;
   }
 
+  void find_next_element() noexcept {
+    if (this->ptr == nullptr) {
+      return;
+    }
+
+    this->find_element(this->index + 1U);
+  }
+
 public:
   hash_map_const_iterator() noexcept = default;
 
-  explicit hash_map_const_iterator(node_type* bucket, usize capacity) noexcept
-      : bucket(bucket), capacity(capacity) {
-    // Find the first element
-    for (this->index = 0; this->index < capacity; ++this->index) {
-      this->ptr = bucket + this->index;
-      if (!this->ptr->is_node_empty()) {
-        return;
-      }
-    }
-    this->ptr = nullptr;
+  explicit hash_map_const_iterator(
+      node_type* bucket, const u8* distances, usize capacity,
+      node_type* next_bucket = nullptr, const u8* next_distances = nullptr,
+      usize next_capacity = 0U
+  ) noexcept
+      : bucket(bucket),
+        distances(distances),
+        capacity(capacity),
+        next_bucket(next_bucket),
+        next_distances(next_distances),
+        next_capacity(next_capacity) {
+    this->find_element(0U);
   }
 
   // === Element Access === //
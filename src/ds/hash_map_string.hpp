@@ -10,6 +10,7 @@
 
 #include "./hash_map.hpp"
 #include "./string.hpp"
+#include "./string_view.hpp"
 #include "types.hpp"
 #include <type_traits>
 
@@ -19,14 +20,16 @@ namespace ds {
 
 template <
     typename Derived, typename Hash = hash<string>,
-    typename KeyEqual = equal<string>>
-class string_hash_map
-    : public base_hash_map<Derived, string, string, Hash, KeyEqual> {
+    typename KeyEqual = equal<string>, typename Policy = prime_hash_policy,
+    typename Allocator = allocator<void>>
+class string_hash_map : public base_hash_map<
+                            Derived, string, string, Hash, KeyEqual, Policy,
+                            Allocator> {
 public:
   using key_type = string;
   using value_type = string;
   using node_type = typename base_hash_map<
-      Derived, string, string, Hash, KeyEqual>::node_type;
+      Derived, string, string, Hash, KeyEqual, Policy, Allocator>::node_type;
 
   // === Accessors === //
 
@@ -53,7 +56,7 @@ public:
    *   - error_codes::NOT_FOUND
    **/
   [[nodiscard]] expected<string*, error_code> at(const c8* key) noexcept {
-    auto* value = this->find_with_c8<string*>(key);
+    auto* value = this->find_with<string*>(key);
     if (value == nullptr) {
       return unexpected<error_code>{error_codes::NOT_FOUND};
     }
@@ -77,7 +80,7 @@ public:
    *   else return nullptr
    **/
   [[nodiscard]] string* operator[](const c8* key) noexcept {
-    return this->find_with_c8<string*>(key);
+    return this->find_with<string*>(key);
   }
 
   /**
@@ -85,7 +88,7 @@ public:
    *   else return nullptr
    **/
   [[nodiscard]] const string* operator[](const c8* key) const noexcept {
-    return this->find_with_c8<string*>(key);
+    return this->find_with<string*>(key);
   }
 
   /**
@@ -99,7 +102,97 @@ public:
    * Checks if the value exists in the hash map
    **/
   [[nodiscard]] bool contains(const c8* key) const noexcept {
-    return this->find_with_c8<bool>(key);
+    return this->find_with<bool>(key);
+  }
+
+  /**
+   * Safe lookup with a view of the key, no copy of the key is made
+   *
+   * @errors
+   *   - error_codes::NOT_FOUND
+   **/
+  [[nodiscard]] expected<string*, error_code> at(string_view key) noexcept {
+    auto* value = this->find_with<string*>(key);
+    if (value == nullptr) {
+      return unexpected<error_code>{error_codes::NOT_FOUND};
+    }
+    return value;
+  }
+
+  /**
+   * Unsafe lookup with a view of the key - if a value was found then return
+   *   the value's address else return nullptr
+   **/
+  [[nodiscard]] string* operator[](string_view key) noexcept {
+    return this->find_with<string*>(key);
+  }
+
+  /**
+   * Unsafe lookup with a view of the key - if a value was found then return
+   *   the value's address else return nullptr
+   **/
+  [[nodiscard]] const string* operator[](string_view key) const noexcept {
+    return this->find_with<string*>(key);
+  }
+
+  /**
+   * Checks if the key of the view exists in the hash map
+   **/
+  [[nodiscard]] bool contains(string_view key) const noexcept {
+    return this->find_with<bool>(key);
+  }
+
+  /**
+   * Batched unsafe lookup - writes the value's address of each key in
+   *   `values`, nullptr if the key was not found
+   **/
+  void find_batch(const string* keys, usize count, string** values) noexcept {
+    this->template find_batch_impl<string, string*>(keys, count, values);
+  }
+
+  /**
+   * Batched unsafe lookup - writes the value's address of each key in
+   *   `values`, nullptr if the key was not found
+   **/
+  void
+  find_batch(const c8* const* keys, usize count, string** values) noexcept {
+    this->template find_batch_impl<const c8*, string*>(keys, count, values);
+  }
+
+  /**
+   * Batched unsafe lookup - writes the value's address of each key in
+   *   `values`, nullptr if the key was not found
+   **/
+  void find_batch(const string* keys, usize count, const string** values)
+      const noexcept {
+    this->template find_batch_impl<string, const string*>(keys, count, values);
+  }
+
+  /**
+   * Batched unsafe lookup - writes the value's address of each key in
+   *   `values`, nullptr if the key was not found
+   **/
+  void find_batch(const c8* const* keys, usize count, const string** values)
+      const noexcept {
+    this->template find_batch_impl<const c8*, const string*>(
+        keys, count, values
+    );
+  }
+
+  /**
+   * Batched check if each key exists in the hash map
+   **/
+  void contains_batch(const string* keys, usize count, bool* found)
+      const noexcept {
+    this->template find_batch_impl<string, bool>(keys, count, found);
+  }
+
+  /**
+   * Batched check if each key exists in the hash map
+   **/
+  void contains_batch(const c8* const* keys, usize count, bool* found)
+      const noexcept {
+    this->template find_batch_impl<const c8*, bool>(keys, count, found);
   }
 
   // === Mutations === //
@@ -211,7 +304,7 @@ public:
   [[nodiscard]] error_code insert(const c8* key, const c8* value) noexcept {
     DS_TRY(this->check_allocation());
 
-    node_type node{.distance = 0U};
+    node_type node{};
     DS_TRY(node.key.copy(key));
     DS_TRY(node.value.copy(value));
     this->insert_node(std::move(node));
@@ -219,6 +312,45 @@ public:
     return error_codes::OK;
   }
 
+  /**
+   * Gets the value of the key, a default constructed value is inserted first
+   *   if the key does not exist yet
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION - bucket resize or key copy
+   *  - error_codes::CONTAINER_FULL - max limit of hash_map
+   **/
+  [[nodiscard]] expected<string*, error_code>
+  get_or_insert(const string& key) noexcept {
+    return this->template emplace_impl<const string&>(key);
+  }
+
+  /**
+   * Gets the value of the key, a default constructed value is inserted first
+   *   if the key does not exist yet
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION - bucket resize
+   *  - error_codes::CONTAINER_FULL - max limit of hash_map
+   **/
+  [[nodiscard]] expected<string*, error_code>
+  get_or_insert(string&& key) noexcept {
+    return this->template emplace_impl<string&&>(std::move(key));
+  }
+
+  /**
+   * Gets the value of the key, a default constructed value is inserted first
+   *   if the key does not exist yet. The key is only copied when inserted.
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION - bucket resize or key copy
+   *  - error_codes::CONTAINER_FULL - max limit of hash_map
+   **/
+  [[nodiscard]] expected<string*, error_code>
+  get_or_insert(const c8* key) noexcept {
+    return this->template emplace_impl<const c8*>(key);
+  }
+
   /**
    * Removes a key/value pair in the hash map
    * If no key was found, nothing will happen to the hash map
@@ -235,6 +367,14 @@ public:
     this->template erase_impl<const c8*>(key);
   }
 
+  /**
+   * Removes the key/value pair of the view's key in the hash map
+   * If no key was found, nothing will happen to the hash map
+   **/
+  void remove(string_view key) noexcept {
+    this->template erase_impl<string_view>(key);
+  }
+
 #ifdef DS_TEST
   void print() const noexcept {
     printf("=== hash_map ===\n");
@@ -242,10 +382,14 @@ public:
       printf("No elements\n");
     }
     for (usize i = 0; i < this->capacity; ++i) {
+      if (this->distances[i] == HASHMAP_EMPTY_VALUE) {
+        printf(USIZE_FORMAT ": empty\n", i);
+        continue;
+      }
       printf(
-          USIZE_FORMAT ": (%s, %s) distance: %16llx\n", i,
+          USIZE_FORMAT ": (%s, %s) distance: %u\n", i,
           this->bucket[i].key.c_str(), this->bucket[i].value.c_str(),
-          this->bucket[i].distance
+          this->distances[i]
       );
     }
   }
@@ -258,11 +402,11 @@ protected:
     DS_TRY(this->check_allocation());
 
     if constexpr (std::is_rvalue_reference_v<Value_>) {
-      node_type node{.value = std::move(value), .distance = 0U};
+      node_type node{.value = std::move(value)};
       DS_TRY(node.key.copy(key));
       this->insert_node(std::move(node));
     } else {
-      node_type node{.distance = 0U};
+      node_type node{};
       DS_TRY(node.value.copy(value));
       DS_TRY(node.key.copy(key));
       this->insert_node(std::move(node));
@@ -277,11 +421,11 @@ protected:
     DS_TRY(this->check_allocation());
 
     if constexpr (std::is_rvalue_reference_v<Key_>) {
-      node_type node{.key = std::move(key), .distance = 0U};
+      node_type node{.key = std::move(key)};
       DS_TRY(node.value.copy(value));
       this->insert_node(std::move(node));
     } else {
-      node_type node{.distance = 0U};
+      node_type node{};
       DS_TRY(node.key.copy(key));
       DS_TRY(node.value.copy(value));
       this->insert_node(std::move(node));
@@ -290,51 +434,29 @@ protected:
     return error_codes::OK;
   }
 
-  template <typename Return>
-  [[nodiscard]] Return find_with_c8(const c8* key) const noexcept {
-    if (this->is_empty()) {
-      if constexpr (std::is_same_v<Return, string*>) {
-        return nullptr;
-      } else if constexpr (std::is_same_v<Return, bool>) {
-        return false;
-      }
-    }
-
-    // NOTE: No infinite loop since 1 node will always be empty in any case
-    for (usize index = this->calculate_hash_index(key);;) {
-      if (this->bucket[index].is_node_empty()) {
-        if constexpr (std::is_same_v<Return, string*>) {
-          return nullptr;
-        } else if constexpr (std::is_same_v<Return, bool>) {
-          return false;
-        }
-      }
-
-      if (KeyEqual()(key, this->bucket[index].key)) {
-        if constexpr (std::is_same_v<Return, string*>) {
-          return &this->bucket[index].value;
-        } else if constexpr (std::is_same_v<Return, bool>) {
-          return true;
-        }
-      }
-
-      if (++index >= this->capacity) {
-        index = 0U;
-      }
+  template <typename Return, typename Key_>
+  [[nodiscard]] Return find_with(Key_ key) const noexcept {
+    node_type* node = this->template find_node<Key_>(key);
+    if constexpr (std::is_same_v<Return, string*>) {
+      return node == nullptr ? nullptr : &node->value;
+    } else if constexpr (std::is_same_v<Return, bool>) {
+      return node != nullptr;
     }
   }
 };
 
 template <
     typename Derived, typename Value, typename Hash = hash<string>,
-    typename KeyEqual = equal<string>>
-class string_key_hash_map
-    : public base_hash_map<Derived, string, Value, Hash, KeyEqual> {
+    typename KeyEqual = equal<string>, typename Policy = prime_hash_policy,
+    typename Allocator = allocator<void>>
+class string_key_hash_map : public base_hash_map<
+                                Derived, string, Value, Hash, KeyEqual, Policy,
+                                Allocator> {
 public:
   using key_type = string;
   using value_type = Value;
-  using node_type =
-      typename base_hash_map<Derived, string, Value, Hash, KeyEqual>::node_type;
+  using node_type = typename base_hash_map<
+      Derived, string, Value, Hash, KeyEqual, Policy, Allocator>::node_type;
 
   // === Accessors === //
 
@@ -361,7 +483,7 @@ public:
    *   - error_codes::NOT_FOUND
    **/
   [[nodiscard]] expected<Value*, error_code> at(const c8* key) noexcept {
-    auto* value = this->find_with_c8<Value*>(key);
+    auto* value = this->find_with<Value*>(key);
     if (value == nullptr) {
       return unexpected<error_code>{error_codes::NOT_FOUND};
     }
@@ -385,7 +507,7 @@ public:
    *   else return nullptr
    **/
   [[nodiscard]] Value* operator[](const c8* key) noexcept {
-    return this->find_with_c8<Value*>(key);
+    return this->find_with<Value*>(key);
   }
 
   /**
@@ -393,7 +515,7 @@ public:
    *   else return nullptr
    **/
   [[nodiscard]] const Value* operator[](const c8* key) const noexcept {
-    return this->find_with_c8<Value*>(key);
+    return this->find_with<Value*>(key);
   }
 
   /**
@@ -407,7 +529,96 @@ public:
    * Checks if the value exists in the hash map
    **/
   [[nodiscard]] bool contains(const c8* key) const noexcept {
-    return this->find_with_c8<bool>(key);
+    return this->find_with<bool>(key);
+  }
+
+  /**
+   * Safe lookup with a view of the key, no copy of the key is made
+   *
+   * @errors
+   *   - error_codes::NOT_FOUND
+   **/
+  [[nodiscard]] expected<Value*, error_code> at(string_view key) noexcept {
+    auto* value = this->find_with<Value*>(key);
+    if (value == nullptr) {
+      return unexpected<error_code>{error_codes::NOT_FOUND};
+    }
+    return value;
+  }
+
+  /**
+   * Unsafe lookup with a view of the key - if a value was found then return
+   *   the value's address else return nullptr
+   **/
+  [[nodiscard]] Value* operator[](string_view key) noexcept {
+    return this->find_with<Value*>(key);
+  }
+
+  /**
+   * Unsafe lookup with a view of the key - if a value was found then return
+   *   the value's address else return nullptr
+   **/
+  [[nodiscard]] const Value* operator[](string_view key) const noexcept {
+    return this->find_with<Value*>(key);
+  }
+
+  /**
+   * Checks if the key of the view exists in the hash map
+   **/
+  [[nodiscard]] bool contains(string_view key) const noexcept {
+    return this->find_with<bool>(key);
+  }
+
+  /**
+   * Batched unsafe lookup - writes the value's address of each key in
+   *   `values`, nullptr if the key was not found
+   **/
+  void find_batch(const string* keys, usize count, Value** values) noexcept {
+    this->template find_batch_impl<string, Value*>(keys, count, values);
+  }
+
+  /**
+   * Batched unsafe lookup - writes the value's address of each key in
+   *   `values`, nullptr if the key was not found
+   **/
+  void find_batch(const c8* const* keys, usize count, Value** values) noexcept {
+    this->template find_batch_impl<const c8*, Value*>(keys, count, values);
+  }
+
+  /**
+   * Batched unsafe lookup - writes the value's address of each key in
+   *   `values`, nullptr if the key was not found
+   **/
+  void find_batch(const string* keys, usize count, const Value** values)
+      const noexcept {
+    this->template find_batch_impl<string, const Value*>(keys, count, values);
+  }
+
+  /**
+   * Batched unsafe lookup - writes the value's address of each key in
+   *   `values`, nullptr if the key was not found
+   **/
+  void find_batch(const c8* const* keys, usize count, const Value** values)
+      const noexcept {
+    this->template find_batch_impl<const c8*, const Value*>(
+        keys, count, values
+    );
+  }
+
+  /**
+   * Batched check if each key exists in the hash map
+   **/
+  void contains_batch(const string* keys, usize count, bool* found)
+      const noexcept {
+    this->template find_batch_impl<string, bool>(keys, count, found);
+  }
+
+  /**
+   * Batched check if each key exists in the hash map
+   **/
+  void contains_batch(const c8* const* keys, usize count, bool* found)
+      const noexcept {
+    this->template find_batch_impl<const c8*, bool>(keys, count, found);
   }
 
   // === Mutations === //
@@ -468,6 +679,45 @@ public:
     return this->insert_c8_key_impl<Value&&>(key, std::move(value));
   }
 
+  /**
+   * Gets the value of the key, a default constructed value is inserted first
+   *   if the key does not exist yet
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION - bucket resize or key copy
+   *  - error_codes::CONTAINER_FULL - max limit of hash_map
+   **/
+  [[nodiscard]] expected<Value*, error_code>
+  get_or_insert(const string& key) noexcept {
+    return this->template emplace_impl<const string&>(key);
+  }
+
+  /**
+   * Gets the value of the key, a default constructed value is inserted first
+   *   if the key does not exist yet
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION - bucket resize
+   *  - error_codes::CONTAINER_FULL - max limit of hash_map
+   **/
+  [[nodiscard]] expected<Value*, error_code>
+  get_or_insert(string&& key) noexcept {
+    return this->template emplace_impl<string&&>(std::move(key));
+  }
+
+  /**
+   * Gets the value of the key, a default constructed value is inserted first
+   *   if the key does not exist yet. The key is only copied when inserted.
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION - bucket resize or key copy
+   *  - error_codes::CONTAINER_FULL - max limit of hash_map
+   **/
+  [[nodiscard]] expected<Value*, error_code>
+  get_or_insert(const c8* key) noexcept {
+    return this->template emplace_impl<const c8*>(key);
+  }
+
   /**
    * Removes a key/value pair in the hash map
    * If no key was found, nothing will happen to the hash map
@@ -484,6 +734,14 @@ public:
     this->template erase_impl<const c8*>(key);
   }
 
+  /**
+   * Removes the key/value pair of the view's key in the hash map
+   * If no key was found, nothing will happen to the hash map
+   **/
+  void remove(string_view key) noexcept {
+    this->template erase_impl<string_view>(key);
+  }
+
 #ifdef DS_TEST
   void print() const noexcept {
     printf("=== hash_map ===\n");
@@ -491,10 +749,14 @@ public:
       printf("No elements\n");
     }
     for (usize i = 0; i < this->capacity; ++i) {
+      if (this->distances[i] == HASHMAP_EMPTY_VALUE) {
+        printf(USIZE_FORMAT ": empty\n", i);
+        continue;
+      }
       printf(
-          USIZE_FORMAT ": (%s, %16llx) distance: %16llx\n", i,
+          USIZE_FORMAT ": (%s, %16llx) distance: %u\n", i,
           this->bucket[i].key.c_str(), this->bucket[i].value,
-          this->bucket[i].distance
+          this->distances[i]
       );
     }
   }
@@ -507,11 +769,11 @@ protected:
     DS_TRY(this->check_allocation());
 
     if constexpr (std::is_rvalue_reference_v<Value_>) {
-      node_type node{.value = std::move(value), .distance = 0U};
+      node_type node{.value = std::move(value)};
       DS_TRY(node.key.copy(key));
       this->insert_node(std::move(node));
     } else {
-      node_type node{.distance = 0U};
+      node_type node{};
       DS_TRY(node.key.copy(key));
       if constexpr (!std::is_class_v<value_type>) {
         node.value = value;
@@ -524,52 +786,29 @@ protected:
     return error_codes::OK;
   }
 
-  template <typename Return>
-  [[nodiscard]] Return find_with_c8(const c8* key) const noexcept {
-    if (this->is_empty()) {
-      if constexpr (std::is_same_v<Return, Value*>) {
-        return nullptr;
-      } else if constexpr (std::is_same_v<Return, bool>) {
-        return false;
-      }
-    }
-
-    // NOTE: No infinite loop since 1 node will always be empty in any case
-    for (usize index = this->calculate_hash_index(key);;) {
-      if (this->bucket[index].is_node_empty()) {
-        if constexpr (std::is_same_v<Return, Value*>) {
-          return nullptr;
-        } else if constexpr (std::is_same_v<Return, bool>) {
-          return false;
-        }
-      }
-
-      if (KeyEqual()(key, this->bucket[index].key)) {
-        if constexpr (std::is_same_v<Return, Value*>) {
-          return &this->bucket[index].value;
-        } else if constexpr (std::is_same_v<Return, bool>) {
-          return true;
-        }
-      }
-
-      ++index;
-      if (index >= this->capacity) {
-        index = 0U;
-      }
+  template <typename Return, typename Key_>
+  [[nodiscard]] Return find_with(Key_ key) const noexcept {
+    node_type* node = this->template find_node<Key_>(key);
+    if constexpr (std::is_same_v<Return, Value*>) {
+      return node == nullptr ? nullptr : &node->value;
+    } else if constexpr (std::is_same_v<Return, bool>) {
+      return node != nullptr;
     }
   }
 };
 
 template <
     typename Derived, typename Key, typename Hash = hash<Key>,
-    typename KeyEqual = equal<Key>>
-class string_value_hash_map
-    : public base_hash_map<Derived, Key, string, Hash, KeyEqual> {
+    typename KeyEqual = equal<Key>, typename Policy = prime_hash_policy,
+    typename Allocator = allocator<void>>
+class string_value_hash_map : public base_hash_map<
+                                  Derived, Key, string, Hash, KeyEqual, Policy,
+                                  Allocator> {
 public:
   using key_type = Key;
   using value_type = string;
-  using node_type =
-      typename base_hash_map<Derived, Key, string, Hash, KeyEqual>::node_type;
+  using node_type = typename base_hash_map<
+      Derived, Key, string, Hash, KeyEqual, Policy, Allocator>::node_type;
 
   // === Mutations === //
 
@@ -652,11 +891,11 @@ protected:
     DS_TRY(this->check_allocation());
 
     if constexpr (std::is_rvalue_reference_v<Key_>) {
-      node_type node{.key = std::move(key), .distance = 0U};
+      node_type node{.key = std::move(key)};
       DS_TRY(node.value.copy(value));
       this->insert_node(std::move(node));
     } else {
-      node_type node{.distance = 0U};
+      node_type node{};
       if constexpr (!std::is_class_v<key_type>) {
         node.key = key;
       } else {
@@ -672,10 +911,12 @@ protected:
 
 // === hash_map string specializations === //
 
-template <typename Hash, typename KeyEqual>
-class hash_map<string, string, Hash, KeyEqual>
+template <
+    typename Hash, typename KeyEqual, typename Policy, typename Allocator>
+class hash_map<string, string, Hash, KeyEqual, Policy, Allocator>
     : public string_hash_map<
-          hash_map<string, string, Hash, KeyEqual>, Hash, KeyEqual> {};
+          hash_map<string, string, Hash, KeyEqual, Policy, Allocator>, Hash,
+          KeyEqual, Policy, Allocator> {};
 
 template <typename Hash>
 class hash_map<string, string, Hash>
@@ -685,10 +926,13 @@ template <>
 class hash_map<string, string>
     : public string_hash_map<hash_map<string, string>> {};
 
-template <typename Value, typename Hash, typename KeyEqual>
-class hash_map<string, Value, Hash, KeyEqual>
+template <
+    typename Value, typename Hash, typename KeyEqual, typename Policy,
+    typename Allocator>
+class hash_map<string, Value, Hash, KeyEqual, Policy, Allocator>
     : public string_key_hash_map<
-          hash_map<string, Value, Hash, KeyEqual>, Value, Hash, KeyEqual> {};
+          hash_map<string, Value, Hash, KeyEqual, Policy, Allocator>, Value,
+          Hash, KeyEqual, Policy, Allocator> {};
 
 template <typename Value, typename Hash>
 class hash_map<string, Value, Hash>
@@ -698,10 +942,13 @@ template <typename Value>
 class hash_map<string, Value>
     : public string_key_hash_map<hash_map<string, Value>, Value> {};
 
-template <typename Key, typename Hash, typename KeyEqual>
-class hash_map<Key, string, Hash, KeyEqual>
+template <
+    typename Key, typename Hash, typename KeyEqual, typename Policy,
+    typename Allocator>
+class hash_map<Key, string, Hash, KeyEqual, Policy, Allocator>
     : public string_value_hash_map<
-          hash_map<Key, string, Hash, KeyEqual>, Key, Hash, KeyEqual> {};
+          hash_map<Key, string, Hash, KeyEqual, Policy, Allocator>, Key, Hash,
+          KeyEqual, Policy, Allocator> {};
 
 template <typename Key, typename Hash>
 class hash_map<Key, string, Hash>
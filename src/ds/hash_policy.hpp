@@ -0,0 +1,155 @@
+/*===============================*
+ * Author/s:
+ *  - silentrald
+ * Version: 1.0
+ * Created: 2024-10-15
+ *===============================*/
+
+#ifndef DS_HASH_POLICY_HPP
+#define DS_HASH_POLICY_HPP
+
+#include "./hash.hpp"
+#include "./prime.hpp"
+#include "./types.hpp"
+#include <bit>
+
+namespace ds {
+
+/**
+ * Bucket sizing policies for the hash containers, decides the capacity of the
+ *   bucket and how a hash is turned into a bucket index
+ *
+ * Policy requirements:
+ *  - static usize get_first_capacity() noexcept
+ *  - static usize get_next_capacity(usize capacity) noexcept
+ *  - static usize get_index(usize hash, usize capacity) noexcept
+ *  - static constexpr bool INCREMENTAL_REHASH
+ *  - static constexpr usize MIGRATE_COUNT, if INCREMENTAL_REHASH is true
+ *  - static constexpr bool STORE_HASH
+ *  - static constexpr bool RANDOM_SEED
+ **/
+
+/**
+ * Prime capacities with a modulo on the hash, spreads out poorly distributed
+ *   hashes but pays for an integer division on every lookup
+ **/
+class prime_hash_policy {
+public:
+  static constexpr bool INCREMENTAL_REHASH = false;
+  static constexpr bool STORE_HASH = false;
+  static constexpr bool RANDOM_SEED = false;
+
+  [[nodiscard]] static usize get_first_capacity() noexcept {
+    return get_first_prime();
+  }
+
+  [[nodiscard]] static usize get_next_capacity(usize capacity) noexcept {
+    return capacity * 2U + 1U;
+  }
+
+  [[nodiscard]] static usize get_index(usize hash, usize capacity) noexcept {
+    return hash % capacity;
+  }
+};
+
+// 2^64 / golden ratio, rounded to an odd number
+#ifdef BIT_64
+inline const usize FIBONACCI_MULTIPLIER = 11'400'714'819'323'198'485ULL;
+#else
+inline const usize FIBONACCI_MULTIPLIER = 2'654'435'769U;
+#endif
+
+/**
+ * Power of two capacities with fibonacci hashing, the hash is mixed with a
+ *   multiply and the top bits are used as the index. The mixing is needed since
+ *   hash<T> is the identity for integers, so a plain mask would only use the
+ *   low bits of the key.
+ *
+ * References:
+ *  https://probablydance.com/2018/06/16/fibonacci-hashing-the-optimization-that-the-world-forgot-or-a-better-alternative-to-integer-modulo/
+ **/
+class power_of_two_hash_policy {
+public:
+  static constexpr bool INCREMENTAL_REHASH = false;
+  static constexpr bool STORE_HASH = false;
+  static constexpr bool RANDOM_SEED = false;
+
+  [[nodiscard]] static usize get_first_capacity() noexcept {
+    return 16U; // NOLINT
+  }
+
+  [[nodiscard]] static usize get_next_capacity(usize capacity) noexcept {
+    return capacity * 2U;
+  }
+
+  [[nodiscard]] static usize get_index(usize hash, usize capacity) noexcept {
+    // NOTE: capacity - 1 is the mask of the index, the leading zeroes of the
+    //   mask is the shift needed to keep only the top bits of the product
+    return (hash * FIBONACCI_MULTIPLIER) >> std::countl_zero(capacity - 1U);
+  }
+};
+
+/**
+ * Spreads the rehash of a growing hash_map over the next inserts instead of
+ *   moving every node in a single insert. The old bucket stays alive and is
+ *   checked by lookups until all of its nodes are migrated.
+ *
+ * NOTE: Only used by hash_map, hash_set always rehashes in a single insert
+ **/
+template <typename Policy, usize MigrateCount = 16U>
+class incremental_hash_policy : public Policy {
+public:
+  static constexpr bool INCREMENTAL_REHASH = true;
+  // Minimum number of old bucket slots migrated on each insert
+  static constexpr usize MIGRATE_COUNT = MigrateCount;
+};
+
+/**
+ * Keeps the full hash of each key in its node. Growing the bucket reuses the
+ *   stored hash instead of hashing every key again, and probes compare the
+ *   hashes before comparing the keys. Worth it for keys that are expensive to
+ *   hash or compare like strings, costs a usize per node.
+ **/
+template <typename Policy> class stored_hash_policy : public Policy {
+public:
+  static constexpr bool STORE_HASH = true;
+};
+
+/**
+ * Gives every container its own random seed, drawn from the OS when the
+ *   container is constructed. Hashes that take a seed (see seeded_hash) are
+ *   seeded with it, the others are mixed with it after hashing. Someone who
+ *   knows the hash function can no longer craft keys that land in the same
+ *   slots, which would push the probes to O(n). Costs a usize per container
+ *   and a getrandom call per construction.
+ *
+ * NOTE: Copies keep the seed of the copied container so the bucket layout can
+ *   be reused, batched lookups hash their keys one at a time
+ **/
+template <typename Policy> class seeded_hash_policy : public Policy {
+public:
+  static constexpr bool RANDOM_SEED = true;
+};
+
+/**
+ * Hash stored in a node of the hash containers, empty if the policy does not
+ *   store hashes
+ **/
+template <bool Enabled> struct stored_hash {
+  usize value = 0U;
+};
+
+template <> struct stored_hash<false> {};
+
+/**
+ * Seed of a hash container, empty if the policy does not seed each container
+ **/
+template <bool Enabled> struct table_seed {
+  usize value = random_seed();
+};
+
+template <> struct table_seed<false> {};
+
+} // namespace ds
+
+#endif
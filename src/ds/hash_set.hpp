@@ -8,12 +8,16 @@
 #ifndef DS_HASH_SET_HPP
 #define DS_HASH_SET_HPP
 
+#include "./allocator.hpp"
 #include "./equal.hpp"
 #include "./hash.hpp"
+#include "./hash_policy.hpp"
+#include "./hash_stats.hpp"
 #include "./hash_set_iterator.hpp"
-#include "prime.hpp"
+#include "./prefetch.hpp"
 #include "types.hpp"
 #include <cstdlib>
+#include <cstring>
 #include <type_traits>
 #include <utility>
 
@@ -23,10 +27,17 @@
 
 namespace ds {
 
+// Default max load factor, can be changed per hash set with set_max_load_factor
 inline const f32 HASHSET_LOAD_FACTOR = 0.9F;
 inline const usize HASHSET_MAX_SIZE = USIZE_MAX - 1U;
-// Indicator if the node is empty or not
-inline const usize HASHSET_EMPTY_VALUE = USIZE_MAX;
+// Indicator if the node is empty or not, distances are stored with an offset of
+// 1 so an empty slot can be marked with 0
+inline const u8 HASHSET_EMPTY_VALUE = 0U;
+// Largest distance that fits in a byte, the distance of a node further away
+// from its hashed index is saturated to it and computed again from its hash
+inline const u8 HASHSET_MAX_DISTANCE = UINT8_MAX;
+// Number of keys hashed and prefetched together by the batched lookups
+inline const usize HASHSET_BATCH_SIZE = 16U;
 
 /**
  * Hash map / table implementation with robin hood hashing
@@ -35,33 +46,34 @@ inline const usize HASHSET_EMPTY_VALUE = USIZE_MAX;
  * References:
  *  https://programming.guide/robin-hood-hashing.html
  *  https://codecapsule.com/2013/11/17/robin-hood-hashing-backward-shift-deletion
+ *
+ * Policy decides the bucket capacities and how hashes map to an index, see
+ *   hash_policy.hpp
+ *
+ * Allocator provides the memory of the bucket, the nodes and the distances of
+ *   a bucket are a single allocation
  **/
 template <
     typename Derived, typename Key, typename Hash = hash<Key>,
-    typename KeyEqual = equal<Key>>
+    typename KeyEqual = equal<Key>, typename Policy = prime_hash_policy,
+    typename Allocator = allocator<void>>
 class base_hash_set {
 public:
   friend Derived;
 
   using key_type = Key;
 
+  // NOTE: The probe distance of each node is stored in a separate byte array
+  //   so small keys do not pay for the alignment padding
   struct node_type {
     Key key{};
-    usize distance = HASHSET_EMPTY_VALUE;
-
-    void to_empty() noexcept {
-      this->distance = HASHSET_EMPTY_VALUE;
-    }
-
-    [[nodiscard]] bool is_node_empty() const noexcept {
-      return this->distance == HASHSET_EMPTY_VALUE;
-    }
+    [[no_unique_address]] stored_hash<Policy::STORE_HASH> hash{};
   };
 
-  using iterator =
-      hash_set_iterator<base_hash_set<Derived, Key, Hash, KeyEqual>>;
-  using citerator =
-      hash_set_const_iterator<base_hash_set<Derived, Key, Hash, KeyEqual>>;
+  using iterator = hash_set_iterator<
+      base_hash_set<Derived, Key, Hash, KeyEqual, Policy, Allocator>>;
+  using citerator = hash_set_const_iterator<
+      base_hash_set<Derived, Key, Hash, KeyEqual, Policy, Allocator>>;
 
   base_hash_set() noexcept = default;
   base_hash_set(const base_hash_set&) = delete;
@@ -70,23 +82,58 @@ public:
   // === Copy ===
 
   /**
-   * Copies the hash map
+   * Copies the hash set slot for slot, the bucket layout is kept so no key is
+   *   hashed or probed again. Trivially copyable nodes are copied with a
+   *   single memcpy. The hash set is cleared if a key copy fails.
    *
    * @errors
-   *  - error_codes::BAD_ALLOCATION - bucket resize
+   *  - error_codes::BAD_ALLOCATION - bucket resize or key copy
+   *  - error_code from copy for key
    **/
   [[nodiscard]] error_code copy(const base_hash_set& other) noexcept {
-    return error_codes::NOT_IMPLEMENTED;
+    if (this == &other) {
+      return error_codes::OK;
+    }
+
+    this->max_load_factor = other.max_load_factor;
+    if (other.bucket == nullptr) {
+      this->destroy();
+      return error_codes::OK;
+    }
+
+    this->clear();
+    // NOTE: The slots are copied as is, so they need the same seed
+    this->seed = other.seed;
+    if (this->capacity != other.capacity) {
+      this->destroy();
+      DS_TRY(this->allocate(other.capacity));
+    }
+
+    if (auto error = this->copy_bucket(other)) {
+      this->clear();
+      return error;
+    }
+    this->size = other.size;
+    this->max_size = other.max_size;
+
+    return error_codes::OK;
   }
 
   // === Move ===
 
   base_hash_set(base_hash_set&& other) noexcept
       : bucket(other.bucket),
+        distances(other.distances),
         size(other.size),
         max_size(other.max_size),
-        capacity(other.capacity) {
+        capacity(other.capacity),
+        max_load_factor(other.max_load_factor),
+        seed(other.seed) {
+#ifdef DS_HASH_STATS
+    this->counters = other.counters;
+#endif
     other.bucket = nullptr;
+    other.distances = nullptr;
   }
 
   base_hash_set& operator=(base_hash_set&& rhs) noexcept {
@@ -95,10 +142,17 @@ public:
     }
 
     this->bucket = rhs.bucket;
+    this->distances = rhs.distances;
     this->size = rhs.size;
     this->max_size = rhs.max_size;
     this->capacity = rhs.capacity;
+    this->max_load_factor = rhs.max_load_factor;
+    this->seed = rhs.seed;
+#ifdef DS_HASH_STATS
+    this->counters = rhs.counters;
+#endif
     rhs.bucket = nullptr;
+    rhs.distances = nullptr;
 
     return *this;
   }
@@ -117,28 +171,22 @@ public:
       return;
     }
 
-    if constexpr (std::is_class_v<Key>) {
-      for (usize i = 0; i < this->capacity; ++i) {
-        this->bucket[i].~node_type();
-      }
-    }
-
-    std::free(this->bucket); // NOLINT
+    this->deallocate(this->bucket, this->capacity);
     this->bucket = nullptr;
+    this->distances = nullptr;
     this->size = this->max_size = this->capacity = 0U;
   }
 
   /**
-   * Removes all elements without destroying each nodes.
+   * Removes all elements while keeping the bucket
    **/
   void clear() noexcept {
     if (this->bucket == nullptr) {
       return;
     }
 
-    for (usize i = 0; i < this->capacity; ++i) {
-      this->bucket[i].to_empty();
-    }
+    destroy_nodes(this->bucket, this->distances, this->capacity);
+    std::memset(this->distances, HASHSET_EMPTY_VALUE, this->capacity);
     this->size = 0U;
   }
 
@@ -150,7 +198,7 @@ public:
    * @return iterator
    **/
   [[nodiscard]] iterator begin() noexcept {
-    return iterator{this->bucket, this->capacity};
+    return iterator{this->bucket, this->distances, this->capacity};
   }
 
   /**
@@ -159,7 +207,7 @@ public:
    * @return citerator
    **/
   [[nodiscard]] citerator cbegin() const noexcept {
-    return citerator{this->bucket, this->capacity};
+    return citerator{this->bucket, this->distances, this->capacity};
   }
 
   /**
@@ -200,6 +248,81 @@ public:
     return this->capacity;
   }
 
+  [[nodiscard]] f32 get_max_load_factor() const noexcept {
+    return this->max_load_factor;
+  }
+
+  /**
+   * Sets the ratio of keys to bucket slots the hash set grows at, lower values
+   *   trade memory for shorter probe sequences. Rehashes right away if the
+   *   keys no longer fit the bucket.
+   *
+   * @errors
+   *  - error_codes::INVALID_ARGUMENT - load factor is not between 0 and 1
+   *  - error_codes::BAD_ALLOCATION
+   **/
+  [[nodiscard]] error_code set_max_load_factor(f32 load_factor) noexcept {
+    if (!(load_factor > 0.0F && load_factor < 1.0F)) {
+      return error_codes::INVALID_ARGUMENT;
+    }
+
+    this->max_load_factor = load_factor;
+    if (this->bucket == nullptr) {
+      return error_codes::OK;
+    }
+
+    this->max_size = this->get_max_size(this->capacity);
+    return this->reserve(this->size);
+  }
+
+  /**
+   * Grows the bucket once so `count` keys can be inserted without any rehash,
+   *   does nothing if they already fit
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION
+   *  - error_codes::CONTAINER_FULL - max limit of hash_set
+   **/
+  [[nodiscard]] error_code reserve(usize count) noexcept {
+    if (count > HASHSET_MAX_SIZE) {
+      return error_codes::CONTAINER_FULL;
+    }
+
+    usize new_capacity = this->get_fitting_capacity(count);
+    if (new_capacity == 0U) {
+      return error_codes::BAD_ALLOCATION;
+    }
+
+    if (this->bucket == nullptr) {
+      return this->allocate(new_capacity);
+    }
+
+    if (count <= this->max_size) {
+      return error_codes::OK;
+    }
+    return this->reallocate(new_capacity);
+  }
+
+  /**
+   * Rehashes to the smallest capacity that fits the keys, the bucket is freed
+   *   if the hash set is empty
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION
+   **/
+  [[nodiscard]] error_code shrink_to_fit() noexcept {
+    if (this->is_empty()) {
+      this->destroy();
+      return error_codes::OK;
+    }
+
+    usize new_capacity = this->get_fitting_capacity(this->size);
+    if (new_capacity >= this->capacity) {
+      return error_codes::OK;
+    }
+    return this->reallocate(new_capacity);
+  }
+
   // === Modifiers ===
 
   /**
@@ -239,9 +362,36 @@ public:
    * Checks if the value exists in the hash map
    **/
   [[nodiscard]] bool contains(const Key& key) const noexcept {
-    return this->find(key);
+    return this->find<const Key&>(key);
   }
 
+  /**
+   * Batched check if each key exists in the hash set
+   *
+   * The slots of the keys are prefetched before probing so the cache misses
+   *   of a batch overlap instead of waiting on each other
+   **/
+  void
+  contains_batch(const Key* keys, usize count, bool* found) const noexcept {
+    this->contains_batch_impl<Key>(keys, count, found);
+  }
+
+#ifdef DS_HASH_STATS
+  /**
+   * Collects the probe lengths, clusters and memory of the hash set, walks
+   *   every slot of the bucket so it is not meant for hot paths
+   **/
+  [[nodiscard]] hash_stats get_stats() const noexcept {
+    hash_stats stats{};
+    collect_bucket_stats(
+        stats, this->distances, this->capacity, sizeof(node_type)
+    );
+    stats.resizes = this->counters.resizes;
+    stats.rehashed = this->counters.rehashed;
+    return stats;
+  }
+#endif
+
 #ifdef DS_TEST
   void print() const noexcept {
     printf("=== hash_map ===\n");
@@ -249,9 +399,13 @@ public:
       printf("No elements\n");
     }
     for (usize i = 0; i < this->capacity; ++i) {
+      if (this->distances[i] == HASHSET_EMPTY_VALUE) {
+        printf(USIZE_FORMAT ": empty\n", i);
+        continue;
+      }
       printf(
-          USIZE_FORMAT ": (%16llx, %16llx) distance: %16llx\n", i,
-          this->bucket[i].key, this->bucket[i].value, this->bucket[i].distance
+          USIZE_FORMAT ": (%16llx) distance: %u\n", i, this->bucket[i].key,
+          this->distances[i]
       );
     }
   }
@@ -259,41 +413,147 @@ public:
 
 protected:
   node_type* bucket = nullptr;
+  // Probe distance + 1 of each node in the bucket, 0 if the node is empty
+  u8* distances = nullptr;
   usize size = 0U;
   usize max_size = 0U;
   usize capacity = 0U;
+  f32 max_load_factor = HASHSET_LOAD_FACTOR;
+  [[no_unique_address]] table_seed<Policy::RANDOM_SEED> seed{};
+#ifdef DS_HASH_STATS
+  hash_counters counters{};
+#endif
 
   // === Helpers === //
 
   /**
-   * Calculates the hash for the value, which already resizes the index within
-   * the range of the bucket count
+   * Gets the hash of the node's key, reuses the stored hash if the policy keeps
+   *   one in the node
+   **/
+  [[nodiscard]] usize get_node_hash(const node_type& node) const noexcept {
+    if constexpr (Policy::STORE_HASH) {
+      return node.hash.value;
+    } else {
+      return this->hash_key(node.key);
+    }
+  }
+
+  /**
+   * Hashes the key with the seed of the container if the policy gives it one
    **/
   template <typename Key_>
-  [[nodiscard]] usize calculate_hash_index(Key_ key) const noexcept {
-    return Hash{}(key) % this->capacity;
+  [[nodiscard]] usize hash_key(const Key_& key) const noexcept {
+    if constexpr (!Policy::RANDOM_SEED) {
+      return Hash{}(key);
+    } else if constexpr (seeded_hash<Hash, Key_>) {
+      return Hash{}(key, this->seed.value);
+    } else {
+      return hash_combine(this->seed.value, Hash{}(key));
+    }
+  }
+
+  /**
+   * Gets the hash is_node_key compares, it is only read if the policy stores
+   *   it in the node so the key is never hashed for it
+   **/
+  [[nodiscard]] static usize get_stored_hash(const node_type& node) noexcept {
+    if constexpr (Policy::STORE_HASH) {
+      return node.hash.value;
+    } else {
+      return 0U;
+    }
+  }
+
+  /**
+   * Compares the key with the node's key, the stored hashes are compared first
+   *   so most mismatches skip the key comparison
+   **/
+  template <typename Key_>
+  [[nodiscard]] static bool
+  is_node_key(Key_ key, usize hash, const node_type& node) noexcept {
+    if constexpr (Policy::STORE_HASH) {
+      if (node.hash.value != hash) {
+        return false;
+      }
+    }
+    return KeyEqual()(key, node.key);
+  }
+
+  /**
+   * Value stored in the distances, saturated at HASHSET_MAX_DISTANCE
+   **/
+  [[nodiscard]] static u8 saturate_distance(usize distance) noexcept {
+    return distance < HASHSET_MAX_DISTANCE ? (u8)distance
+                                           : HASHSET_MAX_DISTANCE;
+  }
+
+  /**
+   * Probe distance + 1 of the node in the slot, a saturated distance is
+   *   computed again from the hash of the node
+   **/
+  [[nodiscard]] usize get_distance(usize index) const noexcept {
+    if (this->distances[index] < HASHSET_MAX_DISTANCE) [[likely]] {
+      return this->distances[index];
+    }
+    return this->get_hashed_distance(index);
   }
 
+  /**
+   * Probe distance + 1 of the node in the slot computed from its hash
+   **/
+  [[nodiscard]] usize get_hashed_distance(usize index) const noexcept {
+    usize capacity = this->capacity;
+    usize hashed =
+        Policy::get_index(get_node_hash(this->bucket[index]), capacity);
+    return (index >= hashed ? index - hashed : index + capacity - hashed) + 1U;
+  }
+
+  /**
+   * Places a new node in the bucket, check_allocation should be called before
+   * this so the bucket always has an empty slot
+   **/
   void insert_node(node_type&& node) noexcept {
+    usize hash = this->hash_key(node.key);
+    if constexpr (Policy::STORE_HASH) {
+      node.hash.value = hash;
+    }
+
+    this->place_node(node, hash);
+  }
+
+  /**
+   * Places the node in the bucket, `hash` is the hash of the node's key so it
+   *   is not computed again
+   **/
+  void place_node(node_type& node, usize hash) noexcept {
+    usize distance = 1U;
+
     // NOTE: No infinite loop since 1 node will always be empty in any case
-    for (usize index = this->calculate_hash_index<const Key&>(node.key);;) {
+    for (usize index = Policy::get_index(hash, this->capacity);;) {
       // Place the node on an empty bucket slot
-      if (this->bucket[index].is_node_empty()) {
-        this->bucket[index] = std::move(node);
+      if (this->distances[index] == HASHSET_EMPTY_VALUE) {
+        new (this->bucket + index) node_type(std::move(node));
+        this->distances[index] = saturate_distance(distance);
         ++this->size;
-        break;
+        return;
       }
 
-      // If the key already exists, overwrite the value
-      if (KeyEqual()(node.key, this->bucket[index].key)) {
-        break;
+      // If the key already exists, nothing to place
+      if (is_node_key<const Key&>(node.key, hash, this->bucket[index])) {
+        return;
       }
 
       // Swapping between the `rich` and `poor` nodes
-      if (node.distance > this->bucket[index].distance) {
-        std::swap(node, this->bucket[index]);
+      if (distance > this->distances[index]) {
+        usize resident = this->get_distance(index);
+        if (distance > resident) {
+          std::swap(node, this->bucket[index]);
+          hash = get_stored_hash(node);
+          this->distances[index] = saturate_distance(distance);
+          distance = resident;
+        }
       }
-      ++node.distance;
+      ++distance;
 
       if (++index >= this->capacity) {
         index = 0;
@@ -312,7 +572,7 @@ protected:
   [[nodiscard]] error_code insert_impl(const Key& key) noexcept {
     DS_TRY(this->check_allocation());
 
-    node_type node{.distance = 0U};
+    node_type node{};
     if constexpr (!std::is_class_v<Key>) {
       node.key = key;
     } else {
@@ -333,20 +593,28 @@ protected:
    **/
   [[nodiscard]] error_code insert_impl(Key&& key) noexcept {
     DS_TRY(this->check_allocation());
-    this->insert_node(node_type{.key = std::move(key), .distance = 0U});
+    this->insert_node(node_type{.key = std::move(key)});
     return error_codes::OK;
   }
 
   template <typename Key_> void erase_impl(Key_ key) noexcept {
-    usize index = this->calculate_hash_index<Key_>(key);
+    if (this->is_empty()) {
+      return;
+    }
+
+    usize hash = this->hash_key(key);
+    usize index = Policy::get_index(hash, this->capacity);
 
     // NOTE: No infinite loop since 1 node will always be empty in any case
-    while (true) {
-      if (this->bucket[index].is_node_empty()) {
+    for (usize distance = 1U;; ++distance) {
+      // Robin hood invariant, the key would have displaced a richer node
+      // NOTE: This also covers empty nodes since their distance is 0
+      if (distance > this->distances[index] &&
+          distance > this->get_distance(index)) {
         return;
       }
 
-      if (KeyEqual()(key, this->bucket[index].key)) {
+      if (is_node_key<Key_>(key, hash, this->bucket[index])) {
         --this->size;
         break;
       }
@@ -358,46 +626,79 @@ protected:
 
     // Backward shift delete algorithm
 
+    // NOTE: Empty nodes (0) and nodes in their original hash (1) stop the shift
+
     // index -> capacity
     for (++index; index < this->capacity; ++index) {
-      if (this->bucket[index].is_node_empty() ||
-          this->bucket[index].distance == 0U) {
-        this->bucket[index - 1U].to_empty();
+      if (this->distances[index] <= 1U) {
+        this->distances[index - 1U] = HASHSET_EMPTY_VALUE;
+        destroy_node(this->bucket[index - 1U]);
         return;
       }
-      --this->bucket[index].distance;
-      this->bucket[index - 1U] = std::move(this->bucket[index]);
+      this->shift_node(index, index - 1U);
     }
 
     // capacity -> 0
-    if (this->bucket[0].is_node_empty() || this->bucket[0].distance == 0U) {
-      this->bucket[this->capacity - 1U].to_empty();
+    if (this->distances[0] <= 1U) {
+      this->distances[this->capacity - 1U] = HASHSET_EMPTY_VALUE;
+      destroy_node(this->bucket[this->capacity - 1U]);
       return;
     }
-    --this->bucket[0].distance;
-    this->bucket[this->capacity - 1U] = std::move(this->bucket[0]);
+    this->shift_node(0U, this->capacity - 1U);
 
     // 0 -> original hash
     // NOTE: No infinite loop since 1 node will always be empty in any case
     for (index = 1U;; ++index) {
-      if (this->bucket[index].is_node_empty() ||
-          this->bucket[index].distance == 0U) {
-        this->bucket[index - 1U].to_empty();
+      if (this->distances[index] <= 1U) {
+        this->distances[index - 1U] = HASHSET_EMPTY_VALUE;
+        destroy_node(this->bucket[index - 1U]);
         return;
       }
-      --this->bucket[index].distance;
-      this->bucket[index - 1U] = std::move(this->bucket[index]);
+      this->shift_node(index, index - 1U);
     }
   }
 
-  [[nodiscard]] bool find(const Key& key) const noexcept {
+  /**
+   * Moves the node a slot back to `to`, a saturated distance is computed
+   *   again once the node is in its new slot
+   **/
+  void shift_node(usize from, usize to) noexcept {
+    this->bucket[to] = std::move(this->bucket[from]);
+    if (this->distances[from] < HASHSET_MAX_DISTANCE) [[likely]] {
+      this->distances[to] = this->distances[from] - 1U;
+      return;
+    }
+    this->distances[to] = saturate_distance(this->get_hashed_distance(to));
+  }
+
+  template <typename Key_>
+  [[nodiscard]] bool find(Key_ key) const noexcept {
+    if (this->is_empty()) {
+      return false;
+    }
+
+    usize hash = this->hash_key(key);
+    return this->find_from<Key_>(
+        key, hash, Policy::get_index(hash, this->capacity)
+    );
+  }
+
+  /**
+   * Probes the bucket for the key starting from its hashed index
+   **/
+  template <typename Key_>
+  [[nodiscard]] bool
+  find_from(Key_ key, usize hash, usize index) const noexcept {
     // NOTE: No infinite loop since 1 node will always be empty in any case
-    for (usize index = this->calculate_hash_index<const Key&>(key);;) {
-      if (this->bucket[index].is_node_empty()) {
+    for (usize distance = 1U;; ++distance) {
+      // Robin hood invariant, the key would have displaced a richer node
+      // NOTE: This also covers empty nodes since their distance is 0
+      if (distance > this->distances[index] &&
+          distance > this->get_distance(index)) {
         return false;
       }
 
-      if (KeyEqual()(key, this->bucket[index].key)) {
+      if (is_node_key<Key_>(key, hash, this->bucket[index])) {
         return true;
       }
 
@@ -407,17 +708,88 @@ protected:
     }
   }
 
+  /**
+   * Checks the keys in batches of HASHSET_BATCH_SIZE. Every key of a batch is
+   *   hashed and its slot prefetched first, then the probes are resolved.
+   **/
+  template <typename Key_>
+  void contains_batch_impl(const Key_* keys, usize count, bool* found)
+      const noexcept {
+    if (this->is_empty()) {
+      for (usize i = 0U; i < count; ++i) {
+        found[i] = false;
+      }
+      return;
+    }
+
+    usize hashes[HASHSET_BATCH_SIZE];  // NOLINT
+    usize indices[HASHSET_BATCH_SIZE]; // NOLINT
+    for (usize start = 0U; start < count; start += HASHSET_BATCH_SIZE) {
+      usize batch = count - start < HASHSET_BATCH_SIZE ? count - start
+                                                       : HASHSET_BATCH_SIZE;
+
+      // NOTE: Hashes with a batch form hash the whole batch at once
+      if constexpr (batch_hash<Hash, Key_> && !Policy::RANDOM_SEED) {
+        Hash{}.hash_batch(keys + start, batch, hashes);
+      } else {
+        for (usize i = 0U; i < batch; ++i) {
+          hashes[i] = this->hash_key(keys[start + i]);
+        }
+      }
+
+      for (usize i = 0U; i < batch; ++i) {
+        indices[i] = Policy::get_index(hashes[i], this->capacity);
+        prefetch(this->distances + indices[i]);
+        prefetch(this->bucket + indices[i]);
+      }
+
+      for (usize i = 0U; i < batch; ++i) {
+        found[start + i] = this->find_from<const Key_&>(
+            keys[start + i], hashes[i], indices[i]
+        );
+      }
+    }
+  }
+
   // === Memory === //
 
+  /**
+   * Number of keys a bucket of `bucket_capacity` holds before growing
+   **/
+  [[nodiscard]] usize get_max_size(usize bucket_capacity) const noexcept {
+    auto new_max_size =
+        static_cast<usize>(bucket_capacity * this->max_load_factor);
+    // NOTE: At least 1 slot has to stay empty so the probes always stop
+    return new_max_size < bucket_capacity ? new_max_size : bucket_capacity - 1U;
+  }
+
+  /**
+   * Smallest capacity of the policy that holds `count` keys without growing
+   *
+   * @return 0 if the capacity overflows
+   **/
+  [[nodiscard]] usize get_fitting_capacity(usize count) const noexcept {
+    usize new_capacity = Policy::get_first_capacity();
+    while (this->get_max_size(new_capacity) < count) {
+      usize next_capacity = Policy::get_next_capacity(new_capacity);
+      if (next_capacity <= new_capacity) {
+        return 0U;
+      }
+      new_capacity = next_capacity;
+    }
+    return new_capacity;
+  }
+
   /**
    * Check if the allocation can handle any mutation done to the hash map
    *
    * @errors
    *  - error_codes::BAD_ALLOCATION
+   *  - error_codes::CONTAINER_FULL - max limit of hash_set
    **/
   [[nodiscard]] error_code check_allocation() noexcept {
     if (this->bucket == nullptr) {
-      return this->allocate(get_first_prime());
+      return this->allocate(Policy::get_first_capacity());
     }
 
     if (this->size >= HASHSET_MAX_SIZE) {
@@ -425,69 +797,150 @@ protected:
     }
 
     if (this->size >= this->max_size) {
-      return this->reallocate(this->capacity * 2U + 1U);
+      DS_TRY(this->reallocate(Policy::get_next_capacity(this->capacity)));
     }
 
     return error_codes::OK;
   }
 
   /**
+   * Copies the nodes and distances of a hash set with the same capacity into
+   *   the empty bucket. Each distance is set once its node is constructed, so
+   *   a failed copy can still be cleared.
    *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION - key copy
+   *  - error_code from copy for key
    **/
-  [[nodiscard]] error_code allocate(usize new_capacity) noexcept {
-    // NOLINTNEXTLINE
-    this->bucket = (node_type*)std::malloc(new_capacity * sizeof(node_type));
-    if (this->bucket == nullptr) {
-      return error_codes::BAD_ALLOCATION;
+  [[nodiscard]] error_code copy_bucket(const base_hash_set& other) noexcept {
+    // NOTE: The distances are right after the nodes so both are copied at once
+    if constexpr (std::is_trivially_copyable_v<node_type>) {
+      std::memcpy(
+          this->bucket, other.bucket,
+          this->capacity * (sizeof(node_type) + sizeof(u8))
+      );
+      return error_codes::OK;
     }
 
-    new (this->bucket) node_type[new_capacity];
+    for (usize i = 0U; i < this->capacity; ++i) {
+      if (other.distances[i] == HASHSET_EMPTY_VALUE) {
+        continue;
+      }
 
-    this->capacity = new_capacity;
-    this->max_size = new_capacity * HASHSET_LOAD_FACTOR;
+      new (this->bucket + i) node_type{};
+      this->distances[i] = other.distances[i];
+      if constexpr (!std::is_class_v<Key>) {
+        this->bucket[i].key = other.bucket[i].key;
+      } else {
+        DS_TRY(this->bucket[i].key.copy(other.bucket[i].key));
+      }
+      this->bucket[i].hash = other.bucket[i].hash;
+    }
 
     return error_codes::OK;
   }
 
-  [[nodiscard]] error_code reallocate(usize new_capacity) noexcept {
-    // NOLINTNEXTLINE
-    auto* new_bucket =
-        // NOLINTNEXTLINE
-        (node_type*)std::malloc(new_capacity * sizeof(node_type));
+  /**
+   * Allocates the bucket and the distances in a single block. The slots are
+   *   left as raw storage, a node is only constructed once it is placed in a
+   *   slot.
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION
+   **/
+  [[nodiscard]] error_code allocate(usize new_capacity) noexcept {
+    if (new_capacity > USIZE_MAX / (sizeof(node_type) + sizeof(u8))) {
+      return error_codes::BAD_ALLOCATION;
+    }
+
+    auto* new_bucket = static_cast<node_type*>(
+        Allocator{}.allocate(new_capacity * (sizeof(node_type) + sizeof(u8)))
+    );
     if (new_bucket == nullptr) {
       return error_codes::BAD_ALLOCATION;
     }
 
-    new (new_bucket) node_type[new_capacity];
+    this->bucket = new_bucket;
+    this->distances = (u8*)(new_bucket + new_capacity); // NOLINT
+    std::memset(this->distances, HASHSET_EMPTY_VALUE, new_capacity);
 
-    // Swap the pointers and capacity to easily use the insert function
-    std::swap(this->bucket, new_bucket);
-    std::swap(this->capacity, new_capacity);
-    this->size = 0;
-    this->max_size = this->capacity * HASHSET_LOAD_FACTOR;
+    this->capacity = new_capacity;
+    this->max_size = this->get_max_size(new_capacity);
+
+    return error_codes::OK;
+  }
+
+  /**
+   * Moves all the nodes to a new bucket
+   *
+   * @errors
+   *  - error_codes::BAD_ALLOCATION
+   **/
+  [[nodiscard]] error_code reallocate(usize new_capacity) noexcept {
+    node_type* old_bucket = this->bucket;
+    u8* old_distances = this->distances;
+    usize old_capacity = this->capacity;
+
+    DS_TRY(this->allocate(new_capacity));
+    this->size = 0U;
+    DS_HASH_STATS_ADD(this->counters.resizes, 1U);
 
     // Transfer the old bucket to the new bucket
-    for (usize i = 0; i < new_capacity; ++i) {
-      if (new_bucket[i].is_node_empty()) {
+    for (usize i = 0U; i < old_capacity; ++i) {
+      if (old_distances[i] == HASHSET_EMPTY_VALUE) {
         continue;
       }
 
-      new_bucket[i].distance = 0U;
-      this->insert_node(std::move(new_bucket[i]));
+      this->place_node(old_bucket[i], get_node_hash(old_bucket[i]));
+      DS_HASH_STATS_ADD(this->counters.rehashed, 1U);
     }
 
-    std::free(new_bucket); // NOLINT
+    this->deallocate(old_bucket, old_capacity);
     return error_codes::OK;
   }
+
+  /**
+   * Ends the lifetime of a node whose slot became empty, the slot stays raw
+   *   storage until another node is placed in it
+   **/
+  static void destroy_node(node_type& node) noexcept {
+    if constexpr (!std::is_trivially_destructible_v<node_type>) {
+      node.~node_type();
+    }
+  }
+
+  /**
+   * Destroys the nodes of the occupied slots, empty slots hold no node
+   **/
+  static void destroy_nodes(
+      node_type* nodes, const u8* node_distances, usize node_capacity
+  ) noexcept {
+    if constexpr (!std::is_trivially_destructible_v<node_type>) {
+      for (usize i = 0U; i < node_capacity; ++i) {
+        if (node_distances[i] != HASHSET_EMPTY_VALUE) {
+          nodes[i].~node_type();
+        }
+      }
+    }
+  }
+
+  void deallocate(node_type* old_bucket, usize old_capacity) noexcept {
+    destroy_nodes(
+        old_bucket, (u8*)(old_bucket + old_capacity), // NOLINT
+        old_capacity
+    );
+    Allocator{}.deallocate(old_bucket);
+  }
 };
 
 // === hash_set definition === //
 
 template <
-    typename Key, typename Hash = hash<Key>, typename KeyEqual = equal<Key>>
-class hash_set
-    : public base_hash_set<hash_set<Key, Hash, KeyEqual>, Key, Hash, KeyEqual> {
-};
+    typename Key, typename Hash = hash<Key>, typename KeyEqual = equal<Key>,
+    typename Policy = prime_hash_policy, typename Allocator = allocator<void>>
+class hash_set : public base_hash_set<
+                     hash_set<Key, Hash, KeyEqual, Policy, Allocator>, Key,
+                     Hash, KeyEqual, Policy, Allocator> {};
 
 } // namespace ds
 
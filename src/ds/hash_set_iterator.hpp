@@ -19,6 +19,8 @@ public:
 
 private:
   node_type* bucket = nullptr;
+  // NOTE: A distance of 0 marks an empty node
+  const u8* distances = nullptr;
   node_type* ptr = nullptr;
   usize index = 0;
   usize capacity = 0;
@@ -30,8 +32,8 @@ private:
 
     // Find a bucket with a node
     while (++this->index < this->capacity) {
-      this->ptr = this->bucket + this->index;
-      if (!this->ptr->is_node_empty()) {
+      if (this->distances[this->index] != 0U) {
+        this->ptr = this->bucket + this->index;
         return;
       }
     }
@@ -43,12 +45,14 @@ private:
 public:
   hash_set_iterator() noexcept = default;
 
-  explicit hash_set_iterator(node_type* bucket, usize capacity) noexcept
-      : bucket(bucket), capacity(capacity) {
+  explicit hash_set_iterator(
+      node_type* bucket, const u8* distances, usize capacity
+  ) noexcept
+      : bucket(bucket), distances(distances), capacity(capacity) {
     // Find the first element
     for (this->index = 0; this->index < capacity; ++this->index) {
-      this->ptr = bucket + this->index;
-      if (!this->ptr->is_node_empty()) {
+      if (distances[this->index] != 0U) {
+        this->ptr = bucket + this->index;
         return;
       }
     }
@@ -97,6 +101,8 @@ public:
 
 private:
   node_type* bucket = nullptr;
+  // NOTE: A distance of 0 marks an empty node
+  const u8* distances = nullptr;
   node_type* ptr = nullptr;
   usize index = 0;
   usize capacity = 0;
@@ -108,8 +114,8 @@ private:
 
     // Find a bucket with a node
     while (++this->index < this->capacity) {
-      this->ptr = this->bucket + this->index;
-      if (!this->ptr->is_node_empty()) {
+      if (this->distances[this->index] != 0U) {
+        this->ptr = this->bucket + this->index;
         return;
       }
     }
@@ -121,12 +127,14 @@ private:
 public:
   hash_set_const_iterator() noexcept = default;
 
-  explicit hash_set_const_iterator(node_type* bucket, usize capacity) noexcept
-      : bucket(bucket), capacity(capacity) {
+  explicit hash_set_const_iterator(
+      node_type* bucket, const u8* distances, usize capacity
+  ) noexcept
+      : bucket(bucket), distances(distances), capacity(capacity) {
     // Find the first element
     for (this->index = 0; this->index < capacity; ++this->index) {
-      this->ptr = bucket + this->index;
-      if (!this->ptr->is_node_empty()) {
+      if (distances[this->index] != 0U) {
+        this->ptr = bucket + this->index;
         return;
       }
     }
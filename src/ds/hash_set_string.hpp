@@ -10,6 +10,7 @@
 
 #include "./hash_set.hpp"
 #include "./string.hpp"
+#include "./string_view.hpp"
 #include "types.hpp"
 
 namespace ds {
@@ -18,12 +19,14 @@ namespace ds {
 
 template <
     typename Derived, typename Hash = hash<string>,
-    typename KeyEqual = equal<string>>
-class string_hash_set : public base_hash_set<Derived, string, Hash, KeyEqual> {
+    typename KeyEqual = equal<string>, typename Policy = prime_hash_policy,
+    typename Allocator = allocator<void>>
+class string_hash_set
+    : public base_hash_set<Derived, string, Hash, KeyEqual, Policy, Allocator> {
 public:
   using key_type = string;
-  using node_type =
-      typename base_hash_set<Derived, string, Hash, KeyEqual>::node_type;
+  using node_type = typename base_hash_set<
+      Derived, string, Hash, KeyEqual, Policy, Allocator>::node_type;
 
   // === Accessors === //
 
@@ -31,27 +34,38 @@ public:
    * Checks if the value exists in the hash map
    **/
   [[nodiscard]] bool contains(const string& key) const noexcept {
-    return this->find(key);
+    return this->template find<const string&>(key);
   }
 
   /**
    * Checks if the value exists in the hash map
    **/
   [[nodiscard]] bool contains(const c8* key) const noexcept {
-    // NOTE: No infinite loop since 1 node will always be empty in any case
-    for (usize index = this->template calculate_hash_index<const c8*>(key);;) {
-      if (this->bucket[index].is_node_empty()) {
-        return false;
-      }
+    return this->template find<const c8*>(key);
+  }
 
-      if (KeyEqual()(key, this->bucket[index].key)) {
-        return true;
-      }
+  /**
+   * Checks if the key of the view exists in the hash set, no copy of the key
+   *   is made
+   **/
+  [[nodiscard]] bool contains(string_view key) const noexcept {
+    return this->template find<string_view>(key);
+  }
 
-      if (++index >= this->capacity) {
-        index = 0U;
-      }
-    }
+  /**
+   * Batched check if each key exists in the hash set
+   **/
+  void contains_batch(const string* keys, usize count, bool* found)
+      const noexcept {
+    this->template contains_batch_impl<string>(keys, count, found);
+  }
+
+  /**
+   * Batched check if each key exists in the hash set
+   **/
+  void contains_batch(const c8* const* keys, usize count, bool* found)
+      const noexcept {
+    this->template contains_batch_impl<const c8*>(keys, count, found);
   }
 
   // === Mutations === //
@@ -82,7 +96,7 @@ public:
   [[nodiscard]] error_code insert(const c8* key) noexcept {
     DS_TRY(this->check_allocation());
 
-    node_type node{.distance = 0U};
+    node_type node{};
     DS_TRY(node.key.copy(key));
     this->insert_node(std::move(node));
 
@@ -105,6 +119,14 @@ public:
     this->template erase_impl<const c8*>(key);
   }
 
+  /**
+   * Removes the key of the view in the hash set
+   * If no key was found, nothing will happen to the hash set
+   **/
+  void remove(string_view key) noexcept {
+    this->template erase_impl<string_view>(key);
+  }
+
 #ifdef DS_TEST
   void print() const noexcept {
     printf("=== hash_set ===\n");
@@ -112,9 +134,13 @@ public:
       printf("No elements\n");
     }
     for (usize i = 0; i < this->capacity; ++i) {
+      if (this->distances[i] == HASHSET_EMPTY_VALUE) {
+        printf(USIZE_FORMAT ": empty\n", i);
+        continue;
+      }
       printf(
-          USIZE_FORMAT ": (%s) distance: %16llx\n", i,
-          this->bucket[i].key.c_str(), this->bucket[i].distance
+          USIZE_FORMAT ": (%s) distance: %u\n", i,
+          this->bucket[i].key.c_str(), this->distances[i]
       );
     }
   }
@@ -123,10 +149,12 @@ public:
 
 // === hash_map string specializations === //
 
-template <typename Hash, typename KeyEqual>
-class hash_set<string, Hash, KeyEqual>
-    : public string_hash_set<hash_set<string, Hash, KeyEqual>, Hash, KeyEqual> {
-};
+template <
+    typename Hash, typename KeyEqual, typename Policy, typename Allocator>
+class hash_set<string, Hash, KeyEqual, Policy, Allocator>
+    : public string_hash_set<
+          hash_set<string, Hash, KeyEqual, Policy, Allocator>, Hash, KeyEqual,
+          Policy, Allocator> {};
 
 template <typename Hash>
 class hash_set<string, Hash>
@@ -0,0 +1,148 @@
+/*===============================*
+ * Author/s:
+ *  - silentrald
+ * Version: 1.0
+ * Created: 2024-10-17
+ *===============================*/
+
+#ifndef DS_HASH_STATS_HPP
+#define DS_HASH_STATS_HPP
+
+#include "./types.hpp"
+
+/**
+ * Opt-in health statistics of the robin hood containers, only compiled when
+ *   DS_HASH_STATS is defined. Without it the containers carry no counters and
+ *   DS_HASH_STATS_ADD expands to nothing.
+ **/
+
+#ifdef DS_HASH_STATS
+
+// NOLINTNEXTLINE
+#define DS_HASH_STATS_ADD(counter, amount) (counter) += (amount)
+
+namespace ds {
+
+// Number of distance values, the stored distances fit in a byte
+inline const usize HASH_STATS_DISTANCES = UINT8_MAX + 1U;
+
+/**
+ * Counters that are kept up to date by the container while it runs
+ **/
+struct hash_counters {
+  // Number of times a new bucket was allocated to replace the current one
+  usize resizes = 0U;
+  // Number of nodes moved to a new bucket by the resizes
+  usize rehashed = 0U;
+};
+
+/**
+ * Snapshot of the health of a hash container, collected on demand
+ **/
+struct hash_stats {
+  // Number of slots per stored distance, index 0 counts the empty slots and
+  //   index n the nodes that are n - 1 slots away from their hashed index.
+  //   The last index also counts the nodes with a saturated distance.
+  usize distances[HASH_STATS_DISTANCES]{}; // NOLINT
+  usize size = 0U;
+  usize capacity = 0U;
+  // Slots probed by the longest successful lookup
+  usize max_probe_length = 0U;
+  // Average slots probed by a successful / an unsuccessful lookup
+  f64 average_hit_probe = 0.0;
+  f64 average_miss_probe = 0.0;
+  // Runs of consecutive occupied slots
+  usize clusters = 0U;
+  usize max_cluster_size = 0U;
+  usize resizes = 0U;
+  usize rehashed = 0U;
+  // Bytes of the buckets currently allocated
+  usize allocated_bytes = 0U;
+};
+
+/**
+ * Adds a bucket of `capacity` slots to the stats. The miss probe is averaged
+ *   over every slot as the hashed index, a miss stops at the first slot that
+ *   is nearer to its own hashed index than the probe.
+ **/
+inline void collect_bucket_stats(
+    hash_stats& stats, const u8* distances, usize capacity, usize node_size
+) noexcept {
+  if (capacity == 0U) {
+    return;
+  }
+
+  usize nodes = 0U;
+  usize hit_probes = 0U;
+  usize miss_probes = 0U;
+  usize cluster_size = 0U;
+  // NOTE: A cluster wrapping around the end continues the one at the start
+  usize first_cluster_size = 0U;
+  bool first_cluster = distances[0] != 0U;
+
+  for (usize i = 0U; i < capacity; ++i) {
+    u8 distance = distances[i];
+    ++stats.distances[distance];
+    hit_probes += distance;
+    if (distance > stats.max_probe_length) {
+      stats.max_probe_length = distance;
+    }
+
+    usize probes = 1U;
+    for (usize index = i; distances[index] >= probes; ++probes) {
+      if (++index >= capacity) {
+        index = 0U;
+      }
+    }
+    miss_probes += probes;
+
+    if (distance != 0U) {
+      ++nodes;
+      ++cluster_size;
+      continue;
+    }
+    if (first_cluster) {
+      first_cluster_size = cluster_size;
+      first_cluster = false;
+    } else if (cluster_size > 0U) {
+      ++stats.clusters;
+      if (cluster_size > stats.max_cluster_size) {
+        stats.max_cluster_size = cluster_size;
+      }
+    }
+    cluster_size = 0U;
+  }
+
+  // NOTE: A bucket always has an empty slot, so the first cluster has ended
+  cluster_size += first_cluster_size;
+  if (cluster_size > 0U) {
+    ++stats.clusters;
+    if (cluster_size > stats.max_cluster_size) {
+      stats.max_cluster_size = cluster_size;
+    }
+  }
+
+  // Running averages over every bucket collected so far
+  usize previous_nodes = stats.size;
+  stats.size += nodes;
+  if (stats.size > 0U) {
+    stats.average_hit_probe =
+        (stats.average_hit_probe * (f64)previous_nodes + (f64)hit_probes) /
+        (f64)stats.size;
+  }
+  // NOTE: A miss probes every bucket that is still alive
+  stats.average_miss_probe += (f64)miss_probes / (f64)capacity;
+  stats.capacity += capacity;
+  stats.allocated_bytes += capacity * (node_size + sizeof(u8));
+}
+
+} // namespace ds
+
+#else
+
+// NOLINTNEXTLINE
+#define DS_HASH_STATS_ADD(counter, amount)
+
+#endif
+
+#endif
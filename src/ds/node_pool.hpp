@@ -0,0 +1,191 @@
+/*===============================*
+ * Author/s:
+ *  - silentrald
+ * Version: 1.0
+ * Created: 2024-10-17
+ *===============================*/
+
+#ifndef DS_NODE_POOL_HPP
+#define DS_NODE_POOL_HPP
+
+#include "./allocator.hpp"
+#include "./types.hpp"
+#include <cstddef>
+
+namespace ds {
+
+// Number of blocks in the first slab of a pool, the next ones double it
+inline const usize NODE_POOL_MIN_BLOCKS = 8U;
+// Slabs stop growing past this size in bytes
+inline const usize NODE_POOL_MAX_SLAB_SIZE = 256U * 1024U;
+
+/**
+ * Pool of fixed size blocks carved out of larger slabs. Freed blocks are kept
+ *   in a free list and reused before a new slab is allocated, and the slabs
+ *   are only freed in bulk by release.
+ *
+ * NOTE: Blocks are not constructed or destroyed by the pool
+ **/
+template <usize BlockSize, typename Allocator = allocator<void>>
+class node_pool {
+public:
+  node_pool() noexcept = default;
+  node_pool(const node_pool&) = delete;
+  node_pool& operator=(const node_pool&) = delete;
+
+  // === Move === //
+
+  node_pool(node_pool&& rhs) noexcept
+      : slabs(rhs.slabs), free_list(rhs.free_list), next(rhs.next),
+        end(rhs.end), slab_blocks(rhs.slab_blocks) {
+    rhs.reset();
+  }
+
+  node_pool& operator=(node_pool&& rhs) noexcept {
+    if (&rhs == this) {
+      return *this;
+    }
+
+    this->release();
+    this->slabs = rhs.slabs;
+    this->free_list = rhs.free_list;
+    this->next = rhs.next;
+    this->end = rhs.end;
+    this->slab_blocks = rhs.slab_blocks;
+    rhs.reset();
+
+    return *this;
+  }
+
+  // === Destructor === //
+
+  ~node_pool() noexcept {
+    this->release();
+  }
+
+  /**
+   * Frees every slab, all the blocks given by the pool become invalid
+   **/
+  void release() noexcept {
+    while (this->slabs != nullptr) {
+      slab* next = this->slabs->next;
+      Allocator{}.deallocate(this->slabs);
+      this->slabs = next;
+    }
+    this->reset();
+  }
+
+  // === Blocks === //
+
+  /**
+   * Gets a block of at least BlockSize bytes, if an error happens, this will
+   *   return nullptr
+   *
+   * @errors
+   *  - bad allocation in creating a slab
+   **/
+  [[nodiscard]] void* allocate() noexcept {
+    if (this->free_list != nullptr) {
+      block* free = this->free_list;
+      this->free_list = free->next;
+      return free;
+    }
+
+    if (this->next == this->end && !this->allocate_slab()) {
+      return nullptr;
+    }
+
+    void* pointer = this->next;
+    this->next += BLOCK_SIZE;
+    return pointer;
+  }
+
+  /**
+   * Returns a block to the pool to be reused by the next allocate
+   **/
+  void deallocate(void* pointer) noexcept {
+    auto* free = static_cast<block*>(pointer);
+    free->next = this->free_list;
+    this->free_list = free;
+  }
+
+#ifdef DS_TEST
+  [[nodiscard]] usize get_slab_count() const noexcept {
+    usize count = 0U;
+    for (slab* s = this->slabs; s != nullptr; s = s->next) {
+      ++count;
+    }
+    return count;
+  }
+
+  [[nodiscard]] usize get_free_count() const noexcept {
+    usize count = 0U;
+    for (block* b = this->free_list; b != nullptr; b = b->next) {
+      ++count;
+    }
+    return count;
+  }
+#endif
+
+private:
+  struct slab {
+    slab* next;
+  };
+
+  struct block {
+    block* next;
+  };
+
+  static constexpr usize ALIGNMENT = alignof(std::max_align_t);
+
+  [[nodiscard]] static constexpr usize align(usize size) noexcept {
+    return (size + ALIGNMENT - 1U) / ALIGNMENT * ALIGNMENT;
+  }
+
+  static constexpr usize BLOCK_SIZE =
+      align(BlockSize < sizeof(block) ? sizeof(block) : BlockSize);
+  // Keeps the blocks after the slab header aligned
+  static constexpr usize HEADER_SIZE = align(sizeof(slab));
+  static constexpr usize MAX_SLAB_BLOCKS =
+      NODE_POOL_MAX_SLAB_SIZE / BLOCK_SIZE > 0U
+          ? NODE_POOL_MAX_SLAB_SIZE / BLOCK_SIZE
+          : 1U;
+
+  slab* slabs = nullptr;
+  block* free_list = nullptr;
+  // Unused blocks of the newest slab
+  u8* next = nullptr;
+  u8* end = nullptr;
+  usize slab_blocks = NODE_POOL_MIN_BLOCKS;
+
+  void reset() noexcept {
+    this->slabs = nullptr;
+    this->free_list = nullptr;
+    this->next = this->end = nullptr;
+    this->slab_blocks = NODE_POOL_MIN_BLOCKS;
+  }
+
+  [[nodiscard]] bool allocate_slab() noexcept {
+    usize blocks = this->slab_blocks < MAX_SLAB_BLOCKS ? this->slab_blocks
+                                                       : MAX_SLAB_BLOCKS;
+    auto* s = static_cast<slab*>(
+        Allocator{}.allocate(HEADER_SIZE + blocks * BLOCK_SIZE)
+    );
+    if (s == nullptr) {
+      return false;
+    }
+
+    s->next = this->slabs;
+    this->slabs = s;
+    this->next = reinterpret_cast<u8*>(s) + HEADER_SIZE; // NOLINT
+    this->end = this->next + blocks * BLOCK_SIZE;
+    if (this->slab_blocks < MAX_SLAB_BLOCKS) {
+      this->slab_blocks *= 2U;
+    }
+    return true;
+  }
+};
+
+} // namespace ds
+
+#endif
@@ -0,0 +1,35 @@
+/*===============================*
+ * Author/s:
+ *  - silentrald
+ * Version: 1.0
+ * Created: 2024-10-17
+ *===============================*/
+
+#ifndef DS_PREFETCH_HPP
+#define DS_PREFETCH_HPP
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <xmmintrin.h>
+#endif
+
+namespace ds {
+
+/**
+ * Hints the cpu to start loading the cache line of the address, does nothing
+ *   on compilers without a prefetch intrinsic
+ *
+ * NOTE: Prefetching never faults, any address can be passed
+ **/
+inline void prefetch(const void* address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(address);
+#elif defined(_MSC_VER)
+  _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+  (void)address;
+#endif
+}
+
+} // namespace ds
+
+#endif
@@ -387,7 +387,9 @@ bool string::operator==(const char* rhs) const noexcept {
   if (this->size == 0)
     return rhs[0] == '\0';
 
-  return std::strncmp(this->str, rhs, this->size) == 0;
+  // NOTE: rhs can be longer, it should end where this string ends
+  return std::strncmp(this->str, rhs, this->size) == 0 &&
+         rhs[this->size] == '\0';
 }
 
 bool string::operator!=(const string& rhs) const noexcept {
@@ -406,7 +408,8 @@ bool operator==(const char* lhs, const string& rhs) noexcept {
   if (rhs.size == 0)
     return lhs[0] == '\0';
 
-  return std::strncmp(lhs, rhs.str, rhs.size) == 0;
+  // NOTE: lhs can be longer, it should end where rhs ends
+  return std::strncmp(lhs, rhs.str, rhs.size) == 0 && lhs[rhs.size] == '\0';
 }
 
 bool operator!=(const char* lhs, const string& rhs) noexcept {
@@ -0,0 +1,109 @@
+/*===============================*
+ * Author/s:
+ *  - silentrald
+ * Version: 1.0
+ * Created: 2024-10-17
+ *===============================*/
+
+#ifndef DS_STRING_VIEW_HPP
+#define DS_STRING_VIEW_HPP
+
+#include "./string.hpp"
+#include "./types.hpp"
+#include <cstring>
+
+namespace ds {
+
+/**
+ * Non-owning view of `size` characters, the characters do not need a null
+ *   terminator so a key can be sliced out of a larger buffer without a copy
+ *
+ * NOTE: The viewed characters must outlive the view
+ **/
+class string_view {
+public:
+  string_view() noexcept = default;
+
+  string_view(const c8* str, usize size) noexcept : str(str), size(size) {}
+
+  /**
+   * Views the `str` until its null terminator
+   *
+   * NOTE: Can crash the system if string does not have a null terminator '\0'.
+   **/
+  string_view(const c8* str) noexcept // NOLINT
+      : str(str), size(std::strlen(str)) {}
+
+  string_view(const string& str) noexcept // NOLINT
+      : str(str.c_str()), size(str.get_size()) {}
+
+  // === Element Access === //
+
+  [[nodiscard]] c8 operator[](usize index) const noexcept {
+    return this->str[index];
+  }
+
+  /**
+   * @returns pointer to the start of the view, not null terminated
+   **/
+  [[nodiscard]] const c8* data() const noexcept {
+    return this->str;
+  }
+
+  // === Capacity === //
+
+  [[nodiscard]] bool is_empty() const noexcept {
+    return this->size == 0U;
+  }
+
+  [[nodiscard]] usize get_size() const noexcept {
+    return this->size;
+  }
+
+  // === Operators === //
+
+  /**
+   * Check if the 2 views have the same characters.
+   **/
+  [[nodiscard]] bool operator==(string_view rhs) const noexcept {
+    return this->size == rhs.size &&
+           (this->size == 0U ||
+            std::memcmp(this->str, rhs.str, this->size) == 0);
+  }
+
+  /**
+   * Check if the 2 views do not have the same characters.
+   **/
+  [[nodiscard]] bool operator!=(string_view rhs) const noexcept {
+    return !(*this == rhs);
+  }
+
+  /**
+   * Lexicographically compares the 2 views, a prefix is smaller than the
+   *   longer view
+   *
+   * @returns negative if this is smaller, 0 if equal, positive if larger
+   **/
+  [[nodiscard]] isize compare(string_view rhs) const noexcept {
+    usize length = this->size < rhs.size ? this->size : rhs.size;
+    if (length > 0U) {
+      i32 comparison = std::memcmp(this->str, rhs.str, length);
+      if (comparison != 0) {
+        return comparison;
+      }
+    }
+
+    if (this->size == rhs.size) {
+      return 0;
+    }
+    return this->size < rhs.size ? -1 : 1;
+  }
+
+private:
+  const c8* str = nullptr;
+  usize size = 0U;
+};
+
+} // namespace ds
+
+#endif
@@ -80,6 +80,7 @@ enum error_codes : error_code {
   INVALID_SIZE = 7, // When capacity is set to a negative value
   NOT_IMPLEMENTED = 8,
   THREAD_ERROR = 9,
+  INVALID_ARGUMENT = 10,
 };
 
 inline bool is_error(error_code err) noexcept {
@@ -8,6 +8,16 @@
 // non-native version will be less than optimal.
 
 #include "murmur3.h"
+#include <string.h>
+
+// The lanes gather the key pointers as 64 bit indices, so the parallel
+// paths are only built for x86-64
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define MURMUR3_X86_SIMD 1
+#include <immintrin.h>
+#else
+#define MURMUR3_X86_SIMD 0
+#endif
 
 //-----------------------------------------------------------------------------
 // Platform-specific functions and macros
@@ -52,14 +62,20 @@ inline uint64_t rotl64 ( uint64_t x, int8_t r )
 // Block read - if your platform needs to do endian-swapping or can only
 // handle aligned reads, do the conversion here
 
+// NOTE: memcpy since the blocks of a key are not always aligned
+
 FORCE_INLINE uint32_t getblock32 ( const uint32_t * p, int i )
 {
-  return p[i];
+  uint32_t block;
+  memcpy(&block, p + i, sizeof(block));
+  return block;
 }
 
 FORCE_INLINE uint64_t getblock64 ( const uint64_t * p, int i )
 {
-  return p[i];
+  uint64_t block;
+  memcpy(&block, p + i, sizeof(block));
+  return block;
 }
 
 //-----------------------------------------------------------------------------
@@ -332,4 +348,595 @@ void MurmurHash3_x64_128 ( const void * key, const int len,
 }
 
 //-----------------------------------------------------------------------------
+// Multi-buffer version of MurmurHash3_x86_32, each lane of a vector hashes its
+// own key. A lane stops mixing blocks once its key runs out, so keys of
+// different lengths can share a group.
+
+// Tail bytes of a key as a single block, 0 if the length is a multiple of 4
+FORCE_INLINE uint32_t gettail_x86_32 ( const uint8_t * key, int len )
+{
+  const uint8_t * tail = key + (len & ~3);
+  uint32_t k1 = 0;
+
+  switch(len & 3)
+  {
+  case 3: k1 ^= tail[2] << 16; [[fallthrough]];
+  case 2: k1 ^= tail[1] << 8; [[fallthrough]];
+  case 1: k1 ^= tail[0];
+  };
+
+  return k1;
+}
+
+#if MURMUR3_X86_SIMD
+
+__attribute__((target("avx2")))
+static inline __m256i rotl32_x8 ( __m256i x, int r )
+{
+  return _mm256_or_si256(_mm256_slli_epi32(x, r), _mm256_srli_epi32(x, 32 - r));
+}
+
+__attribute__((target("avx2")))
+static inline __m256i mixk1_x8 ( __m256i k1 )
+{
+  k1 = _mm256_mullo_epi32(k1, _mm256_set1_epi32((int)0xcc9e2d51));
+  k1 = rotl32_x8(k1, 15);
+  return _mm256_mullo_epi32(k1, _mm256_set1_epi32(0x1b873593));
+}
+
+__attribute__((target("avx2")))
+static void MurmurHash3_x86_32_x8 ( const void * const * keys, const int * lens,
+                                    uint32_t seed, uint32_t * out )
+{
+  const uint8_t * data[8];
+  int nblocks[8];
+  int max_blocks = 0;
+  uint32_t tails[8];
+  int has_tail[8];
+
+  for(int l = 0; l < 8; l++)
+  {
+    data[l] = (const uint8_t*)keys[l];
+    nblocks[l] = lens[l] / 4;
+    if(nblocks[l] > max_blocks) max_blocks = nblocks[l];
+    tails[l] = gettail_x86_32(data[l], lens[l]);
+    has_tail[l] = (lens[l] & 3) ? -1 : 0;
+  }
+
+  __m256i h1 = _mm256_set1_epi32((int)seed);
+  const __m256i blocks = _mm256_loadu_si256((const __m256i*)nblocks);
+
+  // The addresses of the next block of each key, gathered 4 lanes at a time
+  __m256i lo = _mm256_loadu_si256((const __m256i*)data);
+  __m256i hi = _mm256_loadu_si256((const __m256i*)(data + 4));
+  const __m256i step = _mm256_set1_epi64x(4);
+
+  //----------
+  // body
+
+  for(int i = 0; i < max_blocks; i++)
+  {
+    // Lanes whose key has no block i keep their hash and load nothing
+    __m256i active = _mm256_cmpgt_epi32(blocks, _mm256_set1_epi32(i));
+
+    __m128i k_lo = _mm256_mask_i64gather_epi32(
+        _mm_setzero_si128(), (const int*)0, lo,
+        _mm256_castsi256_si128(active), 1);
+    __m128i k_hi = _mm256_mask_i64gather_epi32(
+        _mm_setzero_si128(), (const int*)0, hi,
+        _mm256_extracti128_si256(active, 1), 1);
+    lo = _mm256_add_epi64(lo, step);
+    hi = _mm256_add_epi64(hi, step);
+
+    __m256i k1 = mixk1_x8(_mm256_set_m128i(k_hi, k_lo));
+    __m256i mixed = rotl32_x8(_mm256_xor_si256(h1, k1), 13);
+    mixed = _mm256_add_epi32(
+        _mm256_mullo_epi32(mixed, _mm256_set1_epi32(5)),
+        _mm256_set1_epi32((int)0xe6546b64));
+
+    h1 = _mm256_blendv_epi8(h1, mixed, active);
+  }
+
+  //----------
+  // tail
+
+  __m256i k1 = mixk1_x8(_mm256_loadu_si256((const __m256i*)tails));
+  __m256i tail_mask = _mm256_loadu_si256((const __m256i*)has_tail);
+  h1 = _mm256_xor_si256(h1, _mm256_and_si256(k1, tail_mask));
+
+  //----------
+  // finalization
+
+  h1 = _mm256_xor_si256(h1, _mm256_loadu_si256((const __m256i*)lens));
+
+  h1 = _mm256_xor_si256(h1, _mm256_srli_epi32(h1, 16));
+  h1 = _mm256_mullo_epi32(h1, _mm256_set1_epi32((int)0x85ebca6b));
+  h1 = _mm256_xor_si256(h1, _mm256_srli_epi32(h1, 13));
+  h1 = _mm256_mullo_epi32(h1, _mm256_set1_epi32((int)0xc2b2ae35));
+  h1 = _mm256_xor_si256(h1, _mm256_srli_epi32(h1, 16));
+
+  _mm256_storeu_si256((__m256i*)out, h1);
+}
+
+__attribute__((target("sse4.1")))
+static inline __m128i rotl32_x4 ( __m128i x, int r )
+{
+  return _mm_or_si128(_mm_slli_epi32(x, r), _mm_srli_epi32(x, 32 - r));
+}
+
+__attribute__((target("sse4.1")))
+static inline __m128i mixk1_x4 ( __m128i k1 )
+{
+  k1 = _mm_mullo_epi32(k1, _mm_set1_epi32((int)0xcc9e2d51));
+  k1 = rotl32_x4(k1, 15);
+  return _mm_mullo_epi32(k1, _mm_set1_epi32(0x1b873593));
+}
+
+__attribute__((target("sse4.1")))
+static void MurmurHash3_x86_32_x4 ( const void * const * keys, const int * lens,
+                                    uint32_t seed, uint32_t * out )
+{
+  const uint8_t * data[4];
+  int nblocks[4];
+  int max_blocks = 0;
+  uint32_t tails[4];
+  int has_tail[4];
+
+  for(int l = 0; l < 4; l++)
+  {
+    data[l] = (const uint8_t*)keys[l];
+    nblocks[l] = lens[l] / 4;
+    if(nblocks[l] > max_blocks) max_blocks = nblocks[l];
+    tails[l] = gettail_x86_32(data[l], lens[l]);
+    has_tail[l] = (lens[l] & 3) ? -1 : 0;
+  }
+
+  __m128i h1 = _mm_set1_epi32((int)seed);
+  const __m128i blocks = _mm_loadu_si128((const __m128i*)nblocks);
+
+  //----------
+  // body
+
+  for(int i = 0; i < max_blocks; i++)
+  {
+    uint32_t k[4];
+    for(int l = 0; l < 4; l++)
+    {
+      k[l] = i < nblocks[l] ? getblock32((const uint32_t*)data[l], i) : 0;
+    }
+
+    __m128i k1 = mixk1_x4(_mm_loadu_si128((const __m128i*)k));
+    __m128i mixed = rotl32_x4(_mm_xor_si128(h1, k1), 13);
+    mixed = _mm_add_epi32(
+        _mm_mullo_epi32(mixed, _mm_set1_epi32(5)),
+        _mm_set1_epi32((int)0xe6546b64));
+
+    // Lanes whose key has no block i keep their hash
+    __m128i active = _mm_cmpgt_epi32(blocks, _mm_set1_epi32(i));
+    h1 = _mm_blendv_epi8(h1, mixed, active);
+  }
+
+  //----------
+  // tail
+
+  __m128i k1 = mixk1_x4(_mm_loadu_si128((const __m128i*)tails));
+  __m128i tail_mask = _mm_loadu_si128((const __m128i*)has_tail);
+  h1 = _mm_xor_si128(h1, _mm_and_si128(k1, tail_mask));
+
+  //----------
+  // finalization
+
+  h1 = _mm_xor_si128(h1, _mm_loadu_si128((const __m128i*)lens));
+
+  h1 = _mm_xor_si128(h1, _mm_srli_epi32(h1, 16));
+  h1 = _mm_mullo_epi32(h1, _mm_set1_epi32((int)0x85ebca6b));
+  h1 = _mm_xor_si128(h1, _mm_srli_epi32(h1, 13));
+  h1 = _mm_mullo_epi32(h1, _mm_set1_epi32((int)0xc2b2ae35));
+  h1 = _mm_xor_si128(h1, _mm_srli_epi32(h1, 16));
+
+  _mm_storeu_si128((__m128i*)out, h1);
+}
+
+#endif // MURMUR3_X86_SIMD
+
+void MurmurHash3_x86_32_batch ( const void * const * keys, const int * lens,
+                                int count, uint32_t seed, uint32_t * out )
+{
+  int i = 0;
+
+#if MURMUR3_X86_SIMD
+  if(__builtin_cpu_supports("avx2"))
+  {
+    for(; i + 8 <= count; i += 8)
+    {
+      MurmurHash3_x86_32_x8(keys + i, lens + i, seed, out + i);
+    }
+  }
+  if(__builtin_cpu_supports("sse4.1"))
+  {
+    for(; i + 4 <= count; i += 4)
+    {
+      MurmurHash3_x86_32_x4(keys + i, lens + i, seed, out + i);
+    }
+  }
+#endif
+
+  for(; i < count; i++)
+  {
+    MurmurHash3_x86_32(keys[i], lens[i], seed, out + i);
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Streaming versions, the bytes of a partial block are kept in the state until
+// the next update fills it
+
+FORCE_INLINE uint32_t mixk1_x86_32 ( uint32_t k1 )
+{
+  k1 *= 0xcc9e2d51;
+  k1 = ROTL32(k1,15);
+  k1 *= 0x1b873593;
+
+  return k1;
+}
+
+FORCE_INLINE uint32_t mixblock_x86_32 ( uint32_t h1, const uint8_t * block )
+{
+  uint32_t k1;
+  memcpy(&k1, block, sizeof(k1));
+
+  h1 ^= mixk1_x86_32(k1);
+  h1 = ROTL32(h1,13);
+  h1 = h1*5+0xe6546b64;
+
+  return h1;
+}
+
+void MurmurHash3_x86_32_init ( MurmurHash3_x86_32_state * state, uint32_t seed )
+{
+  state->h1 = seed;
+  state->len = 0;
+  state->tail_len = 0;
+}
+
+void MurmurHash3_x86_32_update ( MurmurHash3_x86_32_state * state,
+                                 const void * key, int len )
+{
+  const uint8_t * data = (const uint8_t*)key;
+  state->len += len;
+
+  //----------
+  // fill the partial block of the previous update
+
+  if(state->tail_len > 0)
+  {
+    while(state->tail_len < 4 && len > 0)
+    {
+      state->tail[state->tail_len++] = *data++;
+      len--;
+    }
+    if(state->tail_len < 4) return;
+
+    state->h1 = mixblock_x86_32(state->h1, state->tail);
+    state->tail_len = 0;
+  }
+
+  //----------
+  // body
+
+  uint32_t h1 = state->h1;
+  for(; len >= 4; data += 4, len -= 4)
+  {
+    h1 = mixblock_x86_32(h1, data);
+  }
+  state->h1 = h1;
+
+  //----------
+  // keep the tail for the next update
+
+  memcpy(state->tail, data, len);
+  state->tail_len = len;
+}
+
+void MurmurHash3_x86_32_final ( const MurmurHash3_x86_32_state * state,
+                                void * out )
+{
+  const uint8_t * tail = state->tail;
+  uint32_t h1 = state->h1;
+  uint32_t k1 = 0;
+
+  switch(state->tail_len)
+  {
+  case 3: k1 ^= tail[2] << 16; [[fallthrough]];
+  case 2: k1 ^= tail[1] << 8; [[fallthrough]];
+  case 1: k1 ^= tail[0];
+          h1 ^= mixk1_x86_32(k1);
+  };
+
+  h1 ^= state->len;
+
+  h1 = fmix32(h1);
+
+  *(uint32_t*)out = h1;
+}
+
+//-----------------------------------------------------------------------------
+
+FORCE_INLINE void mixblock_x86_128 ( uint32_t * h, const uint8_t * block )
+{
+  const uint32_t c1 = 0x239b961b;
+  const uint32_t c2 = 0xab0e9789;
+  const uint32_t c3 = 0x38b34ae5;
+  const uint32_t c4 = 0xa1e38b93;
+
+  uint32_t k[4];
+  memcpy(k, block, sizeof(k));
+
+  k[0] *= c1; k[0] = ROTL32(k[0],15); k[0] *= c2; h[0] ^= k[0];
+
+  h[0] = ROTL32(h[0],19); h[0] += h[1]; h[0] = h[0]*5+0x561ccd1b;
+
+  k[1] *= c2; k[1] = ROTL32(k[1],16); k[1] *= c3; h[1] ^= k[1];
+
+  h[1] = ROTL32(h[1],17); h[1] += h[2]; h[1] = h[1]*5+0x0bcaa747;
+
+  k[2] *= c3; k[2] = ROTL32(k[2],17); k[2] *= c4; h[2] ^= k[2];
+
+  h[2] = ROTL32(h[2],15); h[2] += h[3]; h[2] = h[2]*5+0x96cd1c35;
+
+  k[3] *= c4; k[3] = ROTL32(k[3],18); k[3] *= c1; h[3] ^= k[3];
+
+  h[3] = ROTL32(h[3],13); h[3] += h[0]; h[3] = h[3]*5+0x32ac3b17;
+}
+
+void MurmurHash3_x86_128_init ( MurmurHash3_x86_128_state * state,
+                                uint32_t seed )
+{
+  state->h[0] = seed;
+  state->h[1] = seed;
+  state->h[2] = seed;
+  state->h[3] = seed;
+  state->len = 0;
+  state->tail_len = 0;
+}
+
+void MurmurHash3_x86_128_update ( MurmurHash3_x86_128_state * state,
+                                  const void * key, int len )
+{
+  const uint8_t * data = (const uint8_t*)key;
+  state->len += len;
+
+  //----------
+  // fill the partial block of the previous update
+
+  if(state->tail_len > 0)
+  {
+    while(state->tail_len < 16 && len > 0)
+    {
+      state->tail[state->tail_len++] = *data++;
+      len--;
+    }
+    if(state->tail_len < 16) return;
+
+    mixblock_x86_128(state->h, state->tail);
+    state->tail_len = 0;
+  }
+
+  //----------
+  // body
+
+  for(; len >= 16; data += 16, len -= 16)
+  {
+    mixblock_x86_128(state->h, data);
+  }
+
+  //----------
+  // keep the tail for the next update
+
+  memcpy(state->tail, data, len);
+  state->tail_len = len;
+}
+
+void MurmurHash3_x86_128_final ( const MurmurHash3_x86_128_state * state,
+                                 void * out )
+{
+  const uint8_t * tail = state->tail;
+  uint32_t h1 = state->h[0];
+  uint32_t h2 = state->h[1];
+  uint32_t h3 = state->h[2];
+  uint32_t h4 = state->h[3];
+
+  const uint32_t c1 = 0x239b961b;
+  const uint32_t c2 = 0xab0e9789;
+  const uint32_t c3 = 0x38b34ae5;
+  const uint32_t c4 = 0xa1e38b93;
+
+  uint32_t k1 = 0;
+  uint32_t k2 = 0;
+  uint32_t k3 = 0;
+  uint32_t k4 = 0;
+
+  switch(state->tail_len)
+  {
+  case 15: k4 ^= tail[14] << 16; [[fallthrough]];
+  case 14: k4 ^= tail[13] << 8; [[fallthrough]];
+  case 13: k4 ^= tail[12] << 0;
+           k4 *= c4; k4  = ROTL32(k4,18); k4 *= c1; h4 ^= k4; [[fallthrough]];
+
+  case 12: k3 ^= tail[11] << 24; [[fallthrough]];
+  case 11: k3 ^= tail[10] << 16; [[fallthrough]];
+  case 10: k3 ^= tail[ 9] << 8; [[fallthrough]];
+  case  9: k3 ^= tail[ 8] << 0;
+           k3 *= c3; k3  = ROTL32(k3,17); k3 *= c4; h3 ^= k3; [[fallthrough]];
+
+  case  8: k2 ^= tail[ 7] << 24; [[fallthrough]];
+  case  7: k2 ^= tail[ 6] << 16; [[fallthrough]];
+  case  6: k2 ^= tail[ 5] << 8; [[fallthrough]];
+  case  5: k2 ^= tail[ 4] << 0;
+           k2 *= c2; k2  = ROTL32(k2,16); k2 *= c3; h2 ^= k2; [[fallthrough]];
+
+  case  4: k1 ^= tail[ 3] << 24; [[fallthrough]];
+  case  3: k1 ^= tail[ 2] << 16; [[fallthrough]];
+  case  2: k1 ^= tail[ 1] << 8; [[fallthrough]];
+  case  1: k1 ^= tail[ 0] << 0;
+           k1 *= c1; k1  = ROTL32(k1,15); k1 *= c2; h1 ^= k1;
+  };
+
+  //----------
+  // finalization
+
+  h1 ^= state->len; h2 ^= state->len; h3 ^= state->len; h4 ^= state->len;
+
+  h1 += h2; h1 += h3; h1 += h4;
+  h2 += h1; h3 += h1; h4 += h1;
+
+  h1 = fmix32(h1);
+  h2 = fmix32(h2);
+  h3 = fmix32(h3);
+  h4 = fmix32(h4);
+
+  h1 += h2; h1 += h3; h1 += h4;
+  h2 += h1; h3 += h1; h4 += h1;
+
+  ((uint32_t*)out)[0] = h1;
+  ((uint32_t*)out)[1] = h2;
+  ((uint32_t*)out)[2] = h3;
+  ((uint32_t*)out)[3] = h4;
+}
+
+//-----------------------------------------------------------------------------
+
+FORCE_INLINE uint64_t mixk1_x64_128 ( uint64_t k1 )
+{
+  k1 *= BIG_CONSTANT(0x87c37b91114253d5);
+  k1 = ROTL64(k1,31);
+  k1 *= BIG_CONSTANT(0x4cf5ad432745937f);
+
+  return k1;
+}
+
+FORCE_INLINE uint64_t mixk2_x64_128 ( uint64_t k2 )
+{
+  k2 *= BIG_CONSTANT(0x4cf5ad432745937f);
+  k2 = ROTL64(k2,33);
+  k2 *= BIG_CONSTANT(0x87c37b91114253d5);
+
+  return k2;
+}
+
+FORCE_INLINE void mixblock_x64_128 ( uint64_t * h1, uint64_t * h2,
+                                     const uint8_t * block )
+{
+  uint64_t k1;
+  uint64_t k2;
+  memcpy(&k1, block, sizeof(k1));
+  memcpy(&k2, block + 8, sizeof(k2));
+
+  *h1 ^= mixk1_x64_128(k1);
+  *h1 = ROTL64(*h1,27); *h1 += *h2; *h1 = *h1*5+0x52dce729;
+
+  *h2 ^= mixk2_x64_128(k2);
+  *h2 = ROTL64(*h2,31); *h2 += *h1; *h2 = *h2*5+0x38495ab5;
+}
+
+void MurmurHash3_x64_128_init ( MurmurHash3_x64_128_state * state,
+                                uint32_t seed )
+{
+  state->h1 = seed;
+  state->h2 = seed;
+  state->len = 0;
+  state->tail_len = 0;
+}
+
+void MurmurHash3_x64_128_update ( MurmurHash3_x64_128_state * state,
+                                  const void * key, int len )
+{
+  const uint8_t * data = (const uint8_t*)key;
+  state->len += len;
+
+  //----------
+  // fill the partial block of the previous update
+
+  if(state->tail_len > 0)
+  {
+    while(state->tail_len < 16 && len > 0)
+    {
+      state->tail[state->tail_len++] = *data++;
+      len--;
+    }
+    if(state->tail_len < 16) return;
+
+    mixblock_x64_128(&state->h1, &state->h2, state->tail);
+    state->tail_len = 0;
+  }
+
+  //----------
+  // body
+
+  uint64_t h1 = state->h1;
+  uint64_t h2 = state->h2;
+  for(; len >= 16; data += 16, len -= 16)
+  {
+    mixblock_x64_128(&h1, &h2, data);
+  }
+  state->h1 = h1;
+  state->h2 = h2;
+
+  //----------
+  // keep the tail for the next update
+
+  memcpy(state->tail, data, len);
+  state->tail_len = len;
+}
+
+void MurmurHash3_x64_128_final ( const MurmurHash3_x64_128_state * state,
+                                 void * out )
+{
+  const uint8_t * tail = state->tail;
+  uint64_t h1 = state->h1;
+  uint64_t h2 = state->h2;
+  uint64_t k1 = 0;
+  uint64_t k2 = 0;
+
+  switch(state->tail_len)
+  {
+  case 15: k2 ^= ((uint64_t)tail[14]) << 48; [[fallthrough]];
+  case 14: k2 ^= ((uint64_t)tail[13]) << 40; [[fallthrough]];
+  case 13: k2 ^= ((uint64_t)tail[12]) << 32; [[fallthrough]];
+  case 12: k2 ^= ((uint64_t)tail[11]) << 24; [[fallthrough]];
+  case 11: k2 ^= ((uint64_t)tail[10]) << 16; [[fallthrough]];
+  case 10: k2 ^= ((uint64_t)tail[ 9]) << 8; [[fallthrough]];
+  case  9: k2 ^= ((uint64_t)tail[ 8]) << 0;
+           h2 ^= mixk2_x64_128(k2); [[fallthrough]];
+
+  case  8: k1 ^= ((uint64_t)tail[ 7]) << 56; [[fallthrough]];
+  case  7: k1 ^= ((uint64_t)tail[ 6]) << 48; [[fallthrough]];
+  case  6: k1 ^= ((uint64_t)tail[ 5]) << 40; [[fallthrough]];
+  case  5: k1 ^= ((uint64_t)tail[ 4]) << 32; [[fallthrough]];
+  case  4: k1 ^= ((uint64_t)tail[ 3]) << 24; [[fallthrough]];
+  case  3: k1 ^= ((uint64_t)tail[ 2]) << 16; [[fallthrough]];
+  case  2: k1 ^= ((uint64_t)tail[ 1]) << 8; [[fallthrough]];
+  case  1: k1 ^= ((uint64_t)tail[ 0]) << 0;
+           h1 ^= mixk1_x64_128(k1);
+  };
+
+  //----------
+  // finalization
+
+  h1 ^= state->len; h2 ^= state->len;
+
+  h1 += h2;
+  h2 += h1;
+
+  h1 = fmix64(h1);
+  h2 = fmix64(h2);
+
+  h1 += h2;
+  h2 += h1;
+
+  ((uint64_t*)out)[0] = h1;
+  ((uint64_t*)out)[1] = h2;
+}
+
+//-----------------------------------------------------------------------------
 
@@ -32,6 +32,61 @@ void MurmurHash3_x86_128 ( const void * key, int len, uint32_t seed, void * out
 
 void MurmurHash3_x64_128 ( const void * key, int len, uint32_t seed, void * out );
 
+//-----------------------------------------------------------------------------
+// Hashes `count` independent keys, out[i] is the same as MurmurHash3_x86_32 of
+// keys[i]. Groups of 8 (AVX2) or 4 (SSE4.1) keys are hashed in parallel lanes
+// when the CPU supports it on x86-64, the rest are hashed one at a time.
+
+void MurmurHash3_x86_32_batch ( const void * const * keys, const int * lens,
+                                int count, uint32_t seed, uint32_t * out );
+
+//-----------------------------------------------------------------------------
+// Streaming versions - the key can be fed in several parts with update and
+// final gives the same hash as the one-shot function over all of the parts
+
+typedef struct
+{
+  uint32_t h1;
+  uint32_t len;
+  uint8_t tail[4];
+  int tail_len;
+} MurmurHash3_x86_32_state;
+
+void MurmurHash3_x86_32_init   ( MurmurHash3_x86_32_state * state, uint32_t seed );
+
+void MurmurHash3_x86_32_update ( MurmurHash3_x86_32_state * state, const void * key, int len );
+
+void MurmurHash3_x86_32_final  ( const MurmurHash3_x86_32_state * state, void * out );
+
+typedef struct
+{
+  uint32_t h[4];
+  uint32_t len;
+  uint8_t tail[16];
+  int tail_len;
+} MurmurHash3_x86_128_state;
+
+void MurmurHash3_x86_128_init   ( MurmurHash3_x86_128_state * state, uint32_t seed );
+
+void MurmurHash3_x86_128_update ( MurmurHash3_x86_128_state * state, const void * key, int len );
+
+void MurmurHash3_x86_128_final  ( const MurmurHash3_x86_128_state * state, void * out );
+
+typedef struct
+{
+  uint64_t h1;
+  uint64_t h2;
+  uint64_t len;
+  uint8_t tail[16];
+  int tail_len;
+} MurmurHash3_x64_128_state;
+
+void MurmurHash3_x64_128_init   ( MurmurHash3_x64_128_state * state, uint32_t seed );
+
+void MurmurHash3_x64_128_update ( MurmurHash3_x64_128_state * state, const void * key, int len );
+
+void MurmurHash3_x64_128_final  ( const MurmurHash3_x64_128_state * state, void * out );
+
 //-----------------------------------------------------------------------------
 
 #endif // _MURMURHASH3_H_
@@ -0,0 +1,134 @@
+//-----------------------------------------------------------------------------
+// wyhash was written by Wang Yi, and is placed in the public domain. This is
+// a trimmed down version of the final version 4 with the default secret.
+//
+// It is built around a 64x64 -> 128 bit multiply, which handles 16 bytes per
+// round and needs no tail loop, so short keys only cost a few loads.
+
+#ifndef _WYHASH_H_
+#define _WYHASH_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#pragma intrinsic(_umul128)
+#endif
+
+//-----------------------------------------------------------------------------
+// Platform-specific functions and macros
+
+#if defined(__GNUC__) || defined(__clang__)
+#define WY_LIKELY(x) __builtin_expect(!!(x), 1)
+#define WY_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#else
+#define WY_LIKELY(x) (x)
+#define WY_UNLIKELY(x) (x)
+#endif
+
+//-----------------------------------------------------------------------------
+// 128 bit multiply, the low half is written to a and the high half to b
+
+inline void wymum(uint64_t *a, uint64_t *b) {
+#if defined(__SIZEOF_INT128__)
+  __uint128_t r = *a;
+  r *= *b;
+  *a = (uint64_t)r;
+  *b = (uint64_t)(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+  *a = _umul128(*a, *b, b);
+#else
+  uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t)*a, lb = (uint32_t)*b;
+  uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+  uint64_t t = rl + (rm0 << 32), c = t < rl;
+  uint64_t lo = t + (rm1 << 32);
+  c += lo < t;
+  uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+  *a = lo;
+  *b = hi;
+#endif
+}
+
+inline uint64_t wymix(uint64_t a, uint64_t b) {
+  wymum(&a, &b);
+  return a ^ b;
+}
+
+//-----------------------------------------------------------------------------
+// Unaligned little endian reads
+
+inline uint64_t wyr8(const uint8_t *p) {
+  uint64_t v;
+  memcpy(&v, p, 8);
+  return v;
+}
+
+inline uint64_t wyr4(const uint8_t *p) {
+  uint32_t v;
+  memcpy(&v, p, 4);
+  return v;
+}
+
+// 1 to 3 bytes, the first, middle and last byte cover every length
+inline uint64_t wyr3(const uint8_t *p, uint64_t k) {
+  return (((uint64_t)p[0]) << 16) | (((uint64_t)p[k >> 1]) << 8) | p[k - 1];
+}
+
+//-----------------------------------------------------------------------------
+
+const uint64_t WYHASH_SECRET[4] = {
+    0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull,
+    0x4d5a2da51de1aa47ull
+};
+
+inline uint64_t wyhash64(const void *key, uint64_t len, uint64_t seed) {
+  const uint8_t *p = (const uint8_t *)key;
+  const uint64_t *secret = WYHASH_SECRET;
+  seed ^= wymix(seed ^ secret[0], secret[1]);
+  uint64_t a, b;
+
+  if (WY_LIKELY(len <= 16)) {
+    if (WY_LIKELY(len >= 4)) {
+      // Two overlapping pairs of 4 byte reads cover 4 to 16 bytes
+      a = (wyr4(p) << 32) | wyr4(p + ((len >> 3) << 2));
+      b = (wyr4(p + len - 4) << 32) | wyr4(p + len - 4 - ((len >> 3) << 2));
+    } else if (WY_LIKELY(len > 0)) {
+      a = wyr3(p, len);
+      b = 0;
+    } else {
+      a = b = 0;
+    }
+  } else {
+    uint64_t i = len;
+    if (WY_UNLIKELY(i > 48)) {
+      // 3 independent lanes so the multiplies can overlap
+      uint64_t see1 = seed, see2 = seed;
+      do {
+        seed = wymix(wyr8(p) ^ secret[1], wyr8(p + 8) ^ seed);
+        see1 = wymix(wyr8(p + 16) ^ secret[2], wyr8(p + 24) ^ see1);
+        see2 = wymix(wyr8(p + 32) ^ secret[3], wyr8(p + 40) ^ see2);
+        p += 48;
+        i -= 48;
+      } while (WY_LIKELY(i > 48));
+      seed ^= see1 ^ see2;
+    }
+    while (WY_UNLIKELY(i > 16)) {
+      seed = wymix(wyr8(p) ^ secret[1], wyr8(p + 8) ^ seed);
+      i -= 16;
+      p += 16;
+    }
+    // The last 16 bytes, overlapping with the previous round if needed
+    a = wyr8(p + i - 16);
+    b = wyr8(p + i - 8);
+  }
+
+  a ^= secret[1];
+  b ^= seed;
+  wymum(&a, &b);
+  return wymix(a ^ secret[0] ^ len, b ^ secret[1]);
+}
+
+//-----------------------------------------------------------------------------
+
+#endif // _WYHASH_H_
@@ -6,12 +6,23 @@
  *===============================*/
 
 #include "ds/bptree_map.hpp"
+#include "catch2/catch_template_test_macros.hpp"
 #include "catch2/catch_test_macros.hpp"
+#include "ds/node_pool.hpp"
+#include "ds/string.hpp"
+#include "ds/string_view.hpp"
 #include "ds/types.hpp"
 #include "main.hpp"
+#include <algorithm>
 #include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <vector>
 
-// NOTE: Test class, string class
+// NOTE: Test class
 
 template <typename T> inline void test_ascending(const ds::usize N) {
   ds::bptree_map<T, T> map{};
@@ -246,3 +257,676 @@ TEST_CASE("Check if u64", "[bptree_map]") {
     test_centered<ds::u64>(N_BIG);
   }
 }
+
+TEMPLATE_TEST_CASE(
+    "bptree_map random keys", "[bptree_map]", ds::i32, ds::i64, ds::u32,
+    ds::u64
+) {
+  const ds::usize N = 5'000U;
+  ds::bptree_map<TestType, TestType> map{};
+  std::map<TestType, TestType> expected{};
+
+  std::srand(N); // NOLINT
+  for (ds::usize i = 0U; i < N; ++i) {
+    auto key = (TestType)(std::rand() % (N * 2U)); // NOLINT
+    REQUIRE(ds_test::handle_error(map.insert(key, (TestType)i)));
+    expected[key] = (TestType)i;
+  }
+  REQUIRE(map.get_size() == expected.size());
+
+  auto iterator = map.cbegin();
+  for (const auto& pair : expected) {
+    REQUIRE(iterator.key() == pair.first);
+    REQUIRE(iterator.value() == pair.second);
+    ++iterator;
+  }
+  REQUIRE(iterator == map.cend());
+
+  for (TestType key = 0; key < (TestType)(N * 2U); ++key) {
+    TestType* pointer = map[key];
+    REQUIRE(map.contains(key) == expected.contains(key));
+    REQUIRE((pointer != nullptr) == expected.contains(key));
+    if (pointer != nullptr) {
+      REQUIRE(*pointer == expected[key]);
+    }
+  }
+}
+
+// === Node Search === //
+
+// Largest key first, always takes the generic search
+template <typename T> class reverse_compare {
+public:
+  [[nodiscard]] ds::isize operator()(T t1, T t2) const noexcept {
+    return t1 < t2 ? 1 : (t1 > t2 ? -1 : 0);
+  }
+};
+
+template <typename T, typename KeyCompare>
+inline void test_node_search(T first, bool descending) {
+  // Past BPTREE_SIMD_SEARCH_SIZE so the halving before the SIMD scan is hit
+  const ds::i32 MAX_SIZE = 80;
+  T keys[MAX_SIZE]; // NOLINT
+
+  for (ds::i32 size = 0; size <= MAX_SIZE; ++size) {
+    for (ds::i32 i = 0; i < size; ++i) {
+      keys[i] = descending ? (T)(first - (T)(i * 2)) : (T)(first + (T)(i * 2));
+    }
+
+    // Every key, and every gap between the keys and past both ends
+    for (ds::i32 i = -1; i <= size * 2; ++i) {
+      T key = descending ? (T)(first - (T)i) : (T)(first + (T)i);
+      ds::i32 lower = 0;
+      ds::i32 upper = 0;
+      for (ds::i32 j = 0; j < size; ++j) {
+        lower += KeyCompare{}(keys[j], key) < 0;
+        upper += KeyCompare{}(keys[j], key) <= 0;
+      }
+
+      REQUIRE(
+          ds::_bptree_map::lower_bound<T, KeyCompare>(keys, size, key) == lower
+      );
+      REQUIRE(
+          ds::_bptree_map::upper_bound<T, KeyCompare>(keys, size, key) == upper
+      );
+    }
+  }
+}
+
+TEMPLATE_TEST_CASE(
+    "bptree_map node search", "[bptree_map]", ds::i32, ds::i64, ds::u32,
+    ds::u64
+) {
+  using compare = ds::compare<TestType>;
+  test_node_search<TestType, compare>(1, false);
+
+  if constexpr (std::is_signed_v<TestType>) {
+    // Crosses 0
+    test_node_search<TestType, compare>(-20, false);
+  } else {
+    // Crosses the sign bit, which only matters for the SIMD compares
+    auto middle =
+        (TestType)std::numeric_limits<std::make_signed_t<TestType>>::max();
+    test_node_search<TestType, compare>(middle - 20U, false);
+  }
+
+  test_node_search<TestType, reverse_compare<TestType>>(200, true);
+}
+
+// === Node Size === //
+
+template <typename T, ds::usize NodeSize> inline void test_node_size() {
+  const ds::usize DEGREE = ds::bptree_degree<T>(NodeSize);
+  // Enough keys for the root to be an inner node over inner nodes, capped so
+  //   the 4KiB i32 nodes stay quick
+  const ds::usize N = DEGREE * DEGREE * 2U < 100'000U ? DEGREE * DEGREE * 2U
+                                                       : 100'000U;
+  const ds::usize CHECK_EVERY = N / 16U;
+  ds::bptree_map<T, T, ds::compare<T>, NodeSize> map{};
+  std::map<T, T> expected{};
+
+  std::srand(N); // NOLINT
+  for (ds::usize i = 0U; i < N; ++i) {
+    auto key = (T)(std::rand() % (N * 2U)); // NOLINT
+    REQUIRE(ds_test::handle_error(map.insert(key, (T)i)));
+    expected[key] = (T)i;
+    if (i % CHECK_EVERY == 0U) {
+      REQUIRE(map.is_valid());
+    }
+  }
+  REQUIRE(map.is_valid());
+  REQUIRE(map.get_size() == expected.size());
+
+  auto iterator = map.cbegin();
+  for (const auto& pair : expected) {
+    REQUIRE(iterator.key() == pair.first);
+    REQUIRE(iterator.value() == pair.second);
+    ++iterator;
+  }
+  REQUIRE(iterator == map.cend());
+
+  // Removes every other key, then the rest, so the nodes borrow and merge
+  for (ds::usize step = 0U; step < 2U; ++step) {
+    ds::usize i = 0U;
+    for (T key = (T)step; key < (T)(N * 2U); key += 2) {
+      map.remove(key);
+      expected.erase(key);
+      if (++i % CHECK_EVERY == 0U) {
+        REQUIRE(map.is_valid());
+        REQUIRE(map.get_size() == expected.size());
+      }
+    }
+    REQUIRE(map.is_valid());
+    REQUIRE(map.get_size() == expected.size());
+
+    for (const auto& pair : expected) {
+      T* pointer = map[pair.first];
+      REQUIRE(pointer != nullptr);
+      REQUIRE(*pointer == pair.second);
+    }
+  }
+  REQUIRE(map.is_empty());
+}
+
+// NOTE: 20, 24, 40 and 56 bytes fit an odd number of i32 or i64 keys, the
+//   degree is rounded down to an even number
+TEMPLATE_TEST_CASE(
+    "bptree_map node sizes", "[bptree_map]",
+    (std::integral_constant<ds::usize, 20U>),
+    (std::integral_constant<ds::usize, 24U>),
+    (std::integral_constant<ds::usize, 40U>),
+    (std::integral_constant<ds::usize, 56U>),
+    (std::integral_constant<ds::usize, ds::BPTREE_NODE_SIZE>),
+    (std::integral_constant<ds::usize, 256U>),
+    (std::integral_constant<ds::usize, 1'024U>),
+    (std::integral_constant<ds::usize, 4'096U>)
+) {
+  test_node_size<ds::i32, TestType::value>();
+  test_node_size<ds::i64, TestType::value>();
+  test_node_size<ds::u64, TestType::value>();
+}
+
+// === Bulk Load === //
+
+template <typename T, ds::usize NodeSize>
+inline void test_build_from_sorted(ds::usize n, ds::f32 fill) {
+  std::vector<T> keys{};
+  std::vector<T> values{};
+  for (ds::usize i = 0U; i < n; ++i) {
+    keys.push_back((T)(i * 3U));
+    values.push_back((T)i);
+  }
+
+  ds::bptree_map<T, T, ds::compare<T>, NodeSize> map{};
+  REQUIRE(ds_test::handle_error(
+      map.build_from_sorted(keys.data(), values.data(), n, fill)
+  ));
+  REQUIRE(map.is_valid());
+  REQUIRE(map.get_size() == n);
+
+  ds::usize index = 0U;
+  for (auto it = map.cbegin(); it != map.cend(); ++it, ++index) {
+    REQUIRE(it.key() == keys[index]);
+    REQUIRE(it.value() == values[index]);
+  }
+  REQUIRE(index == n);
+
+  for (ds::usize i = 0U; i < n; ++i) {
+    T* pointer = map[keys[i]];
+    REQUIRE(pointer != nullptr);
+    REQUIRE(*pointer == values[i]);
+    REQUIRE_FALSE(map.contains(keys[i] + 1));
+  }
+
+  // The loaded tree keeps working with inserts and removes
+  for (ds::usize i = 0U; i < n; ++i) {
+    REQUIRE(ds_test::handle_error(map.insert(keys[i] + 1, values[i])));
+  }
+  REQUIRE(map.is_valid());
+  REQUIRE(map.get_size() == n * 2U);
+
+  for (ds::usize i = 0U; i < n; ++i) {
+    map.remove(keys[i]);
+  }
+  REQUIRE(map.is_valid());
+  REQUIRE(map.get_size() == n);
+}
+
+TEMPLATE_TEST_CASE(
+    "bptree_map build from sorted", "[bptree_map]",
+    (std::integral_constant<ds::usize, 20U>),
+    (std::integral_constant<ds::usize, ds::BPTREE_NODE_SIZE>),
+    (std::integral_constant<ds::usize, 4'096U>)
+) {
+  const ds::usize DEGREE = ds::bptree_degree<ds::i32>(TestType::value);
+  const ds::usize SIZES[] = {0U,          1U,          DEGREE - 1U, DEGREE,
+                             DEGREE + 1U, DEGREE * 3U, 20'000U};
+  const ds::f32 FILLS[] = {0.5F, ds::BPTREE_FILL_FACTOR, 1.0F};
+
+  for (auto n : SIZES) {
+    for (auto fill : FILLS) {
+      test_build_from_sorted<ds::i32, TestType::value>(n, fill);
+      test_build_from_sorted<ds::u64, TestType::value>(n, fill);
+    }
+  }
+}
+
+TEST_CASE("bptree_map build from sorted errors", "[bptree_map]") {
+  ds::bptree_map<ds::i32, ds::i32> map{};
+  ds::i32 keys[] = {1, 2, 2, 3};
+  ds::i32 values[] = {1, 2, 3, 4};
+
+  REQUIRE(
+      map.build_from_sorted(keys, values, 4U) ==
+      ds::error_codes::INVALID_ARGUMENT
+  );
+  REQUIRE(
+      map.build_from_sorted(keys, values, 2U, 0.0F) ==
+      ds::error_codes::INVALID_ARGUMENT
+  );
+  REQUIRE(
+      map.build_from_sorted(keys, values, 2U, 1.5F) ==
+      ds::error_codes::INVALID_ARGUMENT
+  );
+  REQUIRE(map.is_empty());
+
+  // Replaces the previous contents
+  REQUIRE(ds_test::handle_error(map.insert(100, 100)));
+  REQUIRE(ds_test::handle_error(map.build_from_sorted(keys, values, 2U)));
+  REQUIRE(map.get_size() == 2U);
+  REQUIRE_FALSE(map.contains(100));
+  REQUIRE(map.is_valid());
+}
+
+// === Class Keys === //
+
+struct grid_key {
+  ds::i32 row;
+  ds::i32 column;
+};
+
+// Orders the keys by row, then by column
+struct grid_compare {
+  [[nodiscard]] ds::isize
+  operator()(const grid_key& key1, const grid_key& key2) const noexcept {
+    if (key1.row != key2.row) {
+      return key1.row < key2.row ? -1 : 1;
+    }
+    return key1.column < key2.column ? -1 : (key1.column > key2.column ? 1 : 0);
+  }
+};
+
+TEST_CASE("bptree_map class keys", "[bptree_map]") {
+  const ds::usize N = 2'000U;
+  ds::bptree_map<grid_key, ds::i64, grid_compare> map{};
+  std::map<std::pair<ds::i32, ds::i32>, ds::i64> expected{};
+
+  std::srand(N); // NOLINT
+  for (ds::usize i = 0U; i < N; ++i) {
+    grid_key key{.row = std::rand() % 64, .column = std::rand() % 64}; // NOLINT
+    REQUIRE(ds_test::handle_error(map.insert(key, (ds::i64)i)));
+    expected[{key.row, key.column}] = (ds::i64)i;
+  }
+  REQUIRE(map.is_valid());
+  REQUIRE(map.get_size() == expected.size());
+
+  auto iterator = map.cbegin();
+  for (const auto& pair : expected) {
+    REQUIRE(iterator.key().row == pair.first.first);
+    REQUIRE(iterator.key().column == pair.first.second);
+    REQUIRE(iterator.value() == pair.second);
+    ++iterator;
+  }
+  REQUIRE(iterator == map.cend());
+
+  for (ds::i32 row = 0; row < 64; row += 2) {
+    for (ds::i32 column = 0; column < 64; ++column) {
+      map.remove(grid_key{.row = row, .column = column});
+      expected.erase({row, column});
+    }
+  }
+  REQUIRE(map.is_valid());
+  REQUIRE(map.get_size() == expected.size());
+  for (const auto& pair : expected) {
+    ds::i64* pointer = map[grid_key{pair.first.first, pair.first.second}];
+    REQUIRE(pointer != nullptr);
+    REQUIRE(*pointer == pair.second);
+  }
+  REQUIRE_FALSE(map.contains(grid_key{.row = 0, .column = 0}));
+}
+
+// Only a few of these fit in a node of the default size
+struct wide_key {
+  ds::i64 a;
+  ds::i64 b;
+  ds::i64 c;
+};
+
+struct wide_compare {
+  [[nodiscard]] ds::isize
+  operator()(const wide_key& key1, const wide_key& key2) const noexcept {
+    const ds::i64 fields1[] = {key1.a, key1.b, key1.c};
+    const ds::i64 fields2[] = {key2.a, key2.b, key2.c};
+    for (ds::usize i = 0U; i < 3U; ++i) {
+      if (fields1[i] != fields2[i]) {
+        return fields1[i] < fields2[i] ? -1 : 1;
+      }
+    }
+    return 0;
+  }
+};
+
+TEST_CASE("bptree_map wide class keys", "[bptree_map]") {
+  const ds::i64 N = 5'000;
+  ds::bptree_map<wide_key, ds::i64, wide_compare> map{};
+  std::map<ds::i64, ds::i64> expected{};
+
+  // Random inserts and removes, the keys only differ in their last field
+  std::srand(N); // NOLINT
+  for (ds::i64 i = 0; i < N; ++i) {
+    ds::i64 c = std::rand() % (N / 4); // NOLINT
+    wide_key key{.a = 1, .b = 2, .c = c};
+    if (std::rand() % 3 == 0) { // NOLINT
+      map.remove(key);
+      expected.erase(c);
+    } else {
+      REQUIRE(ds_test::handle_error(map.insert(key, i)));
+      expected[c] = i;
+    }
+
+    ds::i64* pointer = map[key];
+    REQUIRE((pointer != nullptr) == expected.contains(c));
+    if (pointer != nullptr) {
+      REQUIRE(*pointer == expected[c]);
+    }
+  }
+  REQUIRE(map.is_valid());
+  REQUIRE(map.get_size() == expected.size());
+
+  auto iterator = map.cbegin();
+  for (const auto& pair : expected) {
+    REQUIRE(iterator.key().c == pair.first);
+    REQUIRE(iterator.value() == pair.second);
+    ++iterator;
+  }
+  REQUIRE(iterator == map.cend());
+}
+
+// === Class Values === //
+
+TEST_CASE("bptree_map class values", "[bptree_map]") {
+  // NOTE: The values own memory, leaks are checked by the sanitizers
+  const ds::i32 N = 2'000;
+  ds::bptree_map<ds::i32, ds::string> map{};
+  ds::string value{};
+
+  for (ds::i32 i = 0; i < N; ++i) {
+    REQUIRE(ds_test::handle_error(value.copy(std::to_string(i).c_str())));
+    REQUIRE(ds_test::handle_error(map.insert(i, value)));
+  }
+  for (ds::i32 i = 0; i < N; i += 2) {
+    map.remove(i);
+  }
+  REQUIRE(map.is_valid());
+  REQUIRE(map.get_size() == (ds::usize)N / 2U);
+  REQUIRE(*map[1] == "1");
+  REQUIRE(map[2] == nullptr);
+
+  // Moving into a map with values destroys its values
+  ds::bptree_map<ds::i32, ds::string> other{};
+  REQUIRE(ds_test::handle_error(other.insert(0, value)));
+  other = std::move(map);
+  REQUIRE(other.get_size() == (ds::usize)N / 2U);
+  REQUIRE(*other[N - 1] == std::to_string(N - 1).c_str());
+
+  other.clear();
+  REQUIRE(other.is_empty());
+  REQUIRE(ds_test::handle_error(other.insert(1, std::move(value))));
+  REQUIRE(*other[1] == std::to_string(N - 1).c_str());
+}
+
+// === String Keys === //
+
+// Paths that share long prefixes, like the keys of a file index
+inline std::string get_path(ds::usize index) {
+  return "/srv/storage/volumes/primary/users/" + std::to_string(index % 97U) +
+         "/documents/" + std::to_string(index);
+}
+
+TEST_CASE("bptree_map<string, i64> keys", "[bptree_map]") {
+  const ds::usize N = 5'000U;
+  ds::bptree_map<ds::string, ds::i64> map{};
+  std::map<std::string, ds::i64> expected{};
+
+  std::srand(N); // NOLINT
+  for (ds::usize i = 0U; i < N; ++i) {
+    std::string path = get_path((ds::usize)std::rand() % (N * 2U)); // NOLINT
+    auto value = (ds::i64)i;
+    expected[path] = value;
+
+    // Every kind of key, all of them are copied by the map
+    if (i % 3U == 0U) {
+      ds::string key{};
+      REQUIRE(ds_test::handle_error(key.copy(path.c_str())));
+      REQUIRE(ds_test::handle_error(map.insert(key, value)));
+    } else if (i % 3U == 1U) {
+      REQUIRE(ds_test::handle_error(map.insert(path.c_str(), value)));
+    } else {
+      ds::string_view key{path.c_str(), path.size()};
+      REQUIRE(ds_test::handle_error(map.insert(key, value)));
+    }
+  }
+  REQUIRE(map.is_valid());
+  REQUIRE(map.get_size() == expected.size());
+
+  auto iterator = map.cbegin();
+  for (const auto& pair : expected) {
+    REQUIRE(iterator.key() == pair.first.c_str());
+    REQUIRE(iterator.value() == pair.second);
+    ++iterator;
+  }
+  REQUIRE(iterator == map.cend());
+
+  for (ds::usize i = 0U; i < N * 2U; ++i) {
+    std::string path = get_path(i);
+    bool contains = expected.contains(path);
+    REQUIRE(map.contains(path.c_str()) == contains);
+
+    ds::i64* pointer = map[ds::string_view{path.c_str(), path.size()}];
+    REQUIRE((pointer != nullptr) == contains);
+    if (contains) {
+      REQUIRE(*pointer == expected[path]);
+    }
+  }
+
+  // Removes every other path, the keys are freed (checked by the sanitizers)
+  for (ds::usize i = 0U; i < N * 2U; i += 2U) {
+    std::string path = get_path(i);
+    map.remove(path.c_str());
+    expected.erase(path);
+  }
+  REQUIRE(map.is_valid());
+  REQUIRE(map.get_size() == expected.size());
+
+  for (const auto& pair : expected) {
+    ds::string key{};
+    REQUIRE(ds_test::handle_error(key.copy(pair.first.c_str())));
+    auto value = map.at(key);
+    REQUIRE(ds_test::handle_error(value));
+    REQUIRE(**value == pair.second);
+  }
+
+  // Move keeps the keys
+  ds::bptree_map<ds::string, ds::i64> moved{std::move(map)};
+  REQUIRE(map.is_empty()); // NOLINT
+  REQUIRE(moved.get_size() == expected.size());
+  REQUIRE(moved.contains(expected.begin()->first.c_str()));
+}
+
+TEST_CASE("bptree_map<string, i64> overwrite", "[bptree_map]") {
+  ds::bptree_map<ds::string, ds::i64> map{};
+  REQUIRE(ds_test::handle_error(map.insert("/a/b", 1)));
+  REQUIRE(ds_test::handle_error(map.insert("/a/b", 2)));
+  REQUIRE(ds_test::handle_error(map.insert("", 3)));
+  REQUIRE(map.get_size() == 2U);
+  REQUIRE(*map["/a/b"] == 2);
+  REQUIRE(*map[""] == 3);
+
+  // The keys own a null terminated copy
+  REQUIRE(std::strcmp(map.cbegin().key().data(), "") == 0);
+  REQUIRE(std::strcmp((++map.cbegin()).key().data(), "/a/b") == 0);
+
+  map.remove("/a");
+  REQUIRE(map.get_size() == 2U);
+  map.remove("/a/b");
+  REQUIRE(map.get_size() == 1U);
+  REQUIRE(map["/a/b"] == nullptr);
+
+  // Values that are copied with copy() are replaced in place
+  ds::bptree_map<ds::string, ds::string> strings{};
+  ds::string value{};
+  REQUIRE(ds_test::handle_error(value.copy("first")));
+  REQUIRE(ds_test::handle_error(strings.insert("/a", value)));
+  REQUIRE(ds_test::handle_error(value.copy("second")));
+  REQUIRE(ds_test::handle_error(strings.insert("/a", value)));
+  REQUIRE(strings.get_size() == 1U);
+  REQUIRE(*strings["/a"] == "second");
+  REQUIRE(value == "second");
+}
+
+TEST_CASE("bptree_map<string, i64> build from sorted", "[bptree_map]") {
+  const ds::usize N = 2'000U;
+  std::vector<std::string> paths{};
+  std::vector<ds::i64> values{};
+  for (ds::usize i = 0U; i < N; ++i) {
+    paths.push_back(get_path(i));
+    values.push_back((ds::i64)i);
+  }
+  std::sort(paths.begin(), paths.end());
+
+  std::vector<const ds::c8*> keys{};
+  for (const auto& path : paths) {
+    keys.push_back(path.c_str());
+  }
+
+  ds::bptree_map<ds::string, ds::i64> map{};
+  REQUIRE(ds_test::handle_error(map.insert("/old", -1)));
+  REQUIRE(ds_test::handle_error(
+      map.build_from_sorted(keys.data(), values.data(), N)
+  ));
+  REQUIRE(map.is_valid());
+  REQUIRE(map.get_size() == N);
+  REQUIRE_FALSE(map.contains("/old"));
+
+  for (ds::usize i = 0U; i < N; ++i) {
+    ds::i64* pointer = map[keys[i]];
+    REQUIRE(pointer != nullptr);
+    REQUIRE(*pointer == values[i]);
+  }
+
+  std::swap(keys[0], keys[1]);
+  REQUIRE(
+      map.build_from_sorted(keys.data(), values.data(), N) ==
+      ds::error_codes::INVALID_ARGUMENT
+  );
+  REQUIRE(map.get_size() == N);
+}
+
+TEST_CASE("bptree_map string leaf prefix", "[bptree_map]") {
+  ds::string_view keys[] = {"/a/b/c1", "/a/b/c2", "/a/b/d"};
+  ds::_bptree_map::leaf_prefix<ds::string_view, ds::compare<ds::string>>
+      prefix{};
+  prefix.update(keys, 3);
+  REQUIRE(prefix.get_size() == 5U);
+
+  REQUIRE(prefix.lower_bound(keys, 3, "/a/a") == 0);
+  REQUIRE(prefix.lower_bound(keys, 3, "/a") == 0);
+  REQUIRE(prefix.lower_bound(keys, 3, "/a/b/") == 0);
+  REQUIRE(prefix.lower_bound(keys, 3, "/a/b/c2") == 1);
+  REQUIRE(prefix.upper_bound(keys, 3, "/a/b/c2") == 2);
+  REQUIRE(prefix.lower_bound(keys, 3, "/a/b/c3") == 2);
+  REQUIRE(prefix.lower_bound(keys, 3, "/a/c") == 3);
+  REQUIRE(prefix.find_key(keys, 3, "/a/b/d") == 2);
+  REQUIRE(prefix.find_key(keys, 3, "/a/b/c") == -1);
+
+  prefix.update(keys, 1);
+  REQUIRE(prefix.get_size() == 7U);
+  REQUIRE(prefix.find_key(keys, 1, "/a/b/c1") == 0);
+  REQUIRE(prefix.lower_bound(keys, 1, "/a/b/c") == 0);
+  REQUIRE(prefix.lower_bound(keys, 1, "/a/b/c10") == 1);
+}
+
+TEST_CASE("bptree_map<string, i64> odd node size", "[bptree_map]") {
+  // NOTE: 80 bytes fit 5 string keys, the degree is rounded down to 4
+  const ds::usize N = 2'000U;
+  ds::bptree_map<ds::string, ds::i64, ds::compare<ds::string>, 80U> map{};
+  std::map<std::string, ds::i64> expected{};
+
+  std::srand(N); // NOLINT
+  for (ds::usize i = 0U; i < N; ++i) {
+    std::string path = get_path((ds::usize)std::rand() % N); // NOLINT
+    if (i % 3U == 2U) {
+      map.remove(path.c_str());
+      expected.erase(path);
+    } else {
+      REQUIRE(ds_test::handle_error(map.insert(path.c_str(), (ds::i64)i)));
+      expected[path] = (ds::i64)i;
+    }
+  }
+  REQUIRE(map.is_valid());
+  REQUIRE(map.get_size() == expected.size());
+
+  for (ds::usize i = 0U; i < N; ++i) {
+    std::string path = get_path(i);
+    ds::i64* pointer = map[path.c_str()];
+    REQUIRE((pointer != nullptr) == expected.contains(path));
+    if (pointer != nullptr) {
+      REQUIRE(*pointer == expected[path]);
+    }
+  }
+}
+
+// === Node Pool === //
+
+TEST_CASE("node_pool", "[bptree_map]") {
+  ds::node_pool<24U> pool{};
+  REQUIRE(pool.get_slab_count() == 0U);
+
+  void* blocks[ds::NODE_POOL_MIN_BLOCKS + 1U] = {};
+  for (auto& block : blocks) {
+    block = pool.allocate();
+    REQUIRE(block != nullptr);
+    std::memset(block, 0xFF, 24U);
+  }
+  // The first slab is full, so the last block is in a new one
+  REQUIRE(pool.get_slab_count() == 2U);
+
+  // Freed blocks are reused before carving new ones
+  pool.deallocate(blocks[2]);
+  pool.deallocate(blocks[5]);
+  REQUIRE(pool.get_free_count() == 2U);
+  REQUIRE(pool.allocate() == blocks[5]);
+  REQUIRE(pool.allocate() == blocks[2]);
+  REQUIRE(pool.get_free_count() == 0U);
+
+  ds::node_pool<24U> moved{std::move(pool)};
+  REQUIRE(pool.get_slab_count() == 0U); // NOLINT
+  REQUIRE(moved.get_slab_count() == 2U);
+
+  moved.release();
+  REQUIRE(moved.get_slab_count() == 0U);
+  REQUIRE(moved.allocate() != nullptr);
+  REQUIRE(moved.get_slab_count() == 1U);
+}
+
+TEST_CASE("bptree_map node reuse", "[bptree_map]") {
+  const ds::i32 N = 5'000;
+  ds::bptree_map<ds::i32, ds::i32> map{};
+
+  // Churn, the merged nodes are reused by the next splits
+  for (ds::i32 round = 0; round < 3; ++round) {
+    for (ds::i32 i = 0; i < N; ++i) {
+      REQUIRE(ds_test::handle_error(map.insert(i * 7 % N, i)));
+    }
+    REQUIRE(map.is_valid());
+    REQUIRE(map.get_size() == N);
+
+    for (ds::i32 i = 0; i < N; i += 2) {
+      map.remove(i * 3 % N);
+    }
+    REQUIRE(map.is_valid());
+  }
+
+  // Moving into a map frees its old nodes
+  ds::bptree_map<ds::i32, ds::i32> other{};
+  REQUIRE(ds_test::handle_error(other.insert(1, 1)));
+  other = std::move(map);
+  REQUIRE(map.is_empty()); // NOLINT
+  REQUIRE(other.is_valid());
+  REQUIRE(ds_test::handle_error(map.insert(1, 1)));
+
+  other.clear();
+  REQUIRE(other.is_empty());
+  REQUIRE(ds_test::handle_error(other.insert(2, 2)));
+  REQUIRE(*other[2] == 2);
+}
@@ -0,0 +1,211 @@
+/*===============================*
+ * Author/s:
+ *  - silentrald
+ * Version: 1.0
+ * Created: 2024-10-17
+ *===============================*/
+
+#include "ds-thread/concurrent_hash_map.hpp"
+#include "catch2/catch_test_macros.hpp"
+#include "ds/string.hpp"
+#include "ds/string_view.hpp"
+#include "ds/types.hpp"
+#include "main.hpp"
+#include <thread>
+#include <vector>
+
+const ds::u64 THREADS = 8U;
+const ds::u64 KEYS_PER_THREAD = 2'000U;
+const ds::u64 COUNTER_KEY = ds::USIZE_MAX;
+
+// === Single Thread === //
+
+TEST_CASE("concurrent_hash_map single thread", "[concurrent_hash_map]") {
+  ds::concurrent_hash_map<ds::u64, ds::u64> map{};
+  ds::u64 found = 0U;
+
+  for (ds::u64 i = 0U; i < 1000U; ++i) {
+    REQUIRE(ds_test::handle_error(map.insert(i, i * 2U)));
+  }
+  REQUIRE(*map.get_size() == 1000U);
+
+  for (ds::u64 i = 0U; i < 1000U; ++i) {
+    REQUIRE(ds_test::handle_error(
+        map.find(i, [&found](const ds::u64& value) { found = value; })
+    ));
+    REQUIRE(found == i * 2U);
+    REQUIRE(*map.contains(i));
+  }
+
+  // Non-existing
+  REQUIRE(
+      map.find(1000U, [](const ds::u64&) {}) == ds::error_codes::NOT_FOUND
+  );
+  REQUIRE(map.update(1000U, [](ds::u64&) {}) == ds::error_codes::NOT_FOUND);
+  REQUIRE_FALSE(*map.contains(1000U));
+
+  REQUIRE(ds_test::handle_error(map.update(1U, [](ds::u64& value) {
+    value = 7U;
+  })));
+  REQUIRE(ds_test::handle_error(
+      map.find(1U, [&found](const ds::u64& value) { found = value; })
+  ));
+  REQUIRE(found == 7U);
+
+  for (ds::u64 i = 0U; i < 1000U; i += 2U) {
+    REQUIRE(ds_test::handle_error(map.remove(i)));
+  }
+  REQUIRE(*map.get_size() == 500U);
+
+  ds::u64 count = 0U;
+  REQUIRE(ds_test::handle_error(
+      map.for_each([&count](const ds::u64& key, const ds::u64&) {
+        REQUIRE(key % 2U == 1U);
+        ++count;
+      })
+  ));
+  REQUIRE(count == 500U);
+
+  REQUIRE(ds_test::handle_error(map.clear()));
+  REQUIRE(*map.get_size() == 0U);
+}
+
+TEST_CASE("concurrent_hash_map<string, i64>", "[concurrent_hash_map]") {
+  ds::concurrent_hash_map<ds::string, ds::i64> map{};
+  ds::string string{};
+  ds::i64 found = 0;
+
+  REQUIRE(ds_test::handle_error(map.insert("Hello", 1)));
+  REQUIRE(ds_test::handle_error(string.copy("World")));
+  REQUIRE(ds_test::handle_error(map.insert(std::move(string), 2)));
+
+  REQUIRE(ds_test::handle_error(
+      map.find("Hello", [&found](const ds::i64& value) { found = value; })
+  ));
+  REQUIRE(found == 1);
+
+  const ds::c8* buffer = "WorldWide";
+  REQUIRE(ds_test::handle_error(map.find(
+      ds::string_view{buffer, 5U},
+      [&found](const ds::i64& value) { found = value; }
+  )));
+  REQUIRE(found == 2);
+  REQUIRE_FALSE(*map.contains(ds::string_view{buffer, 4U}));
+
+  REQUIRE(ds_test::handle_error(map.remove("Hello")));
+  REQUIRE_FALSE(*map.contains("Hello"));
+  REQUIRE(*map.get_size() == 1U);
+}
+
+TEST_CASE("concurrent_hash_map power of two policy", "[concurrent_hash_map]") {
+  // Sequential keys with the identity hash, the shard and the bucket index
+  //   should not be taken from the same bits of the hash
+  ds::concurrent_hash_map<
+      ds::u64, ds::u64, ds::hash<ds::u64>, ds::equal<ds::u64>,
+      ds::power_of_two_hash_policy>
+      map{};
+  const ds::u64 keys = 20'000U;
+
+  for (ds::u64 i = 0U; i < keys; ++i) {
+    REQUIRE(ds_test::handle_error(map.insert(i, i)));
+  }
+  REQUIRE(*map.get_size() == keys);
+  for (ds::u64 i = 0U; i < keys; ++i) {
+    REQUIRE(*map.contains(i));
+  }
+
+#ifdef DS_HASH_STATS
+  for (ds::usize s = 0U; s < map.get_shard_count(); ++s) {
+    auto stats = map.get_stats(s);
+    REQUIRE(stats);
+    REQUIRE(stats->max_probe_length < 32U);
+    REQUIRE(stats->average_hit_probe < 4.0);
+  }
+#endif
+}
+
+// === Multiple Threads === //
+
+TEST_CASE("concurrent_hash_map multiple threads", "[concurrent_hash_map]") {
+  ds::concurrent_hash_map<ds::u64, ds::u64> map{};
+  std::vector<std::thread> threads{};
+  // NOTE: Catch2 assertions are not thread safe, errors are checked after
+  ds::error_code errors[THREADS]{}; // NOLINT
+
+  // Each thread inserts its own keys and bumps a shared counter
+  REQUIRE(ds_test::handle_error(map.insert(COUNTER_KEY, 0U)));
+  for (ds::u64 t = 0U; t < THREADS; ++t) {
+    threads.emplace_back([&map, &errors, t]() {
+      for (ds::u64 i = 0U; i < KEYS_PER_THREAD; ++i) {
+        ds::u64 key = t * KEYS_PER_THREAD + i;
+        ds::error_code error = map.insert(key, key * 2U);
+        if (error == ds::error_codes::OK) {
+          error = map.update(COUNTER_KEY, [](ds::u64& value) { ++value; });
+        }
+        if (error != ds::error_codes::OK) {
+          errors[t] = error;
+          return;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  threads.clear();
+
+  for (auto error : errors) {
+    REQUIRE(ds_test::handle_error(error));
+  }
+  REQUIRE(*map.get_size() == THREADS * KEYS_PER_THREAD + 1U);
+
+  ds::u64 counter = 0U;
+  REQUIRE(ds_test::handle_error(map.find(
+      COUNTER_KEY, [&counter](const ds::u64& value) { counter = value; }
+  )));
+  REQUIRE(counter == THREADS * KEYS_PER_THREAD);
+
+  // Half of the threads remove the even keys while the rest read them
+  bool mismatches[THREADS]{}; // NOLINT
+  for (ds::u64 t = 0U; t < THREADS; ++t) {
+    threads.emplace_back([&map, &errors, &mismatches, t]() {
+      for (ds::u64 i = 0U; i < THREADS * KEYS_PER_THREAD; ++i) {
+        if (t % 2U == 0U) {
+          if (i % 2U == 0U) {
+            errors[t] = map.remove(i);
+          }
+          continue;
+        }
+
+        ds::error_code error = map.find(i, [&mismatches, t, i](
+                                               const ds::u64& value
+                                           ) {
+          mismatches[t] |= value != i * 2U;
+        });
+        if (error == ds::error_codes::OK) {
+          continue;
+        }
+
+        // Only removed keys can be missing
+        if (error != ds::error_codes::NOT_FOUND || i % 2U == 1U) {
+          errors[t] = error == ds::error_codes::OK
+                          ? ds::error_codes::NOT_FOUND
+                          : error;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (ds::u64 t = 0U; t < THREADS; ++t) {
+    REQUIRE(ds_test::handle_error(errors[t]));
+    REQUIRE_FALSE(mismatches[t]);
+  }
+  REQUIRE(*map.get_size() == THREADS * KEYS_PER_THREAD / 2U + 1U);
+
+  for (ds::u64 i = 0U; i < THREADS * KEYS_PER_THREAD; ++i) {
+    REQUIRE(*map.contains(i) == (i % 2U == 1U));
+  }
+}
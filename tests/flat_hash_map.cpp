@@ -0,0 +1,394 @@
+/*===============================*
+ * Author/s:
+ *  - silentrald
+ * Version: 1.0
+ * Created: 2024-10-16
+ *===============================*/
+
+#include "ds/flat_hash_map.hpp"
+#include "catch2/catch_template_test_macros.hpp"
+#include "catch2/catch_test_macros.hpp"
+#include "ds/expected.hpp"
+#include "ds/string.hpp"
+#include "ds/string_view.hpp"
+#include "ds/types.hpp"
+#include "main.hpp"
+#include <cstdio>
+#include <tuple>
+
+// Enough keys to go through a few resizes
+const ds::usize SIZE = 1000;
+// Keys that only differ in their high bits
+const ds::usize STRIDE = 4096;
+
+// === Inserting === //
+
+template <typename Key, typename Value, bool Strided, bool Check = false>
+ds::expected<ds::flat_hash_map<Key, Value>, ds::error_code>
+create_flat_hash_map() {
+  ds::flat_hash_map<Key, Value> map{};
+  ds::error_code error_code{};
+
+  for (Key i = 0; i < (Key)SIZE; ++i) {
+    Key key = Strided ? i * STRIDE : i;
+    if constexpr (Check) {
+      error_code = map.insert(key, i * 2);
+      REQUIRE(ds_test::handle_error(error_code));
+      REQUIRE(map.get_size() == (ds::usize)i + 1U);
+      REQUIRE(map.get_capacity() > map.get_size());
+    } else {
+      DS_TRY(map.insert(key, i * 2), ds::to_unexpected);
+    }
+  }
+
+  return map;
+}
+
+// NOLINTNEXTLINE
+TEMPLATE_TEST_CASE(
+    "flat_hash_map<int_type, int_type> insert", "[flat_hash_map]",
+    (std::tuple<ds::i32, ds::i32>), (std::tuple<ds::i64, ds::i64>),
+    (std::tuple<ds::u32, ds::u32>), (std::tuple<ds::u64, ds::u64>)
+) {
+  using key_type = typename std::tuple_element<0, TestType>::type;
+  using value_type = typename std::tuple_element<1, TestType>::type;
+  create_flat_hash_map<key_type, value_type, false, true>();
+  create_flat_hash_map<key_type, value_type, true, true>();
+}
+
+// === Accessing === //
+
+template <typename Key, typename Value, bool Strided> void test_access() {
+  ds::flat_hash_map<Key, Value> map = ({
+    auto expected_map = create_flat_hash_map<Key, Value, Strided>();
+    REQUIRE(ds_test::handle_error(expected_map));
+    std::move(*expected_map);
+  });
+
+  for (Key i = 0; i < (Key)SIZE; ++i) {
+    Key key = Strided ? i * STRIDE : i;
+
+    auto expected = map.at(key);
+    REQUIRE(ds_test::handle_error(expected));
+    REQUIRE(**expected == i * 2);
+
+    Value* pointer = map[key];
+    REQUIRE(pointer != nullptr);
+    REQUIRE(*pointer == i * 2);
+
+    REQUIRE(map.contains(key));
+
+    // Non-existing
+    key = Strided ? i * STRIDE + 1 : i + SIZE;
+    expected = map.at(key);
+    REQUIRE_FALSE(expected);
+    REQUIRE(expected.error() == ds::error_codes::NOT_FOUND);
+    REQUIRE(map[key] == nullptr);
+    REQUIRE_FALSE(map.contains(key));
+  }
+}
+
+// NOLINTNEXTLINE
+TEMPLATE_TEST_CASE(
+    "flat_hash_map<int_type, int_type> access", "[flat_hash_map]",
+    (std::tuple<ds::i32, ds::i32>), (std::tuple<ds::i64, ds::i64>),
+    (std::tuple<ds::u32, ds::u32>), (std::tuple<ds::u64, ds::u64>)
+) {
+  using key_type = typename std::tuple_element<0, TestType>::type;
+  using value_type = typename std::tuple_element<1, TestType>::type;
+  test_access<key_type, value_type, false>();
+  test_access<key_type, value_type, true>();
+}
+
+// === Removing === //
+
+template <typename Key, typename Value, bool Strided> void test_remove() {
+  ds::flat_hash_map<Key, Value> map = ({
+    auto expected_map = create_flat_hash_map<Key, Value, Strided>();
+    REQUIRE(ds_test::handle_error(expected_map));
+    std::move(*expected_map);
+  });
+
+  // Non-existing
+  map.remove(Strided ? STRIDE + 1 : SIZE);
+  REQUIRE(map.get_size() == SIZE);
+
+  for (Key i = 0; i < (Key)SIZE; i += 2) {
+    map.remove(Strided ? i * STRIDE : i);
+  }
+  REQUIRE(map.get_size() == SIZE / 2);
+
+  for (Key i = 0; i < (Key)SIZE; ++i) {
+    REQUIRE(map.contains(Strided ? i * STRIDE : i) == (i % 2 == 1));
+  }
+
+  // Reinserting over the deleted slots
+  for (Key i = 0; i < (Key)SIZE; i += 2) {
+    REQUIRE(ds_test::handle_error(map.insert(Strided ? i * STRIDE : i, i)));
+  }
+  REQUIRE(map.get_size() == SIZE);
+
+  for (Key i = 0; i < (Key)SIZE; ++i) {
+    Value* pointer = map[Strided ? i * STRIDE : i];
+    REQUIRE(pointer != nullptr);
+    REQUIRE(*pointer == (i % 2 == 1 ? i * 2 : i));
+  }
+}
+
+// NOLINTNEXTLINE
+TEMPLATE_TEST_CASE(
+    "flat_hash_map<int_type, int_type> remove", "[flat_hash_map]",
+    (std::tuple<ds::i32, ds::i32>), (std::tuple<ds::i64, ds::i64>),
+    (std::tuple<ds::u32, ds::u32>), (std::tuple<ds::u64, ds::u64>)
+) {
+  using key_type = typename std::tuple_element<0, TestType>::type;
+  using value_type = typename std::tuple_element<1, TestType>::type;
+  test_remove<key_type, value_type, false>();
+  test_remove<key_type, value_type, true>();
+}
+
+TEST_CASE("flat_hash_map remove and insert churn", "[flat_hash_map]") {
+  ds::flat_hash_map<ds::u64, ds::u64> map{};
+
+  // Keeps filling the bucket with tombstones
+  for (ds::u64 i = 0U; i < SIZE * 100U; ++i) {
+    REQUIRE(ds_test::handle_error(map.insert(i, i)));
+    if (i >= 10U) {
+      map.remove(i - 10U);
+    }
+    REQUIRE(map.get_size() == (i >= 10U ? 10U : i + 1U));
+  }
+
+  for (ds::u64 i = SIZE * 100U - 10U; i < SIZE * 100U; ++i) {
+    REQUIRE(map.contains(i));
+  }
+  REQUIRE(map.get_capacity() <= 32U);
+}
+
+// === Clearing === //
+
+TEST_CASE("flat_hash_map clearing", "[flat_hash_map]") {
+  ds::flat_hash_map<ds::u64, ds::u64> map = ({
+    auto expected_map = create_flat_hash_map<ds::u64, ds::u64, false>();
+    REQUIRE(ds_test::handle_error(expected_map));
+    std::move(*expected_map);
+  });
+
+  map.clear();
+  REQUIRE(map.is_empty());
+  for (ds::u64 i = 0U; i < SIZE; ++i) {
+    REQUIRE_FALSE(map.contains(i));
+  }
+
+  REQUIRE(ds_test::handle_error(map.insert(1U, 2U)));
+  REQUIRE(map.get_size() == 1U);
+  REQUIRE(*map[1U] == 2U);
+}
+
+// === Copying === //
+
+TEST_CASE("flat_hash_map copy", "[flat_hash_map]") {
+  ds::flat_hash_map<ds::u64, ds::u64> map{};
+  ds::flat_hash_map<ds::u64, ds::u64> copy{};
+
+  REQUIRE(ds_test::handle_error(copy.copy(map)));
+  REQUIRE(copy.is_empty());
+
+  // Leaves tombstones in the bucket, they are copied with the control bytes
+  for (ds::u64 i = 0U; i < SIZE; ++i) {
+    REQUIRE(ds_test::handle_error(map.insert(i, i * 3U)));
+  }
+  for (ds::u64 i = 0U; i < SIZE; i += 2U) {
+    map.remove(i);
+  }
+
+  REQUIRE(ds_test::handle_error(copy.insert(SIZE, 0U)));
+  REQUIRE(ds_test::handle_error(copy.copy(map)));
+  REQUIRE(copy.get_size() == map.get_size());
+  REQUIRE(copy.get_capacity() == map.get_capacity());
+  REQUIRE_FALSE(copy.contains(SIZE));
+  for (ds::u64 i = 0U; i < SIZE; ++i) {
+    REQUIRE(copy.contains(i) == (i % 2U == 1U));
+    if (i % 2U == 1U) {
+      REQUIRE(*copy[i] == i * 3U);
+      REQUIRE(copy[i] != map[i]);
+    }
+  }
+
+  // Both are independent after the copy
+  REQUIRE(ds_test::handle_error(copy.insert(0U, 0U)));
+  REQUIRE_FALSE(map.contains(0U));
+}
+
+TEST_CASE("flat_hash_map<string, string> copy", "[flat_hash_map]") {
+  ds::flat_hash_map<ds::string, ds::string> map{};
+  ds::flat_hash_map<ds::string, ds::string> copy{};
+
+  REQUIRE(ds_test::handle_error(map.insert("Hello", "World")));
+  REQUIRE(ds_test::handle_error(map.insert("My", "Name")));
+  REQUIRE(ds_test::handle_error(copy.insert("Is", "Jeff")));
+
+  REQUIRE(ds_test::handle_error(copy.copy(map)));
+  REQUIRE(copy.get_size() == 2U);
+  REQUIRE(*copy["Hello"] == "World");
+  REQUIRE(*copy["My"] == "Name");
+  REQUIRE_FALSE(copy.contains("Is"));
+
+  map.remove("Hello");
+  REQUIRE(*copy["Hello"] == "World");
+}
+
+// === Edge Case: empty flat_hash_maps === //
+
+TEST_CASE("flat_hash_map is empty", "[flat_hash_map]") {
+  ds::flat_hash_map<ds::i32, ds::i32> map{};
+
+  REQUIRE(map.is_empty());
+  REQUIRE(map.get_size() == 0);
+  REQUIRE(map.get_capacity() == 0);
+
+  REQUIRE_FALSE(map.contains(0));
+  REQUIRE(map[0] == nullptr);
+  map.remove(0);
+
+  auto expected = map.at(0);
+  REQUIRE_FALSE(expected);
+  REQUIRE(expected.error() == ds::error_codes::NOT_FOUND);
+
+  REQUIRE(map.begin() == map.end());
+}
+
+// === Iterating === //
+
+TEST_CASE("flat_hash_map iteration", "[flat_hash_map]") {
+  ds::flat_hash_map<ds::u64, ds::u64> map = ({
+    auto expected_map = create_flat_hash_map<ds::u64, ds::u64, true>();
+    REQUIRE(ds_test::handle_error(expected_map));
+    std::move(*expected_map);
+  });
+
+  ds::usize count = 0U;
+  for (auto it = map.begin(); it != map.end(); ++it) {
+    REQUIRE(it.key() == it.value() / 2U * STRIDE);
+    ++count;
+  }
+  REQUIRE(count == SIZE);
+
+  count = 0U;
+  for (auto it = map.cbegin(); it != map.cend(); ++it) {
+    REQUIRE(it.key() == it.value() / 2U * STRIDE);
+    ++count;
+  }
+  REQUIRE(count == SIZE);
+}
+
+// === Key String Types === //
+
+TEST_CASE("flat_hash_map<string, i64>", "[flat_hash_map]") {
+  ds::flat_hash_map<ds::string, ds::i64> map{};
+  ds::string string{};
+  ds::c8 characters[32]; // NOLINT
+
+  for (ds::i64 i = 0; i < (ds::i64)SIZE; ++i) {
+    std::snprintf(characters, sizeof(characters), "key_%04lld", i);
+    if (i % 2 == 0) {
+      REQUIRE(ds_test::handle_error(map.insert(characters, i)));
+    } else {
+      REQUIRE(ds_test::handle_error(string.copy(characters)));
+      REQUIRE(ds_test::handle_error(map.insert(std::move(string), i)));
+    }
+  }
+  REQUIRE(map.get_size() == SIZE);
+
+  for (ds::i64 i = 0; i < (ds::i64)SIZE; ++i) {
+    std::snprintf(characters, sizeof(characters), "key_%04lld", i);
+    REQUIRE(map.contains(characters));
+    REQUIRE(*map[characters] == i);
+
+    REQUIRE(ds_test::handle_error(string.copy(characters)));
+    auto expected = map.at(string);
+    REQUIRE(ds_test::handle_error(expected));
+    REQUIRE(**expected == i);
+  }
+
+  REQUIRE_FALSE(map.contains("key_"));
+  REQUIRE_FALSE(map.contains("missing"));
+
+  for (ds::i64 i = 0; i < (ds::i64)SIZE; i += 2) {
+    std::snprintf(characters, sizeof(characters), "key_%04lld", i);
+    map.remove(characters);
+  }
+  REQUIRE(map.get_size() == SIZE / 2);
+
+  for (ds::i64 i = 0; i < (ds::i64)SIZE; ++i) {
+    std::snprintf(characters, sizeof(characters), "key_%04lld", i);
+    REQUIRE(map.contains(characters) == (i % 2 == 1));
+  }
+}
+
+TEST_CASE("flat_hash_map<string, i64> view lookups", "[flat_hash_map]") {
+  ds::flat_hash_map<ds::string, ds::i64> map{};
+  const auto& cmap = map;
+  REQUIRE(ds_test::handle_error(map.insert("GET", 1)));
+  REQUIRE(ds_test::handle_error(map.insert("/index.html", 2)));
+
+  // Keys sliced out of a buffer, none of them are null terminated
+  const ds::c8* buffer = "GET /index.html HTTP/1.1";
+  ds::string_view method{buffer, 3U};
+  ds::string_view path{buffer + 4U, 11U};
+
+  auto expected = map.at(method);
+  REQUIRE(ds_test::handle_error(expected));
+  REQUIRE(**expected == 1);
+  REQUIRE(*map[path] == 2);
+  REQUIRE(*cmap[path] == 2);
+
+  REQUIRE_FALSE(map.contains(ds::string_view{buffer, 2U}));
+  REQUIRE_FALSE(map.contains(ds::string_view{buffer, 4U}));
+
+  map.remove(method);
+  REQUIRE(map.get_size() == 1);
+  REQUIRE_FALSE(map.contains("GET"));
+}
+
+TEST_CASE("flat_hash_map<string, string>", "[flat_hash_map]") {
+  ds::flat_hash_map<ds::string, ds::string> map{};
+  ds::string key{};
+  ds::string value{};
+
+  REQUIRE(ds_test::handle_error(map.insert("Hello", "World")));
+
+  REQUIRE(ds_test::handle_error(key.copy("My")));
+  REQUIRE(ds_test::handle_error(map.insert(key, "Name")));
+
+  REQUIRE(ds_test::handle_error(value.copy("Jeff")));
+  REQUIRE(ds_test::handle_error(map.insert("Is", std::move(value))));
+  REQUIRE(map.get_size() == 3);
+
+  REQUIRE(*map["Hello"] == "World");
+  REQUIRE(*map[key] == "Name");
+  REQUIRE(*map["Is"] == "Jeff");
+
+  // Overwriting
+  REQUIRE(ds_test::handle_error(map.insert("Hello", "There")));
+  REQUIRE(map.get_size() == 3);
+  REQUIRE(*map["Hello"] == "There");
+
+  map.remove("My");
+  REQUIRE(map.get_size() == 2);
+  REQUIRE_FALSE(map.contains("My"));
+  REQUIRE(map.contains("Is"));
+}
+
+TEST_CASE("flat_hash_map<i64, string>", "[flat_hash_map]") {
+  ds::flat_hash_map<ds::i64, ds::string> map{};
+
+  REQUIRE(ds_test::handle_error(map.insert(1, "One")));
+  REQUIRE(ds_test::handle_error(map.insert(2, "Two")));
+  REQUIRE(ds_test::handle_error(map.insert(1, "Uno")));
+  REQUIRE(map.get_size() == 2);
+
+  REQUIRE(*map[1] == "Uno");
+  REQUIRE(*map[2] == "Two");
+  REQUIRE(map[3] == nullptr);
+}
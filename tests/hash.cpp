@@ -0,0 +1,333 @@
+/*===============================*
+ * Author/s:
+ *  - silentrald
+ * Version: 1.0
+ * Created: 2024-10-17
+ *===============================*/
+
+#include "ds/hash.hpp"
+#include "catch2/catch_test_macros.hpp"
+#include "ds/equal.hpp"
+#include "ds/hash_map.hpp"
+#include "ds/hash_policy.hpp"
+#include "ds/string.hpp"
+#include "ds/string_view.hpp"
+#include "ds/types.hpp"
+#include "main.hpp"
+#include <cstring>
+#include <unordered_set>
+
+const ds::usize HASH_BUFFER_SIZE = 300U;
+
+TEST_CASE("hash<string> of every type agrees", "[hash]") {
+  ds::c8 buffer[HASH_BUFFER_SIZE + 1U]; // NOLINT
+  ds::hash<ds::string> hash{};
+  ds::hash<const ds::c8*> c8_hash{};
+  ds::string string{};
+
+  // Covers the 0-3, 4-16, 17-48 and longer paths
+  for (ds::usize size = 0U; size <= HASH_BUFFER_SIZE; ++size) {
+    for (ds::usize i = 0U; i < size; ++i) {
+      buffer[i] = (ds::c8)('a' + (i * 7U + size) % 26U);
+    }
+    buffer[size] = '\0';
+    REQUIRE(ds_test::handle_error(string.copy(buffer)));
+
+    ds::usize expected = ds::hash_bytes(buffer, size);
+    REQUIRE(hash(string) == expected);
+    REQUIRE(hash(buffer) == expected);
+    REQUIRE(hash(ds::string_view{buffer, size}) == expected);
+    REQUIRE(c8_hash(buffer) == expected);
+  }
+}
+
+TEST_CASE("hash<const c8*> hashes the characters", "[hash]") {
+  ds::c8 first[] = "same key";  // NOLINT
+  ds::c8 second[] = "same key"; // NOLINT
+  ds::hash<const ds::c8*> hash{};
+
+  REQUIRE(hash(first) == hash(second));
+  REQUIRE(hash(first) != hash("same kez"));
+
+  // equal<const c8*> has to agree, keys at different addresses are the same
+  ds::equal<const ds::c8*> equal{};
+  REQUIRE(equal(first, second));
+  REQUIRE_FALSE(equal(first, "same kez"));
+
+  ds::hash_map<const ds::c8*, ds::i32> map{};
+  REQUIRE(ds_test::handle_error(map.insert(first, 1)));
+  REQUIRE(ds_test::handle_error(map.insert(second, 2)));
+  REQUIRE(map.get_size() == 1U);
+  REQUIRE(*map["same key"] == 2);
+  REQUIRE_FALSE(map.contains("same kez"));
+}
+
+TEST_CASE("wyhash spreads every byte", "[hash]") {
+  ds::u8 buffer[HASH_BUFFER_SIZE]{}; // NOLINT
+  std::unordered_set<ds::u64> seen{};
+
+  // Flipping any bit of any length gives a new hash
+  for (ds::usize size = 1U; size <= 64U; ++size) {
+    REQUIRE(seen.insert(ds::wyhash_bytes(buffer, size)).second);
+    for (ds::usize i = 0U; i < size * 8U; ++i) {
+      buffer[i / 8U] ^= (ds::u8)(1U << (i % 8U));
+      REQUIRE(seen.insert(ds::wyhash_bytes(buffer, size)).second);
+      buffer[i / 8U] ^= (ds::u8)(1U << (i % 8U));
+    }
+  }
+
+  // Uses the upper 32 bits as well
+  ds::u64 upper = 0U;
+  for (ds::u64 key = 0U; key < 64U; ++key) {
+    upper |= ds::wyhash_bytes(&key, sizeof(key)) >> 32U;
+  }
+  REQUIRE(upper == 0xFFFF'FFFFU);
+}
+
+TEST_CASE("wyhash seeds", "[hash]") {
+  const ds::c8* key = "Hello World!";
+  ds::usize size = std::strlen(key);
+
+  REQUIRE(wyhash64(key, size, 0U) == wyhash64(key, size, 0U));
+  REQUIRE(wyhash64(key, size, 0U) != wyhash64(key, size, 1U));
+  REQUIRE(
+      ds::wyhash_bytes(key, size) == wyhash64(key, size, ds::get_hash_seed())
+  );
+}
+
+TEST_CASE("murmur3 stays available", "[hash]") {
+  const ds::c8* key = "Hello World!";
+  ds::u32 out = 0U;
+
+  MurmurHash3_x86_32(
+      key, (ds::i32)std::strlen(key), (ds::u32)ds::get_hash_seed(), &out
+  );
+  REQUIRE(ds::murmur3_bytes(key, std::strlen(key)) == out);
+}
+
+// === Integer Mixers === //
+
+TEST_CASE("integer mixers", "[hash]") {
+  std::unordered_set<ds::u64> fmix{};
+  std::unordered_set<ds::u64> splitmix{};
+
+  // Patterned keys (strides of 2^20) still vary in the low bits
+  ds::u64 fmix_low = 0U;
+  ds::u64 splitmix_low = 0U;
+  for (ds::u64 i = 0U; i < 1024U; ++i) {
+    ds::u64 key = i << 20U;
+    REQUIRE(fmix.insert(ds::fmix64(key)).second);
+    REQUIRE(splitmix.insert(ds::splitmix64(key)).second);
+    fmix_low |= 1ULL << (ds::fmix64(key) & 63U);
+    splitmix_low |= 1ULL << (ds::splitmix64(key) & 63U);
+  }
+  REQUIRE(fmix_low == ~0ULL);
+  REQUIRE(splitmix_low == ~0ULL);
+
+  REQUIRE(ds::fmix64(0U) == 0U);
+  REQUIRE(ds::splitmix64(0U) != 0U);
+  REQUIRE(ds::fmix_hash<ds::i32>{}(-1) == ds::fmix64((ds::u64)-1));
+}
+
+// === Composite Keys === //
+
+struct composite_key {
+  ds::u64 tenant_id;
+  ds::u64 object_id;
+
+  bool operator==(const composite_key& rhs) const noexcept {
+    return this->tenant_id == rhs.tenant_id &&
+           this->object_id == rhs.object_id;
+  }
+};
+
+struct composite_hash {
+  ds::usize operator()(const composite_key& key) const noexcept {
+    return ds::hasher{}.add(key.tenant_id).add(key.object_id).finish();
+  }
+};
+
+TEST_CASE("hash_combine and hasher", "[hash]") {
+  ds::usize a = ds::hash<ds::u64>{}(1U);
+  ds::usize b = ds::hash<ds::u64>{}(2U);
+
+  // Order dependent
+  REQUIRE(
+      ds::hash_combine(ds::hash_combine(0U, a), b) !=
+      ds::hash_combine(ds::hash_combine(0U, b), a)
+  );
+  REQUIRE(
+      ds::hasher{}.add(1U).add(2U).finish() !=
+      ds::hasher{}.add(2U).add(1U).finish()
+  );
+  REQUIRE(ds::hasher{1U}.add(1U).finish() != ds::hasher{2U}.add(1U).finish());
+
+  // Every field type goes through its own hash
+  ds::string string{};
+  REQUIRE(ds_test::handle_error(string.copy("key")));
+  REQUIRE(
+      ds::hasher{}.add(string).finish() ==
+      ds::hasher{}.add_bytes("key", 3U).finish()
+  );
+  REQUIRE(
+      ds::hasher{}.add<ds::u64, ds::fmix_hash<ds::u64>>(7U).finish() ==
+      ds::hash_combine(ds::get_hash_seed(), ds::fmix64(7U))
+  );
+
+  // Composite keys in a power of two map
+  ds::hash_map<
+      composite_key, ds::u64, composite_hash, ds::equal<composite_key>,
+      ds::power_of_two_hash_policy>
+      map{};
+  for (ds::u64 tenant = 0U; tenant < 64U; ++tenant) {
+    for (ds::u64 object = 0U; object < 64U; ++object) {
+      REQUIRE(ds_test::handle_error(
+          map.insert(composite_key{tenant, object << 32U}, tenant + object)
+      ));
+    }
+  }
+  REQUIRE(map.get_size() == 64U * 64U);
+  REQUIRE(*map[composite_key{3U, 5ULL << 32U}] == 8U);
+  REQUIRE(map[composite_key{5U, 3U}] == nullptr);
+}
+
+TEST_CASE("fmix_hash and splitmix_hash in a hash_map", "[hash]") {
+  // Only the upper bits of the keys change
+  ds::hash_map<
+      ds::u64, ds::u64, ds::fmix_hash<ds::u64>, ds::equal<ds::u64>,
+      ds::power_of_two_hash_policy>
+      fmix{};
+  ds::hash_map<
+      ds::u64, ds::u64, ds::splitmix_hash<ds::u64>, ds::equal<ds::u64>,
+      ds::power_of_two_hash_policy>
+      splitmix{};
+
+  for (ds::u64 i = 0U; i < 10'000U; ++i) {
+    REQUIRE(ds_test::handle_error(fmix.insert(i << 32U, i)));
+    REQUIRE(ds_test::handle_error(splitmix.insert(i << 32U, i)));
+  }
+  for (ds::u64 i = 0U; i < 10'000U; ++i) {
+    REQUIRE(*fmix[i << 32U] == i);
+    REQUIRE(*splitmix[i << 32U] == i);
+  }
+}
+
+// === Streaming Murmur3 === //
+
+TEST_CASE("streaming murmur3 matches the one-shot hash", "[hash]") {
+  ds::u8 buffer[HASH_BUFFER_SIZE]; // NOLINT
+  for (ds::usize i = 0U; i < HASH_BUFFER_SIZE; ++i) {
+    buffer[i] = (ds::u8)(i * 31U + 7U);
+  }
+
+  // Every length split in fragments of every size up to 20 bytes
+  for (ds::usize size = 0U; size <= HASH_BUFFER_SIZE; size += 13U) {
+    ds::u32 expected32 = 0U;
+    ds::u32 expected_x86_128[4]{}; // NOLINT
+    ds::u64 expected128[2]{};      // NOLINT
+    MurmurHash3_x86_32(buffer, (ds::i32)size, ds::SEED, &expected32);
+    MurmurHash3_x86_128(buffer, (ds::i32)size, ds::SEED, expected_x86_128);
+    MurmurHash3_x64_128(buffer, (ds::i32)size, ds::SEED, expected128);
+
+    for (ds::usize fragment = 1U; fragment <= 20U; ++fragment) {
+      MurmurHash3_x86_32_state state32{};
+      MurmurHash3_x86_128_state state_x86_128{};
+      MurmurHash3_x64_128_state state128{};
+      MurmurHash3_x86_32_init(&state32, ds::SEED);
+      MurmurHash3_x86_128_init(&state_x86_128, ds::SEED);
+      MurmurHash3_x64_128_init(&state128, ds::SEED);
+      ds::murmur3_hasher hasher{};
+
+      for (ds::usize i = 0U; i < size; i += fragment) {
+        ds::usize length = size - i < fragment ? size - i : fragment;
+        MurmurHash3_x86_32_update(&state32, buffer + i, (ds::i32)length);
+        MurmurHash3_x86_128_update(
+            &state_x86_128, buffer + i, (ds::i32)length
+        );
+        MurmurHash3_x64_128_update(&state128, buffer + i, (ds::i32)length);
+        hasher.update(buffer + i, length);
+      }
+
+      ds::u32 out32 = 0U;
+      ds::u32 out_x86_128[4]{}; // NOLINT
+      ds::u64 out128[2]{};      // NOLINT
+      MurmurHash3_x86_32_final(&state32, &out32);
+      MurmurHash3_x86_128_final(&state_x86_128, out_x86_128);
+      MurmurHash3_x64_128_final(&state128, out128);
+      REQUIRE(out32 == expected32);
+      for (ds::usize i = 0U; i < 4U; ++i) {
+        REQUIRE(out_x86_128[i] == expected_x86_128[i]);
+      }
+      REQUIRE(out128[0] == expected128[0]);
+      REQUIRE(out128[1] == expected128[1]);
+      REQUIRE(hasher.finish() == ds::murmur3_bytes(buffer, size));
+    }
+  }
+
+  // Empty fragments change nothing
+  const ds::c8* key = "Hello World!";
+  ds::murmur3_hasher hasher{};
+  hasher.update(ds::string_view{key, 5U})
+      .update(key, 0U)
+      .update(ds::string_view{key + 5U, 7U});
+  REQUIRE(hasher.finish() == ds::murmur3_bytes(key, std::strlen(key)));
+}
+
+// === Batched Hashing === //
+
+TEST_CASE("batched murmur3 matches the scalar hash", "[hash]") {
+  const ds::usize KEYS = 37U;
+  ds::u8 buffer[HASH_BUFFER_SIZE]; // NOLINT
+  for (ds::usize i = 0U; i < HASH_BUFFER_SIZE; ++i) {
+    buffer[i] = (ds::u8)(i * 131U + 17U);
+  }
+
+  // Keys of mixed lengths and offsets share the lanes
+  const void* keys[KEYS]; // NOLINT
+  ds::i32 lens[KEYS];     // NOLINT
+  ds::u32 out[KEYS];      // NOLINT
+  for (ds::usize round = 0U; round < 8U; ++round) {
+    for (ds::usize i = 0U; i < KEYS; ++i) {
+      keys[i] = buffer + (i * 5U + round) % 64U;
+      lens[i] = (ds::i32)((i * 7U + round * 3U) % 71U);
+    }
+
+    for (ds::usize count = 0U; count <= KEYS; ++count) {
+      MurmurHash3_x86_32_batch(keys, lens, (ds::i32)count, ds::SEED, out);
+      for (ds::usize i = 0U; i < count; ++i) {
+        ds::u32 expected = 0U;
+        MurmurHash3_x86_32(keys[i], lens[i], ds::SEED, &expected);
+        REQUIRE(out[i] == expected);
+      }
+    }
+  }
+}
+
+TEST_CASE("hash<string> batch matches the single key hash", "[hash]") {
+  const ds::usize KEYS = 40U;
+  ds::string strings[KEYS]; // NOLINT
+  const ds::c8* c8s[KEYS];  // NOLINT
+  ds::usize out[KEYS];      // NOLINT
+  ds::c8 characters[80];    // NOLINT
+  ds::hash<ds::string> hash{};
+
+  for (ds::usize i = 0U; i < KEYS; ++i) {
+    ds::usize size = i * 3U % 70U;
+    for (ds::usize j = 0U; j < size; ++j) {
+      characters[j] = (ds::c8)('a' + (i + j) % 26U);
+    }
+    characters[size] = '\0';
+    REQUIRE(ds_test::handle_error(strings[i].copy(characters)));
+    c8s[i] = strings[i].c_str();
+  }
+
+  hash.hash_batch(strings, KEYS, out);
+  for (ds::usize i = 0U; i < KEYS; ++i) {
+    REQUIRE(out[i] == hash(strings[i]));
+  }
+
+  hash.hash_batch(c8s, KEYS, out);
+  for (ds::usize i = 0U; i < KEYS; ++i) {
+    REQUIRE(out[i] == hash(c8s[i]));
+  }
+}
@@ -11,8 +11,10 @@
 #include "ds/expected.hpp"
 #include "ds/prime.hpp"
 #include "ds/string.hpp"
+#include "ds/string_view.hpp"
 #include "ds/types.hpp"
 #include "main.hpp"
+#include <cstdio>
 #include <cstring>
 #include <tuple>
 
@@ -433,6 +435,907 @@ TEMPLATE_TEST_CASE(
   REQUIRE(pointer == nullptr);
 }
 
+// === Power of Two Policy === //
+
+// NOLINTNEXTLINE
+TEMPLATE_TEST_CASE(
+    "hash_map<int_type, int_type> power of two policy", "[hash_map]",
+    (std::tuple<ds::i32, ds::i32>), (std::tuple<ds::i64, ds::i64>),
+    (std::tuple<ds::u32, ds::u32>), (std::tuple<ds::u64, ds::u64>)
+) {
+  using key_type = typename std::tuple_element<0, TestType>::type;
+  using value_type = typename std::tuple_element<1, TestType>::type;
+  // Strided keys only differ in the high bits, a plain mask would collide
+  const key_type STRIDE = 1024;
+  const key_type COUNT = 1000;
+
+  ds::hash_map<
+      key_type, value_type, ds::hash<key_type>, ds::equal<key_type>,
+      ds::power_of_two_hash_policy>
+      map{};
+
+  for (key_type i = 0; i < COUNT; ++i) {
+    REQUIRE(ds_test::handle_error(map.insert(i * STRIDE, i * 2)));
+    REQUIRE(map.get_size() == (ds::usize)i + 1U);
+
+    // Capacity is always a power of two
+    REQUIRE((map.get_capacity() & (map.get_capacity() - 1)) == 0);
+  }
+
+  for (key_type i = 0; i < COUNT; ++i) {
+    value_type* pointer = map[i * STRIDE];
+    REQUIRE(pointer != nullptr);
+    REQUIRE(*pointer == i * 2);
+    REQUIRE_FALSE(map.contains(i * STRIDE + 1));
+  }
+
+  for (key_type i = 0; i < COUNT; i += 2) {
+    map.remove(i * STRIDE);
+  }
+  REQUIRE(map.get_size() == COUNT / 2);
+
+  for (key_type i = 0; i < COUNT; ++i) {
+    REQUIRE(map.contains(i * STRIDE) == (i % 2 == 1));
+  }
+}
+
+// === Incremental Rehash === //
+
+// NOLINTNEXTLINE
+TEMPLATE_TEST_CASE(
+    "hash_map<int_type, int_type> incremental rehash", "[hash_map]",
+    (std::tuple<ds::i32, ds::i32>), (std::tuple<ds::i64, ds::i64>),
+    (std::tuple<ds::u32, ds::u32>), (std::tuple<ds::u64, ds::u64>)
+) {
+  using key_type = typename std::tuple_element<0, TestType>::type;
+  using value_type = typename std::tuple_element<1, TestType>::type;
+  const key_type COUNT = 1000;
+
+  ds::hash_map<
+      key_type, value_type, ds::hash<key_type>, ds::equal<key_type>,
+      ds::incremental_hash_policy<ds::prime_hash_policy, 2U>>
+      map{};
+
+  for (key_type i = 0; i < COUNT; ++i) {
+    REQUIRE(ds_test::handle_error(map.insert(i, i * 2)));
+    REQUIRE(map.get_size() == (ds::usize)i + 1U);
+
+    // Overwriting a key that might not be migrated yet
+    if (i > 0) {
+      REQUIRE(ds_test::handle_error(map.insert(i / 2, i / 2 * 2)));
+      REQUIRE(map.get_size() == (ds::usize)i + 1U);
+    }
+
+    // Every key should be found while the bucket is migrating
+    for (key_type j = 0; j <= i; j += 7) {
+      value_type* pointer = map[j];
+      REQUIRE(pointer != nullptr);
+      REQUIRE(*pointer == j * 2);
+    }
+    REQUIRE_FALSE(map.contains(i + 1));
+
+    if (i % 50 == 0) {
+      ds::usize count = 0U;
+      for (auto it = map.begin(); it != map.end(); ++it) {
+        REQUIRE(it.value() == it.key() * 2);
+        ++count;
+      }
+      REQUIRE(count == map.get_size());
+    }
+  }
+
+  for (key_type i = 0; i < COUNT; i += 2) {
+    map.remove(i);
+  }
+  REQUIRE(map.get_size() == COUNT / 2);
+
+  for (key_type i = 0; i < COUNT; ++i) {
+    REQUIRE(map.contains(i) == (i % 2 == 1));
+  }
+
+  map.clear();
+  REQUIRE(map.is_empty());
+  REQUIRE_FALSE(map.contains(1));
+}
+
+// === Stored Hash Policy === //
+
+// NOLINTNEXTLINE
+TEMPLATE_TEST_CASE(
+    "hash_map<int_type, int_type> stored hash policy", "[hash_map]",
+    (std::tuple<ds::i32, ds::i32>), (std::tuple<ds::i64, ds::i64>),
+    (std::tuple<ds::u32, ds::u32>), (std::tuple<ds::u64, ds::u64>)
+) {
+  using key_type = typename std::tuple_element<0, TestType>::type;
+  using value_type = typename std::tuple_element<1, TestType>::type;
+  using default_map = ds::hash_map<key_type, value_type>;
+  const key_type COUNT = 1000;
+
+  // The hash takes no space unless it is stored
+  REQUIRE(
+      sizeof(typename default_map::node_type) ==
+      sizeof(key_type) + sizeof(value_type)
+  );
+
+  // Also goes through the migration since the hash is reused there
+  ds::hash_map<
+      key_type, value_type, ds::hash<key_type>, ds::equal<key_type>,
+      ds::incremental_hash_policy<
+          ds::stored_hash_policy<ds::prime_hash_policy>, 2U>>
+      map{};
+
+  for (key_type i = 0; i < COUNT; ++i) {
+    REQUIRE(ds_test::handle_error(map.insert(i, i * 2)));
+    REQUIRE(map.get_size() == (ds::usize)i + 1U);
+  }
+
+  for (key_type i = 0; i < COUNT; ++i) {
+    value_type* pointer = map[i];
+    REQUIRE(pointer != nullptr);
+    REQUIRE(*pointer == i * 2);
+    REQUIRE_FALSE(map.contains(i + COUNT));
+  }
+
+  for (key_type i = 0; i < COUNT; i += 2) {
+    map.remove(i);
+  }
+  REQUIRE(map.get_size() == COUNT / 2);
+
+  for (key_type i = 0; i < COUNT; ++i) {
+    REQUIRE(map.contains(i) == (i % 2 == 1));
+  }
+}
+
+TEST_CASE("hash_map<string, i64> stored hash policy", "[hash_map]") {
+  const ds::i64 COUNT = 1000;
+  ds::hash_map<
+      ds::string, ds::i64, ds::hash<ds::string>, ds::equal<ds::string>,
+      ds::stored_hash_policy<ds::prime_hash_policy>>
+      map{};
+  ds::string string{};
+  ds::c8 characters[32]; // NOLINT
+
+  for (ds::i64 i = 0; i < COUNT; ++i) {
+    std::snprintf(characters, sizeof(characters), "/path/%04lld", i);
+    REQUIRE(ds_test::handle_error(map.insert(characters, i)));
+    REQUIRE(map.get_size() == (ds::usize)i + 1U);
+  }
+
+  // Overwriting
+  REQUIRE(ds_test::handle_error(string.copy("/path/0001")));
+  REQUIRE(ds_test::handle_error(map.insert(string, -1)));
+  REQUIRE(map.get_size() == COUNT);
+  REQUIRE(*map[string] == -1);
+
+  for (ds::i64 i = 2; i < COUNT; ++i) {
+    std::snprintf(characters, sizeof(characters), "/path/%04lld", i);
+    ds::i64* pointer = map[characters];
+    REQUIRE(pointer != nullptr);
+    REQUIRE(*pointer == i);
+  }
+  REQUIRE_FALSE(map.contains("/path/"));
+  REQUIRE_FALSE(map.contains("/path/10000"));
+
+  for (ds::i64 i = 0; i < COUNT; i += 2) {
+    std::snprintf(characters, sizeof(characters), "/path/%04lld", i);
+    map.remove(characters);
+  }
+  REQUIRE(map.get_size() == COUNT / 2);
+
+  for (ds::i64 i = 0; i < COUNT; ++i) {
+    std::snprintf(characters, sizeof(characters), "/path/%04lld", i);
+    REQUIRE(map.contains(characters) == (i % 2 == 1));
+  }
+}
+
+// === Seeded Hash Policy === //
+
+// Keys whose hash times the fibonacci multiplier is below 2^16, every one of
+//   them lands in slot 0 of a power of two bucket. Anyone who knows the hash
+//   can build this set.
+static ds::u64 get_flooding_key(ds::u64 index) noexcept {
+  // NOTE: Newton's iteration for the inverse of an odd number modulo 2^64
+  ds::u64 inverse = ds::FIBONACCI_MULTIPLIER;
+  for (ds::u32 i = 0U; i < 5U; ++i) {
+    inverse *= 2U - ds::FIBONACCI_MULTIPLIER * inverse;
+  }
+  return index * inverse;
+}
+
+// NOLINTNEXTLINE
+TEMPLATE_TEST_CASE(
+    "hash_map seeded hash policy", "[hash_map]",
+    ds::seeded_hash_policy<ds::prime_hash_policy>,
+    ds::seeded_hash_policy<ds::power_of_two_hash_policy>,
+    (ds::incremental_hash_policy<
+        ds::seeded_hash_policy<ds::stored_hash_policy<ds::prime_hash_policy>>,
+        2U>)
+) {
+  const ds::u64 COUNT = 1000U;
+  using seeded_map = ds::hash_map<
+      ds::u64, ds::u64, ds::hash<ds::u64>, ds::equal<ds::u64>, TestType>;
+  seeded_map map{};
+
+  for (ds::u64 i = 0U; i < COUNT; ++i) {
+    REQUIRE(ds_test::handle_error(map.insert(i, i * 2U)));
+  }
+  for (ds::u64 i = 0U; i < COUNT; ++i) {
+    ds::u64* pointer = map[i];
+    REQUIRE(pointer != nullptr);
+    REQUIRE(*pointer == i * 2U);
+    REQUIRE_FALSE(map.contains(i + COUNT));
+  }
+
+  ds::u64 keys[COUNT * 2U]; // NOLINT
+  bool found[COUNT * 2U];   // NOLINT
+  for (ds::u64 i = 0U; i < COUNT * 2U; ++i) {
+    keys[i] = i;
+  }
+  map.contains_batch(keys, COUNT * 2U, found);
+  for (ds::u64 i = 0U; i < COUNT * 2U; ++i) {
+    REQUIRE(found[i] == (i < COUNT));
+  }
+
+  // A copy reuses the layout, so it also takes the seed
+  seeded_map copy{};
+  REQUIRE(ds_test::handle_error(copy.insert(COUNT, 0U)));
+  REQUIRE(ds_test::handle_error(copy.copy(map)));
+  REQUIRE(copy.get_size() == COUNT);
+  for (ds::u64 i = 0U; i < COUNT; ++i) {
+    REQUIRE(copy.contains(i));
+  }
+
+  seeded_map moved{std::move(copy)};
+  for (ds::u64 i = 0U; i < COUNT; i += 2U) {
+    moved.remove(i);
+  }
+  for (ds::u64 i = 0U; i < COUNT; ++i) {
+    REQUIRE(moved.contains(i) == (i % 2U == 1U));
+  }
+}
+
+TEST_CASE("hash_map seeded hash policy under flooding keys", "[hash_map]") {
+  const ds::u64 COUNT = 5'000U;
+
+  // Every key shares a slot, every insert probes the whole cluster
+  ds::hash_map<
+      ds::u64, ds::u64, ds::hash<ds::u64>, ds::equal<ds::u64>,
+      ds::power_of_two_hash_policy>
+      map{};
+  for (ds::u64 i = 0U; i < COUNT; ++i) {
+    REQUIRE(ds_test::handle_error(map.insert(get_flooding_key(i), i)));
+  }
+  REQUIRE(map.contains(get_flooding_key(COUNT - 1U)));
+
+  ds::hash_map<
+      ds::u64, ds::u64, ds::hash<ds::u64>, ds::equal<ds::u64>,
+      ds::seeded_hash_policy<ds::power_of_two_hash_policy>>
+      seeded{};
+  for (ds::u64 i = 0U; i < COUNT; ++i) {
+    REQUIRE(ds_test::handle_error(seeded.insert(get_flooding_key(i), i)));
+  }
+  for (ds::u64 i = 0U; i < COUNT; ++i) {
+    REQUIRE(seeded.contains(get_flooding_key(i)));
+  }
+
+#ifdef DS_HASH_STATS
+  // Spread out like any other keys
+  ds::hash_stats stats = seeded.get_stats();
+  REQUIRE(stats.max_probe_length <= 32U);
+  REQUIRE(stats.average_hit_probe < 4.0);
+#endif
+}
+
+TEST_CASE("hash_map<string, i64> seeded hash policy", "[hash_map]") {
+  const ds::i64 COUNT = 1000;
+  using seeded_map = ds::hash_map<
+      ds::string, ds::i64, ds::hash<ds::string>, ds::equal<ds::string>,
+      ds::seeded_hash_policy<ds::power_of_two_hash_policy>>;
+  seeded_map first{};
+  seeded_map second{};
+  ds::c8 characters[32]; // NOLINT
+
+  for (ds::i64 i = 0; i < COUNT; ++i) {
+    std::snprintf(characters, sizeof(characters), "/path/%04lld", i);
+    REQUIRE(ds_test::handle_error(first.insert(characters, i)));
+    REQUIRE(ds_test::handle_error(second.insert(characters, i)));
+  }
+
+  // Each map has its own seed, the same keys end up in different slots
+  bool same_order = true;
+  auto other = second.cbegin();
+  for (auto iterator = first.cbegin(); iterator != first.cend(); ++iterator) {
+    same_order = same_order && iterator.key() == other.key();
+    ++other;
+  }
+  REQUIRE_FALSE(same_order);
+
+  for (ds::i64 i = 0; i < COUNT; ++i) {
+    std::snprintf(characters, sizeof(characters), "/path/%04lld", i);
+    REQUIRE(*first[characters] == i);
+    REQUIRE(*first[ds::string_view{characters}] == i);
+    REQUIRE(*second[characters] == i);
+  }
+  REQUIRE_FALSE(first.contains("/path/"));
+}
+
+// === Degenerate Hashes === //
+
+// NOLINTNEXTLINE
+TEMPLATE_TEST_CASE(
+    "hash_map degenerate hashes", "[hash_map]", ds::prime_hash_policy,
+    ds::stored_hash_policy<ds::prime_hash_policy>,
+    (ds::incremental_hash_policy<ds::prime_hash_policy, 2U>)
+) {
+  const ds::u64 COUNT = 1'000U;
+  ds::hash_map<
+      ds::u64, ds::u64, ds_test::constant_hash, ds::equal<ds::u64>, TestType>
+      map{};
+
+  // The distances saturate instead of failing the insert
+  for (ds::u64 i = 0U; i < COUNT; ++i) {
+    REQUIRE(ds_test::handle_error(map.insert(i, i * 2U)));
+  }
+  REQUIRE(map.get_size() == COUNT);
+  for (ds::u64 i = 0U; i < COUNT; ++i) {
+    ds::u64* pointer = map[i];
+    REQUIRE(pointer != nullptr);
+    REQUIRE(*pointer == i * 2U);
+    REQUIRE_FALSE(map.contains(i + COUNT));
+  }
+
+  // The key is found past the saturated distances and overwritten
+  REQUIRE(ds_test::handle_error(map.insert(COUNT - 1U, 0U)));
+  REQUIRE(map.get_size() == COUNT);
+  REQUIRE(*map[COUNT - 1U] == 0U);
+
+  // The backward shift moves the nodes with saturated distances
+  for (ds::u64 i = 0U; i < COUNT; i += 2U) {
+    map.remove(i);
+  }
+  REQUIRE(map.get_size() == COUNT / 2U);
+  for (ds::u64 i = 0U; i < COUNT; ++i) {
+    REQUIRE(map.contains(i) == (i % 2U == 1U));
+  }
+
+  REQUIRE(ds_test::handle_error(map.shrink_to_fit()));
+  for (ds::u64 i = 0U; i < COUNT; ++i) {
+    REQUIRE(map.contains(i) == (i % 2U == 1U));
+  }
+}
+
+// === Batched Lookups === //
+
+// NOLINTNEXTLINE
+TEMPLATE_TEST_CASE(
+    "hash_map<int_type, int_type> batched lookups", "[hash_map]",
+    (std::tuple<ds::i32, ds::i32>), (std::tuple<ds::i64, ds::i64>),
+    (std::tuple<ds::u32, ds::u32>), (std::tuple<ds::u64, ds::u64>)
+) {
+  using key_type = typename std::tuple_element<0, TestType>::type;
+  using value_type = typename std::tuple_element<1, TestType>::type;
+  // Not a multiple of the batch size so the last batch is partial
+  const key_type COUNT = 1000;
+
+  key_type keys[COUNT * 2];             // NOLINT
+  value_type* values[COUNT * 2];        // NOLINT
+  const value_type* cvalues[COUNT * 2]; // NOLINT
+  bool found[COUNT * 2];                // NOLINT
+
+  // Even keys exist in the map, odd keys do not
+  for (key_type i = 0; i < COUNT * 2; ++i) {
+    keys[i] = i;
+  }
+
+  ds::hash_map<key_type, value_type> map{};
+  map.find_batch(keys, COUNT * 2, values);
+  map.contains_batch(keys, COUNT * 2, found);
+  for (key_type i = 0; i < COUNT * 2; ++i) {
+    REQUIRE(values[i] == nullptr);
+    REQUIRE_FALSE(found[i]);
+  }
+
+  for (key_type i = 0; i < COUNT * 2; i += 2) {
+    REQUIRE(ds_test::handle_error(map.insert(i, i * 3)));
+  }
+
+  const auto& cmap = map;
+  map.find_batch(keys, COUNT * 2, values);
+  cmap.find_batch(keys, COUNT * 2, cvalues);
+  map.contains_batch(keys, COUNT * 2, found);
+  for (key_type i = 0; i < COUNT * 2; ++i) {
+    if (i % 2 == 0) {
+      REQUIRE(values[i] == map[i]);
+      REQUIRE(*values[i] == i * 3);
+      REQUIRE(cvalues[i] == values[i]);
+      REQUIRE(found[i]);
+    } else {
+      REQUIRE(values[i] == nullptr);
+      REQUIRE(cvalues[i] == nullptr);
+      REQUIRE_FALSE(found[i]);
+    }
+  }
+
+  // Keys can still be in the old bucket of an incremental policy
+  ds::hash_map<
+      key_type, value_type, ds::hash<key_type>, ds::equal<key_type>,
+      ds::incremental_hash_policy<ds::prime_hash_policy, 2U>>
+      incremental_map{};
+  for (key_type i = 0; i < COUNT * 2; i += 2) {
+    REQUIRE(ds_test::handle_error(incremental_map.insert(i, i * 3)));
+    if (i % 50 != 0) {
+      continue;
+    }
+
+    incremental_map.contains_batch(keys, i + 2, found);
+    for (key_type j = 0; j < i + 2; ++j) {
+      REQUIRE(found[j] == (j % 2 == 0));
+    }
+  }
+}
+
+// === Copying === //
+
+// NOLINTNEXTLINE
+TEMPLATE_TEST_CASE(
+    "hash_map copy", "[hash_map]", ds::prime_hash_policy,
+    (ds::stored_hash_policy<ds::power_of_two_hash_policy>),
+    (ds::incremental_hash_policy<ds::prime_hash_policy, 2U>)
+) {
+  using map_type = ds::hash_map<
+      ds::i64, ds::i64, ds::hash<ds::i64>, ds::equal<ds::i64>, TestType>;
+  const ds::i64 COUNT = 1000;
+  map_type map{};
+  map_type copy{};
+
+  // Copying an empty hash map
+  REQUIRE(ds_test::handle_error(copy.copy(map)));
+  REQUIRE(copy.is_empty());
+
+  for (ds::i64 i = 0; i < COUNT; ++i) {
+    REQUIRE(ds_test::handle_error(map.insert(i, i * 3)));
+  }
+
+  // Different capacities, the bucket of the copy is replaced
+  REQUIRE(ds_test::handle_error(copy.insert(-1, -1)));
+  REQUIRE(ds_test::handle_error(copy.copy(map)));
+  REQUIRE(copy.get_size() == map.get_size());
+  REQUIRE(copy.get_capacity() == map.get_capacity());
+  REQUIRE_FALSE(copy.contains(-1));
+  for (ds::i64 i = 0; i < COUNT; ++i) {
+    ds::i64* pointer = copy[i];
+    REQUIRE(pointer != nullptr);
+    REQUIRE(pointer != map[i]);
+    REQUIRE(*pointer == i * 3);
+  }
+
+  // Same capacities, the bucket of the copy is reused
+  for (ds::i64 i = 0; i < COUNT; i += 2) {
+    map.remove(i);
+  }
+  REQUIRE(ds_test::handle_error(copy.copy(map)));
+  REQUIRE(copy.get_size() == COUNT / 2);
+
+  // Both are independent after the copy
+  REQUIRE(ds_test::handle_error(map.insert(0, 0)));
+  REQUIRE(ds_test::handle_error(copy.insert(COUNT, COUNT)));
+  for (ds::i64 i = 0; i <= COUNT; ++i) {
+    REQUIRE(copy.contains(i) == (i % 2 == 1 || i == COUNT));
+    REQUIRE(map.contains(i) == (i % 2 == 1 || i == 0));
+  }
+}
+
+TEST_CASE("hash_map copy during a migration", "[hash_map]") {
+  const ds::i64 COUNT = 1000;
+  ds::hash_map<
+      ds::i64, ds::i64, ds::hash<ds::i64>, ds::equal<ds::i64>,
+      ds::incremental_hash_policy<ds::prime_hash_policy, 1U>>
+      map{};
+  ds::hash_map<
+      ds::i64, ds::i64, ds::hash<ds::i64>, ds::equal<ds::i64>,
+      ds::incremental_hash_policy<ds::prime_hash_policy, 1U>>
+      copy{};
+
+  // Stop right after a growth so most nodes are still in the old bucket
+  ds::usize capacity = 0U;
+  for (ds::i64 i = 0; i < COUNT; ++i) {
+    REQUIRE(ds_test::handle_error(map.insert(i, i)));
+    if (i > COUNT / 2 && capacity != 0U && map.get_capacity() != capacity) {
+      break;
+    }
+    capacity = map.get_capacity();
+  }
+
+  REQUIRE(ds_test::handle_error(copy.copy(map)));
+  REQUIRE(copy.get_size() == map.get_size());
+  for (ds::i64 i = 0; i < (ds::i64)map.get_size(); ++i) {
+    REQUIRE(*copy[i] == i);
+  }
+
+  // Migrating the copy does not touch the original
+  for (ds::i64 i = 0; i < COUNT; ++i) {
+    REQUIRE(ds_test::handle_error(copy.insert(COUNT + i, i)));
+  }
+  for (ds::i64 i = 0; i < (ds::i64)map.get_size(); ++i) {
+    REQUIRE(*map[i] == i);
+    REQUIRE(*copy[i] == i);
+  }
+}
+
+TEST_CASE("hash_map<string, string> copy", "[hash_map]") {
+  const ds::i64 COUNT = 500;
+  ds::hash_map<ds::string, ds::string> map{};
+  ds::hash_map<ds::string, ds::string> copy{};
+  ds::c8 key[32];   // NOLINT
+  ds::c8 value[32]; // NOLINT
+
+  for (ds::i64 i = 0; i < COUNT; ++i) {
+    std::snprintf(key, sizeof(key), "key-%04lld", i);
+    std::snprintf(value, sizeof(value), "value-%04lld", i);
+    REQUIRE(ds_test::handle_error(map.insert(key, value)));
+  }
+
+  for (ds::i32 round = 0; round < 2; ++round) {
+    REQUIRE(ds_test::handle_error(copy.copy(map)));
+    REQUIRE(copy.get_size() == COUNT);
+    for (ds::i64 i = 0; i < COUNT; ++i) {
+      std::snprintf(key, sizeof(key), "key-%04lld", i);
+      std::snprintf(value, sizeof(value), "value-%04lld", i);
+      ds::string* pointer = copy[key];
+      REQUIRE(pointer != nullptr);
+      REQUIRE(*pointer == value);
+      REQUIRE(pointer->c_str() != map[key]->c_str());
+    }
+  }
+
+  map.destroy();
+  REQUIRE(*copy["key-0001"] == "value-0001");
+
+  ds::hash_map<ds::i64, ds::string> values{};
+  ds::hash_map<ds::i64, ds::string> values_copy{};
+  REQUIRE(ds_test::handle_error(values.insert(1, "one")));
+  REQUIRE(ds_test::handle_error(values.insert(2, "two")));
+  REQUIRE(ds_test::handle_error(values_copy.copy(values)));
+  REQUIRE(*values_copy[1] == "one");
+  REQUIRE(*values_copy[2] == "two");
+}
+
+// === Upserting === //
+
+// NOLINTNEXTLINE
+TEMPLATE_TEST_CASE(
+    "hash_map try_emplace and get_or_insert", "[hash_map]",
+    ds::prime_hash_policy, ds::power_of_two_hash_policy,
+    (ds::incremental_hash_policy<ds::prime_hash_policy, 2U>),
+    ds::stored_hash_policy<ds::prime_hash_policy>
+) {
+  const ds::u64 COUNT = 2'000U;
+  ds::hash_map<
+      ds::u64, ds::u64, ds::hash<ds::u64>, ds::equal<ds::u64>, TestType>
+      map{};
+
+  // Counter style upserts, every key is hit 3 times
+  for (ds::u64 round = 0U; round < 3U; ++round) {
+    for (ds::u64 i = 0U; i < COUNT; ++i) {
+      auto expected = map.get_or_insert(i);
+      REQUIRE(ds_test::handle_error(expected));
+      REQUIRE(**expected == round);
+      ++**expected;
+    }
+  }
+  REQUIRE(map.get_size() == COUNT);
+  for (ds::u64 i = 0U; i < COUNT; ++i) {
+    REQUIRE(*map[i] == 3U);
+  }
+
+  // Existing keys are left untouched
+  for (ds::u64 i = 0U; i < COUNT; ++i) {
+    REQUIRE(ds_test::handle_error(map.try_emplace(i, i)));
+  }
+  for (ds::u64 i = COUNT; i < COUNT * 2U; ++i) {
+    ds::u64 key = i;
+    REQUIRE(ds_test::handle_error(map.try_emplace(std::move(key), i * 2U)));
+  }
+  REQUIRE(map.get_size() == COUNT * 2U);
+  for (ds::u64 i = 0U; i < COUNT * 2U; ++i) {
+    REQUIRE(*map[i] == (i < COUNT ? 3U : i * 2U));
+  }
+
+  // Still consistent after removing half of the keys
+  for (ds::u64 i = 0U; i < COUNT * 2U; i += 2U) {
+    map.remove(i);
+  }
+  for (ds::u64 i = 0U; i < COUNT * 2U; ++i) {
+    auto expected = map.get_or_insert(i);
+    REQUIRE(ds_test::handle_error(expected));
+    REQUIRE(**expected == (i % 2U == 0U ? 0U : i < COUNT ? 3U : i * 2U));
+  }
+  REQUIRE(map.get_size() == COUNT * 2U);
+}
+
+TEST_CASE("hash_map<string, i64> get_or_insert", "[hash_map]") {
+  ds::hash_map<ds::string, ds::i64> map{};
+  ds::string string{};
+  const ds::c8* words[] = {"the", "cat", "the", "hat", "the", "cat"}; // NOLINT
+
+  for (const auto* word : words) {
+    auto expected = map.get_or_insert(word);
+    REQUIRE(ds_test::handle_error(expected));
+    ++**expected;
+  }
+  REQUIRE(map.get_size() == 3U);
+  REQUIRE(*map["the"] == 3);
+  REQUIRE(*map["cat"] == 2);
+  REQUIRE(*map["hat"] == 1);
+
+  REQUIRE(ds_test::handle_error(string.copy("hat")));
+  auto expected = map.get_or_insert(string);
+  REQUIRE(ds_test::handle_error(expected));
+  REQUIRE(**expected == 1);
+
+  // A moved key is kept by the caller if it already exists
+  expected = map.get_or_insert(std::move(string));
+  REQUIRE(ds_test::handle_error(expected));
+  REQUIRE(string == "hat");
+
+  REQUIRE(ds_test::handle_error(string.copy("bat")));
+  expected = map.get_or_insert(std::move(string));
+  REQUIRE(ds_test::handle_error(expected));
+  REQUIRE(**expected == 0);
+  REQUIRE(map.get_size() == 4U);
+  REQUIRE(map.contains("bat"));
+
+  REQUIRE(ds_test::handle_error(map.try_emplace(ds::string{}, 7)));
+  REQUIRE(*map[""] == 7);
+}
+
+// === Capacity === //
+
+// NOLINTNEXTLINE
+TEMPLATE_TEST_CASE(
+    "hash_map reserve and shrink_to_fit", "[hash_map]", ds::prime_hash_policy,
+    ds::power_of_two_hash_policy,
+    (ds::incremental_hash_policy<ds::prime_hash_policy, 2U>)
+) {
+  const ds::u64 COUNT = 10'000U;
+  ds::hash_map<
+      ds::u64, ds::u64, ds::hash<ds::u64>, ds::equal<ds::u64>, TestType>
+      map{};
+
+  REQUIRE(ds_test::handle_error(map.reserve(COUNT)));
+  ds::usize capacity = map.get_capacity();
+  REQUIRE(capacity * ds::HASHMAP_LOAD_FACTOR >= COUNT);
+
+  // Reserving less does nothing
+  REQUIRE(ds_test::handle_error(map.reserve(COUNT / 2U)));
+  REQUIRE(map.get_capacity() == capacity);
+
+  for (ds::u64 i = 0U; i < COUNT; ++i) {
+    REQUIRE(ds_test::handle_error(map.insert(i, i * 2U)));
+  }
+  REQUIRE(map.get_capacity() == capacity);
+
+  for (ds::u64 i = 0U; i < COUNT; ++i) {
+    if (i % 100U != 0U) {
+      map.remove(i);
+    }
+  }
+  REQUIRE(ds_test::handle_error(map.shrink_to_fit()));
+  REQUIRE(map.get_capacity() < capacity / 16U);
+  REQUIRE(map.get_size() == COUNT / 100U);
+
+  for (ds::u64 i = 0U; i < COUNT; ++i) {
+    ds::u64* pointer = map[i];
+    if (i % 100U == 0U) {
+      REQUIRE(pointer != nullptr);
+      REQUIRE(*pointer == i * 2U);
+    } else {
+      REQUIRE(pointer == nullptr);
+    }
+  }
+
+  // Reserving while keys exist rehashes them once
+  REQUIRE(ds_test::handle_error(map.reserve(COUNT)));
+  REQUIRE(map.get_capacity() == capacity);
+  for (ds::u64 i = 0U; i < COUNT; i += 100U) {
+    REQUIRE(*map[i] == i * 2U);
+  }
+
+  // An empty hash map gives its bucket back
+  map.clear();
+  REQUIRE(ds_test::handle_error(map.shrink_to_fit()));
+  REQUIRE(map.get_capacity() == 0U);
+  REQUIRE(ds_test::handle_error(map.insert(1U, 2U)));
+  REQUIRE(*map[1U] == 2U);
+}
+
+TEST_CASE("hash_map max load factor", "[hash_map]") {
+  const ds::i64 COUNT = 1000;
+  ds::hash_map<ds::i64, ds::i64> map{};
+
+  REQUIRE(map.get_max_load_factor() == ds::HASHMAP_LOAD_FACTOR);
+  REQUIRE(map.set_max_load_factor(0.0F) == ds::error_codes::INVALID_ARGUMENT);
+  REQUIRE(map.set_max_load_factor(1.0F) == ds::error_codes::INVALID_ARGUMENT);
+  REQUIRE(map.get_max_load_factor() == ds::HASHMAP_LOAD_FACTOR);
+
+  for (ds::i64 i = 0; i < COUNT; ++i) {
+    REQUIRE(ds_test::handle_error(map.insert(i, -i)));
+  }
+  ds::usize capacity = map.get_capacity();
+
+  // Lowering the load factor rehashes the keys right away
+  REQUIRE(ds_test::handle_error(map.set_max_load_factor(0.25F)));
+  REQUIRE(map.get_max_load_factor() == 0.25F);
+  REQUIRE(map.get_capacity() > capacity);
+  REQUIRE(map.get_capacity() * 0.25F >= COUNT);
+  for (ds::i64 i = 0; i < COUNT; ++i) {
+    REQUIRE(*map[i] == -i);
+  }
+
+  // Raising it keeps the bucket until shrink_to_fit
+  capacity = map.get_capacity();
+  REQUIRE(ds_test::handle_error(map.set_max_load_factor(0.95F)));
+  REQUIRE(map.get_capacity() == capacity);
+  REQUIRE(ds_test::handle_error(map.shrink_to_fit()));
+  REQUIRE(map.get_capacity() < capacity);
+  REQUIRE(map.get_size() == COUNT);
+  for (ds::i64 i = 0; i < COUNT; ++i) {
+    REQUIRE(*map[i] == -i);
+  }
+
+  // Kept by moves
+  ds::hash_map<ds::i64, ds::i64> moved{std::move(map)};
+  REQUIRE(moved.get_max_load_factor() == 0.95F);
+}
+
+TEST_CASE("hash_map<string, i64> shrink_to_fit", "[hash_map]") {
+  const ds::i64 COUNT = 1000;
+  ds::hash_map<ds::string, ds::i64> map{};
+  ds::c8 characters[32]; // NOLINT
+
+  REQUIRE(ds_test::handle_error(map.reserve(COUNT)));
+  ds::usize capacity = map.get_capacity();
+  for (ds::i64 i = 0; i < COUNT; ++i) {
+    std::snprintf(characters, sizeof(characters), "key-%04lld", i);
+    REQUIRE(ds_test::handle_error(map.insert(characters, i)));
+  }
+  REQUIRE(map.get_capacity() == capacity);
+
+  for (ds::i64 i = 10; i < COUNT; ++i) {
+    std::snprintf(characters, sizeof(characters), "key-%04lld", i);
+    map.remove(characters);
+  }
+  REQUIRE(ds_test::handle_error(map.shrink_to_fit()));
+  REQUIRE(map.get_capacity() < capacity);
+
+  for (ds::i64 i = 0; i < COUNT; ++i) {
+    std::snprintf(characters, sizeof(characters), "key-%04lld", i);
+    ds::i64* pointer = map[characters];
+    if (i < 10) {
+      REQUIRE(pointer != nullptr);
+      REQUIRE(*pointer == i);
+    } else {
+      REQUIRE(pointer == nullptr);
+    }
+  }
+}
+
+// === Allocator === //
+
+TEST_CASE("hash_map custom allocator", "[hash_map]") {
+  const ds::i64 COUNT = 1000;
+  ds::usize allocations = ds_test::counting_allocator::allocations;
+  ds::usize deallocations = ds_test::counting_allocator::deallocations;
+
+  {
+    ds::hash_map<
+        ds::i64, ds::i64, ds::hash<ds::i64>, ds::equal<ds::i64>,
+        ds::prime_hash_policy, ds_test::counting_allocator>
+        map{};
+    for (ds::i64 i = 0; i < COUNT; ++i) {
+      REQUIRE(ds_test::handle_error(map.insert(i, i)));
+    }
+    REQUIRE(ds_test::counting_allocator::allocations > allocations);
+
+    ds::hash_map<
+        ds::string, ds::string, ds::hash<ds::string>, ds::equal<ds::string>,
+        ds::prime_hash_policy, ds_test::counting_allocator>
+        strings{};
+    REQUIRE(ds_test::handle_error(strings.insert("key", "value")));
+    REQUIRE(*strings["key"] == "value");
+
+    ds::hash_map<
+        ds::string, ds::i64, ds::hash<ds::string>, ds::equal<ds::string>,
+        ds::prime_hash_policy, ds_test::counting_allocator>
+        keys{};
+    REQUIRE(ds_test::handle_error(keys.insert("key", 1)));
+
+    ds::hash_map<
+        ds::i64, ds::string, ds::hash<ds::i64>, ds::equal<ds::i64>,
+        ds::prime_hash_policy, ds_test::counting_allocator>
+        values{};
+    REQUIRE(ds_test::handle_error(values.insert(1, "value")));
+  }
+
+  // Every bucket went through the allocator and was given back
+  REQUIRE(
+      ds_test::counting_allocator::allocations - allocations ==
+      ds_test::counting_allocator::deallocations - deallocations
+  );
+}
+
+// === Stats === //
+
+#ifdef DS_HASH_STATS
+
+// NOLINTNEXTLINE
+TEMPLATE_TEST_CASE(
+    "hash_map stats", "[hash_map]", ds::prime_hash_policy,
+    (ds::incremental_hash_policy<ds::prime_hash_policy, 2U>)
+) {
+  const ds::u64 COUNT = 5'000U;
+  ds::hash_map<
+      ds::u64, ds::u64, ds::hash<ds::u64>, ds::equal<ds::u64>, TestType>
+      map{};
+
+  ds::hash_stats stats = map.get_stats();
+  REQUIRE(stats.size == 0U);
+  REQUIRE(stats.capacity == 0U);
+  REQUIRE(stats.allocated_bytes == 0U);
+
+  for (ds::u64 i = 0U; i < COUNT; ++i) {
+    REQUIRE(ds_test::handle_error(map.insert(i, i)));
+  }
+  stats = map.get_stats();
+  REQUIRE(stats.size == COUNT);
+  REQUIRE(stats.resizes > 0U);
+  REQUIRE(stats.rehashed > 0U);
+  REQUIRE(stats.rehashed < COUNT * stats.resizes);
+
+  ds::usize slots = 0U;
+  ds::usize nodes = 0U;
+  for (ds::usize i = 0U; i < ds::HASH_STATS_DISTANCES; ++i) {
+    slots += stats.distances[i];
+    nodes += i == 0U ? 0U : stats.distances[i];
+    if (stats.distances[i] > 0U) {
+      REQUIRE(i <= stats.max_probe_length);
+    }
+  }
+  REQUIRE(slots == stats.capacity);
+  REQUIRE(nodes == COUNT);
+  REQUIRE(stats.capacity >= map.get_capacity());
+  REQUIRE(
+      stats.allocated_bytes ==
+      stats.capacity * (sizeof(ds::u64) * 2U + sizeof(ds::u8))
+  );
+
+  REQUIRE(stats.average_hit_probe >= 1.0);
+  REQUIRE(stats.average_hit_probe <= (ds::f64)stats.max_probe_length);
+  REQUIRE(stats.average_miss_probe >= 1.0);
+  REQUIRE(stats.clusters > 0U);
+  REQUIRE(stats.max_cluster_size >= stats.max_probe_length);
+  REQUIRE(stats.max_cluster_size < stats.capacity);
+
+  // A bad hash function shows up in the probe lengths
+  ds::hash_map<ds::u64, ds::u64, ds_test::grouped_hash> grouped{};
+  for (ds::u64 i = 0U; i < COUNT; ++i) {
+    REQUIRE(ds_test::handle_error(grouped.insert(i, i)));
+  }
+  ds::hash_stats grouped_stats = grouped.get_stats();
+  REQUIRE(grouped_stats.size == COUNT);
+  REQUIRE(grouped_stats.max_probe_length >= 8U);
+  REQUIRE(grouped_stats.average_hit_probe > stats.average_hit_probe);
+  REQUIRE(grouped_stats.average_miss_probe > stats.average_miss_probe);
+
+  // Kept by moves
+  ds::hash_map<
+      ds::u64, ds::u64, ds::hash<ds::u64>, ds::equal<ds::u64>, TestType>
+      moved{std::move(map)};
+  REQUIRE(moved.get_stats().resizes == stats.resizes);
+}
+
+#endif
+
 // === Iterating === //
 
 TEST_CASE("hash_map iteration", "[hash_map]") {
@@ -698,6 +1601,103 @@ TEST_CASE("hash_map<string, i64> is empty", "[hash_map]") {
   REQUIRE(pointer == nullptr);
 }
 
+TEST_CASE("hash_map<string, i64> batched lookups", "[hash_map]") {
+  ds::hash_map<ds::string, ds::i64> map = ({
+    auto expected_map = create_key_string_hash_map<>();
+    REQUIRE(ds_test::handle_error(expected_map));
+    std::move(*expected_map);
+  });
+  const ds::usize COUNT = 6U;
+
+  // NOLINTNEXTLINE
+  const ds::c8* words[] = {"Hello", "Missing", "My", "Name", "Jeff", "Hell"};
+  ds::string strings[COUNT]; // NOLINT
+  for (ds::usize i = 0U; i < COUNT; ++i) {
+    REQUIRE(ds_test::handle_error(strings[i].copy(words[i])));
+  }
+  const ds::i64 expected_values[] = {1, 0, 2, 3, 4, 0};
+
+  ds::i64* values[COUNT];        // NOLINT
+  const ds::i64* cvalues[COUNT]; // NOLINT
+  bool found[COUNT];             // NOLINT
+  const auto& cmap = map;
+
+  map.find_batch(words, COUNT, values);
+  cmap.find_batch(words, COUNT, cvalues);
+  for (ds::usize i = 0U; i < COUNT; ++i) {
+    if (expected_values[i] == 0) {
+      REQUIRE(values[i] == nullptr);
+      REQUIRE(cvalues[i] == nullptr);
+    } else {
+      REQUIRE(*values[i] == expected_values[i]);
+      REQUIRE(cvalues[i] == values[i]);
+    }
+  }
+
+  map.find_batch(strings, COUNT, values);
+  cmap.find_batch(strings, COUNT, cvalues);
+  for (ds::usize i = 0U; i < COUNT; ++i) {
+    if (expected_values[i] == 0) {
+      REQUIRE(values[i] == nullptr);
+      REQUIRE(cvalues[i] == nullptr);
+    } else {
+      REQUIRE(*values[i] == expected_values[i]);
+      REQUIRE(cvalues[i] == values[i]);
+    }
+  }
+
+  map.contains_batch(words, COUNT, found);
+  for (ds::usize i = 0U; i < COUNT; ++i) {
+    REQUIRE(found[i] == (expected_values[i] != 0));
+  }
+
+  map.contains_batch(strings, COUNT, found);
+  for (ds::usize i = 0U; i < COUNT; ++i) {
+    REQUIRE(found[i] == (expected_values[i] != 0));
+  }
+}
+
+TEST_CASE("hash_map<string, i64> view lookups", "[hash_map]") {
+  ds::hash_map<ds::string, ds::i64> map = ({
+    auto expected_map = create_key_string_hash_map<>();
+    REQUIRE(ds_test::handle_error(expected_map));
+    std::move(*expected_map);
+  });
+  const auto& cmap = map;
+
+  // Keys sliced out of a buffer, none of them are null terminated
+  const ds::c8* buffer = "HelloMyNameJeffs";
+  ds::string_view hello{buffer, 5U};
+  ds::string_view my{buffer + 5U, 2U};
+  ds::string_view name{buffer + 7U, 4U};
+  ds::string_view jeff{buffer + 11U, 4U};
+
+  auto expected = map.at(hello);
+  REQUIRE(ds_test::handle_error(expected));
+  REQUIRE(**expected == 1);
+
+  REQUIRE(*map[my] == 2);
+  REQUIRE(*cmap[name] == 3);
+  REQUIRE(map.contains(jeff));
+
+  // Prefixes and longer keys are not found
+  REQUIRE_FALSE(map.contains(ds::string_view{buffer, 4U}));
+  REQUIRE_FALSE(map.contains(ds::string_view{buffer + 11U, 5U}));
+  REQUIRE(map[ds::string_view{buffer, 6U}] == nullptr);
+
+  expected = map.at(ds::string_view{buffer + 5U, 1U});
+  REQUIRE_FALSE(expected);
+  REQUIRE(expected.error() == ds::error_codes::NOT_FOUND);
+
+  map.remove(ds::string_view{buffer, 4U});
+  REQUIRE(map.get_size() == 4);
+
+  map.remove(name);
+  REQUIRE(map.get_size() == 3);
+  REQUIRE_FALSE(map.contains("Name"));
+  REQUIRE(map.contains("Jeff"));
+}
+
 // === Value String Map === //
 
 // NOLINTNEXTLINE
@@ -10,8 +10,10 @@
 #include "catch2/catch_test_macros.hpp"
 #include "ds/prime.hpp"
 #include "ds/string.hpp"
+#include "ds/string_view.hpp"
 #include "ds/types.hpp"
 #include "main.hpp"
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
 
@@ -332,6 +334,395 @@ TEMPLATE_TEST_CASE(
   test_clear<key_type, false>();
 }
 
+// === Power of Two Policy === //
+
+// NOLINTNEXTLINE
+TEMPLATE_TEST_CASE(
+    "hash_set<int_type> power of two policy", "[hash_set]", ds::i32, ds::i64,
+    ds::u32, ds::u64
+) {
+  using key_type = TestType;
+  // Strided keys only differ in the high bits, a plain mask would collide
+  const key_type STRIDE = 1024;
+  const key_type COUNT = 1000;
+
+  ds::hash_set<
+      key_type, ds::hash<key_type>, ds::equal<key_type>,
+      ds::power_of_two_hash_policy>
+      set{};
+
+  for (key_type i = 0; i < COUNT; ++i) {
+    REQUIRE(ds_test::handle_error(set.insert(i * STRIDE)));
+    REQUIRE(set.get_size() == (ds::usize)i + 1U);
+
+    // Capacity is always a power of two
+    REQUIRE((set.get_capacity() & (set.get_capacity() - 1)) == 0);
+  }
+
+  for (key_type i = 0; i < COUNT; ++i) {
+    REQUIRE(set.contains(i * STRIDE));
+    REQUIRE_FALSE(set.contains(i * STRIDE + 1));
+  }
+
+  for (key_type i = 0; i < COUNT; i += 2) {
+    set.remove(i * STRIDE);
+  }
+  REQUIRE(set.get_size() == COUNT / 2);
+
+  for (key_type i = 0; i < COUNT; ++i) {
+    REQUIRE(set.contains(i * STRIDE) == (i % 2 == 1));
+  }
+}
+
+// === Stored Hash Policy === //
+
+TEST_CASE("hash_set<string> stored hash policy", "[hash_set]") {
+  const ds::i64 COUNT = 1000;
+  ds::hash_set<
+      ds::string, ds::hash<ds::string>, ds::equal<ds::string>,
+      ds::stored_hash_policy<ds::power_of_two_hash_policy>>
+      set{};
+  ds::c8 characters[32]; // NOLINT
+
+  // The hash takes no space unless it is stored
+  REQUIRE(sizeof(ds::hash_set<ds::string>::node_type) == sizeof(ds::string));
+
+  for (ds::i64 i = 0; i < COUNT; ++i) {
+    std::snprintf(characters, sizeof(characters), "/path/%04lld", i);
+    REQUIRE(ds_test::handle_error(set.insert(characters)));
+    REQUIRE(set.get_size() == (ds::usize)i + 1U);
+  }
+  REQUIRE(ds_test::handle_error(set.insert("/path/0001")));
+  REQUIRE(set.get_size() == COUNT);
+
+  for (ds::i64 i = 0; i < COUNT; i += 2) {
+    std::snprintf(characters, sizeof(characters), "/path/%04lld", i);
+    set.remove(characters);
+  }
+  REQUIRE(set.get_size() == COUNT / 2);
+
+  for (ds::i64 i = 0; i < COUNT; ++i) {
+    std::snprintf(characters, sizeof(characters), "/path/%04lld", i);
+    REQUIRE(set.contains(characters) == (i % 2 == 1));
+  }
+  REQUIRE_FALSE(set.contains("/path/"));
+}
+
+// === Seeded Hash Policy === //
+
+TEST_CASE("hash_set seeded hash policy", "[hash_set]") {
+  const ds::u64 COUNT = 1000U;
+  using seeded_set = ds::hash_set<
+      ds::u64, ds::hash<ds::u64>, ds::equal<ds::u64>,
+      ds::seeded_hash_policy<ds::power_of_two_hash_policy>>;
+  seeded_set set{};
+
+  for (ds::u64 i = 0U; i < COUNT; ++i) {
+    REQUIRE(ds_test::handle_error(set.insert(i)));
+  }
+
+  // A copy reuses the layout, so it also takes the seed
+  seeded_set copy{};
+  REQUIRE(ds_test::handle_error(copy.copy(set)));
+  for (ds::u64 i = 0U; i < COUNT; i += 2U) {
+    copy.remove(i);
+  }
+
+  seeded_set moved{std::move(copy)};
+  REQUIRE(moved.get_size() == COUNT / 2U);
+  for (ds::u64 i = 0U; i < COUNT * 2U; ++i) {
+    REQUIRE(set.contains(i) == (i < COUNT));
+    REQUIRE(moved.contains(i) == (i < COUNT && i % 2U == 1U));
+  }
+}
+
+TEST_CASE("hash_set<string> seeded hash policy", "[hash_set]") {
+  const ds::i64 COUNT = 1000;
+  ds::hash_set<
+      ds::string, ds::hash<ds::string>, ds::equal<ds::string>,
+      ds::seeded_hash_policy<ds::stored_hash_policy<ds::prime_hash_policy>>>
+      set{};
+  ds::c8 characters[32]; // NOLINT
+
+  for (ds::i64 i = 0; i < COUNT; ++i) {
+    std::snprintf(characters, sizeof(characters), "/path/%04lld", i);
+    REQUIRE(ds_test::handle_error(set.insert(characters)));
+  }
+
+  const ds::c8* keys[COUNT]; // NOLINT
+  bool found[COUNT];         // NOLINT
+  ds::c8 buffers[COUNT][16]; // NOLINT
+  for (ds::i64 i = 0; i < COUNT; ++i) {
+    std::snprintf(buffers[i], sizeof(buffers[i]), "/path/%04lld", i * 2);
+    keys[i] = buffers[i];
+  }
+  set.contains_batch(keys, COUNT, found);
+  for (ds::i64 i = 0; i < COUNT; ++i) {
+    REQUIRE(found[i] == (i * 2 < COUNT));
+    REQUIRE(set.contains(ds::string_view{keys[i]}) == (i * 2 < COUNT));
+  }
+}
+
+// === Batched Lookups === //
+
+// NOLINTNEXTLINE
+TEMPLATE_TEST_CASE(
+    "hash_set<int_type> batched lookups", "[hash_set]", ds::i32, ds::i64,
+    ds::u32, ds::u64
+) {
+  using key_type = TestType;
+  // Not a multiple of the batch size so the last batch is partial
+  const key_type COUNT = 1000;
+
+  key_type keys[COUNT * 2]; // NOLINT
+  bool found[COUNT * 2];    // NOLINT
+
+  // Even keys exist in the set, odd keys do not
+  for (key_type i = 0; i < COUNT * 2; ++i) {
+    keys[i] = i;
+  }
+
+  ds::hash_set<key_type> set{};
+  set.contains_batch(keys, COUNT * 2, found);
+  for (key_type i = 0; i < COUNT * 2; ++i) {
+    REQUIRE_FALSE(found[i]);
+  }
+
+  for (key_type i = 0; i < COUNT * 2; i += 2) {
+    REQUIRE(ds_test::handle_error(set.insert(i)));
+  }
+
+  set.contains_batch(keys, COUNT * 2, found);
+  for (key_type i = 0; i < COUNT * 2; ++i) {
+    REQUIRE(found[i] == (i % 2 == 0));
+  }
+}
+
+// === Copying === //
+
+TEST_CASE("hash_set copy", "[hash_set]") {
+  const ds::i64 COUNT = 1000;
+  ds::hash_set<ds::i64> set{};
+  ds::hash_set<ds::i64> copy{};
+
+  REQUIRE(ds_test::handle_error(copy.copy(set)));
+  REQUIRE(copy.is_empty());
+
+  for (ds::i64 i = 0; i < COUNT; ++i) {
+    REQUIRE(ds_test::handle_error(set.insert(i)));
+  }
+  REQUIRE(ds_test::handle_error(copy.insert(-1)));
+  REQUIRE(ds_test::handle_error(copy.copy(set)));
+  REQUIRE(copy.get_size() == COUNT);
+  REQUIRE(copy.get_capacity() == set.get_capacity());
+  REQUIRE_FALSE(copy.contains(-1));
+
+  for (ds::i64 i = 0; i < COUNT; i += 2) {
+    set.remove(i);
+  }
+  REQUIRE(ds_test::handle_error(copy.copy(set)));
+  REQUIRE(ds_test::handle_error(set.insert(0)));
+  for (ds::i64 i = 0; i < COUNT; ++i) {
+    REQUIRE(copy.contains(i) == (i % 2 == 1));
+    REQUIRE(set.contains(i) == (i % 2 == 1 || i == 0));
+  }
+}
+
+TEST_CASE("hash_set<string> copy", "[hash_set]") {
+  const ds::i64 COUNT = 500;
+  ds::hash_set<
+      ds::string, ds::hash<ds::string>, ds::equal<ds::string>,
+      ds::stored_hash_policy<ds::prime_hash_policy>>
+      set{};
+  ds::hash_set<
+      ds::string, ds::hash<ds::string>, ds::equal<ds::string>,
+      ds::stored_hash_policy<ds::prime_hash_policy>>
+      copy{};
+  ds::c8 characters[32]; // NOLINT
+
+  for (ds::i64 i = 0; i < COUNT; ++i) {
+    std::snprintf(characters, sizeof(characters), "key-%04lld", i);
+    REQUIRE(ds_test::handle_error(set.insert(characters)));
+  }
+
+  REQUIRE(ds_test::handle_error(copy.copy(set)));
+  set.destroy();
+  REQUIRE(copy.get_size() == COUNT);
+  for (ds::i64 i = 0; i < COUNT; ++i) {
+    std::snprintf(characters, sizeof(characters), "key-%04lld", i);
+    REQUIRE(copy.contains(characters));
+  }
+  REQUIRE_FALSE(copy.contains("key-"));
+}
+
+// === Capacity === //
+
+// NOLINTNEXTLINE
+TEMPLATE_TEST_CASE(
+    "hash_set reserve and shrink_to_fit", "[hash_set]", ds::prime_hash_policy,
+    ds::power_of_two_hash_policy
+) {
+  const ds::u64 COUNT = 10'000U;
+  ds::hash_set<ds::u64, ds::hash<ds::u64>, ds::equal<ds::u64>, TestType>
+      set{};
+
+  REQUIRE(ds_test::handle_error(set.reserve(COUNT)));
+  ds::usize capacity = set.get_capacity();
+  REQUIRE(capacity * ds::HASHSET_LOAD_FACTOR >= COUNT);
+
+  for (ds::u64 i = 0U; i < COUNT; ++i) {
+    REQUIRE(ds_test::handle_error(set.insert(i)));
+  }
+  REQUIRE(set.get_capacity() == capacity);
+
+  for (ds::u64 i = 0U; i < COUNT; ++i) {
+    if (i % 100U != 0U) {
+      set.remove(i);
+    }
+  }
+  REQUIRE(ds_test::handle_error(set.shrink_to_fit()));
+  REQUIRE(set.get_capacity() < capacity / 16U);
+  REQUIRE(set.get_size() == COUNT / 100U);
+  for (ds::u64 i = 0U; i < COUNT; ++i) {
+    REQUIRE(set.contains(i) == (i % 100U == 0U));
+  }
+
+  set.clear();
+  REQUIRE(ds_test::handle_error(set.shrink_to_fit()));
+  REQUIRE(set.get_capacity() == 0U);
+}
+
+TEST_CASE("hash_set max load factor", "[hash_set]") {
+  const ds::i64 COUNT = 1000;
+  ds::hash_set<ds::i64> set{};
+
+  REQUIRE(set.set_max_load_factor(-1.0F) == ds::error_codes::INVALID_ARGUMENT);
+  REQUIRE(set.set_max_load_factor(1.5F) == ds::error_codes::INVALID_ARGUMENT);
+
+  // Set before the first insert
+  REQUIRE(ds_test::handle_error(set.set_max_load_factor(0.5F)));
+  for (ds::i64 i = 0; i < COUNT; ++i) {
+    REQUIRE(ds_test::handle_error(set.insert(i)));
+    REQUIRE(set.get_size() <= set.get_capacity() / 2U);
+  }
+
+  REQUIRE(ds_test::handle_error(set.set_max_load_factor(0.1F)));
+  REQUIRE(set.get_capacity() * 0.1F >= COUNT);
+  for (ds::i64 i = 0; i < COUNT; ++i) {
+    REQUIRE(set.contains(i));
+  }
+}
+
+// Every 64 keys share a hash so the probe sequences get too long for a byte
+struct clustered_hash {
+  ds::usize operator()(ds::u64 key) const noexcept {
+    return key / 64U;
+  }
+};
+
+// NOLINTNEXTLINE
+TEMPLATE_TEST_CASE(
+    "hash_set degenerate hashes", "[hash_set]", clustered_hash,
+    ds_test::constant_hash
+) {
+  const ds::u64 COUNT = 4096U;
+  ds::hash_set<ds::u64, TestType> set{};
+
+  // The distances saturate instead of failing the insert
+  for (ds::u64 i = 0U; i < COUNT; ++i) {
+    REQUIRE(ds_test::handle_error(set.insert(i)));
+  }
+  REQUIRE(ds_test::handle_error(set.insert(COUNT - 1U)));
+  REQUIRE(set.get_size() == COUNT);
+  for (ds::u64 i = 0U; i < COUNT; ++i) {
+    REQUIRE(set.contains(i));
+    REQUIRE_FALSE(set.contains(i + COUNT));
+  }
+
+  // The backward shift moves the nodes with saturated distances
+  for (ds::u64 i = 0U; i < COUNT; i += 2U) {
+    set.remove(i);
+  }
+  REQUIRE(set.get_size() == COUNT / 2U);
+  for (ds::u64 i = 0U; i < COUNT; ++i) {
+    REQUIRE(set.contains(i) == (i % 2U == 1U));
+  }
+
+  REQUIRE(ds_test::handle_error(set.shrink_to_fit()));
+  for (ds::u64 i = 0U; i < COUNT; ++i) {
+    REQUIRE(set.contains(i) == (i % 2U == 1U));
+  }
+}
+
+// === Allocator === //
+
+TEST_CASE("hash_set custom allocator", "[hash_set]") {
+  ds::usize allocations = ds_test::counting_allocator::allocations;
+  ds::usize deallocations = ds_test::counting_allocator::deallocations;
+
+  {
+    ds::hash_set<
+        ds::i64, ds::hash<ds::i64>, ds::equal<ds::i64>, ds::prime_hash_policy,
+        ds_test::counting_allocator>
+        set{};
+    for (ds::i64 i = 0; i < 1000; ++i) {
+      REQUIRE(ds_test::handle_error(set.insert(i)));
+    }
+    REQUIRE(ds_test::counting_allocator::allocations > allocations);
+
+    ds::hash_set<
+        ds::string, ds::hash<ds::string>, ds::equal<ds::string>,
+        ds::prime_hash_policy, ds_test::counting_allocator>
+        strings{};
+    REQUIRE(ds_test::handle_error(strings.insert("key")));
+    REQUIRE(strings.contains("key"));
+  }
+
+  REQUIRE(
+      ds_test::counting_allocator::allocations - allocations ==
+      ds_test::counting_allocator::deallocations - deallocations
+  );
+}
+
+// === Stats === //
+
+#ifdef DS_HASH_STATS
+
+TEST_CASE("hash_set stats", "[hash_set]") {
+  const ds::u64 COUNT = 2'000U;
+  ds::hash_set<ds::u64> set{};
+  ds::hash_set<ds::u64, ds_test::grouped_hash> grouped{};
+
+  for (ds::u64 i = 0U; i < COUNT; ++i) {
+    REQUIRE(ds_test::handle_error(set.insert(i)));
+    REQUIRE(ds_test::handle_error(grouped.insert(i)));
+  }
+
+  ds::hash_stats stats = set.get_stats();
+  REQUIRE(stats.size == COUNT);
+  REQUIRE(stats.capacity == set.get_capacity());
+  REQUIRE(stats.distances[0] == stats.capacity - COUNT);
+  REQUIRE(stats.resizes > 0U);
+  REQUIRE(stats.rehashed > 0U);
+  REQUIRE(stats.average_hit_probe >= 1.0);
+  REQUIRE(stats.average_miss_probe >= 1.0);
+
+  ds::hash_stats grouped_stats = grouped.get_stats();
+  REQUIRE(grouped_stats.size == COUNT);
+  REQUIRE(grouped_stats.max_probe_length >= 8U);
+  REQUIRE(grouped_stats.average_hit_probe > stats.average_hit_probe);
+  REQUIRE(grouped_stats.average_miss_probe > stats.average_miss_probe);
+
+  set.clear();
+  stats = set.get_stats();
+  REQUIRE(stats.size == 0U);
+  REQUIRE(stats.average_hit_probe == 0.0);
+  REQUIRE(stats.average_miss_probe == 1.0);
+  REQUIRE(stats.clusters == 0U);
+}
+
+#endif
+
 // === Iterating === //
 
 TEST_CASE("hash_set iteration", "[hash_set]") {
@@ -527,3 +918,58 @@ TEST_CASE("hash_set<string> clearing", "[hash_set]") {
 
   REQUIRE(set.get_capacity() > 0);
 }
+
+TEST_CASE("hash_set<string> batched lookups", "[hash_set]") {
+  ds::hash_set<ds::string> set = ({
+    auto expected_set = create_string_hash_set<>();
+    REQUIRE(ds_test::handle_error(expected_set));
+    std::move(*expected_set);
+  });
+  const ds::usize COUNT = 6U;
+
+  // NOLINTNEXTLINE
+  const ds::c8* words[] = {"Hello", "Missing", "My", "Name", "Jeff", "Hell"};
+  ds::string strings[COUNT]; // NOLINT
+  for (ds::usize i = 0U; i < COUNT; ++i) {
+    REQUIRE(ds_test::handle_error(strings[i].copy(words[i])));
+  }
+  const bool expected_found[] = {true, false, true, true, true, false};
+  bool found[COUNT]; // NOLINT
+
+  set.contains_batch(words, COUNT, found);
+  for (ds::usize i = 0U; i < COUNT; ++i) {
+    REQUIRE(found[i] == expected_found[i]);
+  }
+
+  set.contains_batch(strings, COUNT, found);
+  for (ds::usize i = 0U; i < COUNT; ++i) {
+    REQUIRE(found[i] == expected_found[i]);
+  }
+}
+
+TEST_CASE("hash_set<string> view lookups", "[hash_set]") {
+  ds::hash_set<ds::string> set = ({
+    auto expected_set = create_string_hash_set<>();
+    REQUIRE(ds_test::handle_error(expected_set));
+    std::move(*expected_set);
+  });
+
+  // Keys sliced out of a buffer, none of them are null terminated
+  const ds::c8* buffer = "HelloMyNameJeffs";
+
+  REQUIRE(set.contains(ds::string_view{buffer, 5U}));
+  REQUIRE(set.contains(ds::string_view{buffer + 5U, 2U}));
+  REQUIRE(set.contains(ds::string_view{buffer + 7U, 4U}));
+  REQUIRE(set.contains(ds::string_view{buffer + 11U, 4U}));
+
+  // Prefixes and longer keys are not found
+  REQUIRE_FALSE(set.contains(ds::string_view{buffer, 4U}));
+  REQUIRE_FALSE(set.contains(ds::string_view{buffer + 11U, 5U}));
+
+  set.remove(ds::string_view{buffer + 11U, 5U});
+  REQUIRE(set.get_size() == 4);
+
+  set.remove(ds::string_view{buffer + 11U, 4U});
+  REQUIRE(set.get_size() == 3);
+  REQUIRE_FALSE(set.contains("Jeff"));
+}
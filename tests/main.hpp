@@ -10,6 +10,7 @@
 
 #include "catch2/catch_message.hpp"
 #include "ds/types.hpp"
+#include <cstdlib>
 
 namespace ds_test {
 
@@ -25,6 +26,45 @@ bool handle_error(const ds::expected<T, ds::error_code>& exp) noexcept {
   return false;
 }
 
+/**
+ * Allocator that counts its calls, checks if a container routes its memory
+ *   through its Allocator parameter
+ **/
+struct counting_allocator {
+  static inline ds::usize allocations = 0U;
+  static inline ds::usize deallocations = 0U;
+
+  [[nodiscard]] void* allocate(ds::usize size) const noexcept {
+    ++allocations;
+    return std::malloc(size); // NOLINT
+  }
+
+  [[nodiscard]] void* reallocate(void* pointer, ds::usize size) const noexcept {
+    return std::realloc(pointer, size); // NOLINT
+  }
+
+  void deallocate(void* pointer) const noexcept {
+    if (pointer != nullptr) {
+      ++deallocations;
+    }
+    std::free(pointer); // NOLINT
+  }
+};
+
+// Every key shares a hash, the probe distances no longer fit in a byte
+struct constant_hash {
+  ds::usize operator()(ds::u64 /* key */) const noexcept {
+    return 42U;
+  }
+};
+
+// Every 8 keys share a hash, a bad hash function for the stats to catch
+struct grouped_hash {
+  ds::usize operator()(ds::u64 key) const noexcept {
+    return (key / 8U) * 0x9E3779B97F4A7C15ULL;
+  }
+};
+
 } // namespace ds_test
 
 #endif
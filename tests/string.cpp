@@ -7,6 +7,7 @@
 
 #include "ds/string.hpp"
 #include "catch2/catch_test_macros.hpp"
+#include "ds/string_view.hpp"
 #include "ds/types.hpp"
 #include "main.hpp"
 #include <cstdlib>
@@ -76,6 +77,50 @@ TEST_CASE("string push and pop", "[string]") {
   REQUIRE(expected.error() == ds::error_codes::CONTAINER_EMPTY);
 }
 
+TEST_CASE("string comparison to a longer const c8*", "[string]") {
+  ds::string str{};
+  CHECK(handle_error(str.copy("58")));
+
+  // Only the prefix of the longer string matches
+  REQUIRE_FALSE(str == "588");
+  REQUIRE_FALSE("588" == str);
+  REQUIRE(str != "588");
+  REQUIRE("588" != str);
+
+  REQUIRE_FALSE(str == "5");
+  REQUIRE_FALSE("5" == str);
+
+  REQUIRE(str == "58");
+  REQUIRE("58" == str);
+}
+
+// === String View === //
+
+TEST_CASE("string_view comparison", "[string]") {
+  const ds::c8* buffer = "GET /index.html HTTP/1.1";
+  ds::string_view method{buffer, 3U};
+  ds::string_view path{buffer + 4U, 11U};
+
+  ds::string str{};
+  CHECK(handle_error(str.copy("/index.html")));
+
+  REQUIRE(method.get_size() == 3U);
+  REQUIRE(method == ds::string_view{"GET"});
+  REQUIRE(method != ds::string_view{"GE"});
+  REQUIRE(method != ds::string_view{"GETS"});
+  REQUIRE(path == ds::string_view{str});
+
+  REQUIRE(method.compare("GET") == 0);
+  REQUIRE(method.compare("GETS") < 0);
+  REQUIRE(method.compare("GE") > 0);
+  REQUIRE(method.compare("POST") < 0);
+
+  ds::string_view empty{};
+  REQUIRE(empty.is_empty());
+  REQUIRE(empty == ds::string_view{""});
+  REQUIRE(empty.compare(method) < 0);
+}
+
 // === Empty String === //
 
 TEST_CASE("empty string definition", "[string]") {